@@ -0,0 +1,6 @@
+#include "Calvin.h"
+#include "../common/microbench.h"
+
+ONE_SHOT_ENGINE_BENCHMARKS(CalvinManager);
+
+BENCHMARK_MAIN();
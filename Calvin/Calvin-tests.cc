@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "Calvin.h"
+
+// ✅ Test: A one-shot transaction's writes are visible to later ones
+TEST(CalvinTest, OneShotCommitVisible) {
+    CalvinManager manager(4, 2, 1);
+    manager.execute({ 0 }, { 0 }, [](CalvinContext& ctx) {
+        ctx.write(0, ctx.read(0) + 5);
+    });
+
+    int seen = -1;
+    manager.execute({ 0 }, {}, [&](CalvinContext& ctx) { seen = ctx.read(0); });
+    ASSERT_EQ(seen, 5);
+}
+
+// ✅ Test: Keys outside the declared sets cannot be read or written
+TEST(CalvinTest, UndeclaredKeysRejected) {
+    CalvinManager manager(4, 2, 1);
+    int undeclared = 0;
+    manager.execute({ 0 }, {}, [&](CalvinContext& ctx) {
+        undeclared = ctx.read(1);
+        ctx.write(0, 7); // read-only on key 0
+    });
+    ASSERT_EQ(undeclared, -1);
+
+    int seen = -1;
+    manager.execute({ 0 }, {}, [&](CalvinContext& ctx) { seen = ctx.read(0); });
+    ASSERT_EQ(seen, 0);
+}
+
+// ✅ Test: Conflicting transactions in one batch run in submission order
+TEST(CalvinTest, BatchOrderIsSerialOrder) {
+    CalvinManager manager(4, 4, 50); // long batch so all three land in one
+    std::vector<int> observed(3, -1);
+    std::vector<CalvinManager::Ticket> tickets;
+    for (int i = 0; i < 3; ++i) {
+        tickets.push_back(manager.submit({}, { 0 }, [&observed, i](CalvinContext& ctx) {
+            observed[i] = ctx.read(0);
+            ctx.write(0, i + 1);
+        }));
+    }
+    for (auto& t : tickets) {
+        manager.wait(t);
+    }
+
+    ASSERT_LT(tickets[0]->txID, tickets[1]->txID);
+    ASSERT_LT(tickets[1]->txID, tickets[2]->txID);
+    ASSERT_EQ(observed, (std::vector<int>{ 0, 1, 2 }));
+}
+
+// ✅ Test: Hot-key increments from many threads are never lost or aborted
+TEST(CalvinTest, HotKeyIncrementsExact) {
+    CalvinManager manager(2, 4, 1);
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 8; ++t) {
+        clients.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                manager.execute({ 0 }, { 0 }, [](CalvinContext& ctx) {
+                    ctx.write(0, ctx.read(0) + 1);
+                });
+            }
+        });
+    }
+    for (auto& c : clients) c.join();
+
+    int seen = -1;
+    manager.execute({ 0 }, {}, [&](CalvinContext& ctx) { seen = ctx.read(0); });
+    ASSERT_EQ(seen, 800);
+}
+
+// ✅ Test: Concurrent multi-key transfers preserve the total
+TEST(CalvinTest, ConcurrentTransfersConserveTotal) {
+    const int m = 8;
+    CalvinManager manager(m, 4, 1);
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 4; ++t) {
+        clients.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i) {
+                int from = (t + i) % m, to = (t * 3 + i + 1) % m;
+                if (from == to) continue;
+                manager.execute({}, { from, to }, [from, to](CalvinContext& ctx) {
+                    ctx.write(from, ctx.read(from) - 1);
+                    ctx.write(to, ctx.read(to) + 1);
+                });
+            }
+        });
+    }
+    for (auto& c : clients) c.join();
+
+    std::vector<int> all;
+    for (int k = 0; k < m; ++k) all.push_back(k);
+    int total = -1;
+    manager.execute(all, {}, [&](CalvinContext& ctx) {
+        total = 0;
+        for (int k = 0; k < m; ++k) total += ctx.read(k);
+    });
+    ASSERT_EQ(total, 0);
+}
+
+// ✅ Test: Destruction runs every transaction already submitted
+TEST(CalvinTest, ShutdownDrainsPending) {
+    int runs = 0;
+    {
+        CalvinManager manager(1, 1, 20);
+        for (int i = 0; i < 10; ++i) {
+            manager.submit({}, { 0 }, [&runs](CalvinContext&) { ++runs; });
+        }
+    }
+    ASSERT_EQ(runs, 10);
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+
+// Deterministic batched execution (Calvin, Thomson et al., SIGMOD'12) for
+// one-shot transactions. A transaction is a procedure submitted together
+// with its full read and write sets. A sequencer closes a batch every
+// batch period and fixes its order; the lock scheduler then enqueues every
+// lock of each transaction in that order before looking at the next one.
+// Conflicting transactions therefore run in sequence order, no deadlock
+// can form, and nothing is ever aborted or retried.
+
+constexpr int CALVIN_BATCH_MS = 5;
+
+class CalvinManager;
+class CalvinContext;
+
+struct CalvinTransaction {
+    int txID = 0;                   // Position in the global sequence, set when batched
+    std::vector<int> readSet;       // Sorted, without keys that are also written
+    std::vector<int> writeSet;      // Sorted
+    std::function<void(CalvinContext&)> procedure;
+    int pendingLocks = 0;           // Locks not yet granted
+    std::shared_ptr<CalvinTransaction> keepAlive; // Set while sequenced and unfinished
+    std::atomic<bool> done{ false };
+};
+
+// What a procedure sees: only keys it declared, each already locked
+class CalvinContext {
+private:
+    CalvinManager& manager;
+    const CalvinTransaction& txn;
+
+    friend class CalvinManager;
+    CalvinContext(CalvinManager& manager, const CalvinTransaction& txn) : manager(manager), txn(txn) {}
+
+public:
+    int txID() const {
+        return txn.txID;
+    }
+
+    int read(int index);             // -1 if index was not declared
+    void write(int index, int val);  // Ignored unless index is in the write set
+};
+
+struct LockRequest {
+    CalvinTransaction* txn;
+    bool exclusive;
+    bool granted;
+};
+
+class CalvinManager {
+public:
+    using Procedure = std::function<void(CalvinContext&)>;
+    using Ticket = std::shared_ptr<CalvinTransaction>;
+
+private:
+    friend class CalvinContext;
+
+    std::vector<int> values;    // Touched only by holders of the key's lock
+
+    // Sequencer input: transactions submitted since the last batch closed
+    std::mutex inputMutex;
+    std::condition_variable inputCv;
+    std::vector<Ticket> pending;
+    bool stopSequencer = false; // Guarded by inputMutex
+    int nextTxID = 1;           // Sequencer thread only
+
+    // Lock scheduler state and the queue of transactions holding all their locks
+    std::mutex schedMutex;
+    std::condition_variable readyCv;
+    std::condition_variable idleCv;
+    std::vector<std::vector<LockRequest>> lockQueues; // Per key, in sequence order
+    std::deque<CalvinTransaction*> ready;
+    int inFlight = 0;               // Sequenced but not yet finished
+    bool stopExecutors = false;     // Guarded by schedMutex
+
+    int batchPeriodMs;
+    std::thread sequencer;
+    std::vector<std::thread> executors;
+
+    static bool contains(const std::vector<int>& keys, int index) {
+        return std::binary_search(keys.begin(), keys.end(), index);
+    }
+
+    void grant(LockRequest& req) {
+        req.granted = true;
+        if (--req.txn->pendingLocks == 0) {
+            ready.push_back(req.txn);
+            readyCv.notify_one();
+        }
+    }
+
+    // Grant from the front of the queue: a run of shared requests, or a
+    // single exclusive request once it reaches the head
+    void grantWaiting(int index) {
+        auto& queue = lockQueues[index];
+        for (size_t i = 0; i < queue.size(); ++i) {
+            LockRequest& req = queue[i];
+            if (req.exclusive) {
+                if (i == 0 && !req.granted) {
+                    grant(req);
+                }
+                break;
+            }
+            if (!req.granted) {
+                grant(req);
+            }
+        }
+    }
+
+    void enqueueLocks(CalvinTransaction* txn) {
+        txn->pendingLocks = (int)(txn->readSet.size() + txn->writeSet.size());
+        if (txn->pendingLocks == 0) {
+            ready.push_back(txn);
+            readyCv.notify_one();
+            return;
+        }
+        for (int index : txn->readSet) {
+            lockQueues[index].push_back({ txn, false, false });
+            grantWaiting(index);
+        }
+        for (int index : txn->writeSet) {
+            lockQueues[index].push_back({ txn, true, false });
+            grantWaiting(index);
+        }
+    }
+
+    void releaseLock(int index, const CalvinTransaction* txn) {
+        auto& queue = lockQueues[index];
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (it->txn == txn) {
+                queue.erase(it);
+                break;
+            }
+        }
+        grantWaiting(index);
+    }
+
+    void sequencerLoop() {
+        std::vector<Ticket> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(inputMutex);
+                inputCv.wait_for(lk, std::chrono::milliseconds(batchPeriodMs), [this] { return stopSequencer; });
+                if (stopSequencer && pending.empty()) {
+                    return;
+                }
+                batch.swap(pending);
+            }
+            if (batch.empty()) {
+                continue;
+            }
+
+            // The batch order is the serial order
+            std::lock_guard<std::mutex> lk(schedMutex);
+            for (auto& txn : batch) {
+                txn->txID = nextTxID++;
+                txn->keepAlive = txn;
+                ++inFlight;
+                enqueueLocks(txn.get());
+            }
+            batch.clear();
+        }
+    }
+
+    void executorLoop() {
+        while (true) {
+            CalvinTransaction* txn;
+            {
+                std::unique_lock<std::mutex> lk(schedMutex);
+                readyCv.wait(lk, [this] { return stopExecutors || !ready.empty(); });
+                if (ready.empty()) {
+                    return;
+                }
+                txn = ready.front();
+                ready.pop_front();
+            }
+
+            CalvinContext ctx(*this, *txn);
+            txn->procedure(ctx);
+
+            {
+                std::lock_guard<std::mutex> lk(schedMutex);
+                for (int index : txn->readSet) {
+                    releaseLock(index, txn);
+                }
+                for (int index : txn->writeSet) {
+                    releaseLock(index, txn);
+                }
+                if (--inFlight == 0) {
+                    idleCv.notify_all();
+                }
+            }
+            // Drop our reference; the submitter may still hold the ticket
+            Ticket self = std::move(txn->keepAlive);
+            txn->done.store(true, std::memory_order_release);
+        }
+    }
+
+public:
+    CalvinManager(int m, int executorCount = std::max(1u, std::thread::hardware_concurrency() / 2),
+        int batchPeriodMs = CALVIN_BATCH_MS)
+        : values(m, 0), lockQueues(m), batchPeriodMs(batchPeriodMs) {
+        sequencer = std::thread(&CalvinManager::sequencerLoop, this);
+        for (int i = 0; i < std::max(1, executorCount); ++i) {
+            executors.emplace_back(&CalvinManager::executorLoop, this);
+        }
+    }
+
+    // Every submitted transaction runs before the threads stop
+    ~CalvinManager() {
+        {
+            std::lock_guard<std::mutex> lk(inputMutex);
+            stopSequencer = true;
+        }
+        inputCv.notify_one();
+        sequencer.join();
+        {
+            std::unique_lock<std::mutex> lk(schedMutex);
+            idleCv.wait(lk, [this] { return inFlight == 0; });
+            stopExecutors = true;
+        }
+        readyCv.notify_all();
+        for (auto& t : executors) {
+            t.join();
+        }
+    }
+
+    // Queue a one-shot transaction for the next batch. The procedure runs on
+    // an executor thread and may touch only the declared keys.
+    Ticket submit(std::vector<int> readSet, std::vector<int> writeSet, Procedure procedure) {
+        auto txn = std::make_shared<CalvinTransaction>();
+        std::sort(writeSet.begin(), writeSet.end());
+        writeSet.erase(std::unique(writeSet.begin(), writeSet.end()), writeSet.end());
+        std::sort(readSet.begin(), readSet.end());
+        readSet.erase(std::unique(readSet.begin(), readSet.end()), readSet.end());
+        readSet.erase(std::remove_if(readSet.begin(), readSet.end(),
+            [&](int index) { return contains(writeSet, index); }), readSet.end());
+
+        txn->readSet = std::move(readSet);
+        txn->writeSet = std::move(writeSet);
+        txn->procedure = std::move(procedure);
+
+        std::lock_guard<std::mutex> lk(inputMutex);
+        pending.push_back(txn);
+        return txn;
+    }
+
+    bool finished(const Ticket& ticket) const {
+        return ticket->done.load(std::memory_order_acquire);
+    }
+
+    void wait(const Ticket& ticket) {
+        for (int spins = 0; !finished(ticket); ++spins) {
+            if (spins > 64) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    // Submit and wait; returns the transaction's position in the serial order
+    int execute(std::vector<int> readSet, std::vector<int> writeSet, Procedure procedure) {
+        Ticket ticket = submit(std::move(readSet), std::move(writeSet), std::move(procedure));
+        wait(ticket);
+        return ticket->txID;
+    }
+};
+
+inline int CalvinContext::read(int index) {
+    if (!CalvinManager::contains(txn.readSet, index) && !CalvinManager::contains(txn.writeSet, index)) {
+        return -1;
+    }
+    return manager.values[index];
+}
+
+inline void CalvinContext::write(int index, int val) {
+    if (CalvinManager::contains(txn.writeSet, index)) {
+        manager.values[index] = val;
+    }
+}
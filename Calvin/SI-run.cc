@@ -0,0 +1,6 @@
+#include "Calvin.h"
+#include "../common/driver.h"
+
+int main(int argc, char** argv) {
+    return runDriver<CalvinManager>(argc, argv, "Calvin");
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "Checker.h"
+
+// ✅ Test: A serial read-modify-write history has no cycles
+TEST(CheckerTest, SerialHistoryPasses) {
+    std::string log =
+        "Thread 1 Tx 1 reads idx 0 val 0 at time 1\n"
+        "Thread 1 Tx 1 writes idx 0 val 5 at time 1\n"
+        "Tx 1 tryCommits => COMMIT at time 2\n"
+        "Thread 2 Tx 2 reads idx 0 val 5 at time 3\n"
+        "Thread 2 Tx 2 writes idx 0 val 9 at time 3\n"
+        "Tx 2 tryCommits => COMMIT at time 4\n"
+        "Thread 3 Tx 3 reads idx 0 val 5 at time 3\n"
+        "Tx 3 tryCommits => COMMIT at time 5\n";
+    CheckResult r = checkHistory(parseHistory(log, 2), 2);
+    ASSERT_EQ(r.transactions, 3);
+    ASSERT_EQ(r.edges[EDGE_WW], 1);
+    ASSERT_EQ(r.edges[EDGE_WR], 2);
+    ASSERT_EQ(r.edges[EDGE_RW], 1); // Tx 3 read the version Tx 2 overwrote
+    ASSERT_TRUE(r.serializable());
+    ASSERT_TRUE(r.snapshotIsolation());
+}
+
+// ✅ Test: Write skew is allowed by SI but not serializable
+TEST(CheckerTest, WriteSkewDetected) {
+    std::string log =
+        "Thread 1 Tx 1 reads idx 0 val 0\n"
+        "Thread 1 Tx 1 reads idx 1 val 0\n"
+        "Thread 1 Tx 1 writes idx 0 val 1\n"
+        "Tx 1 tryCommits => COMMIT\n"
+        "Thread 2 Tx 2 reads idx 0 val 0\n"
+        "Thread 2 Tx 2 reads idx 1 val 0\n"
+        "Thread 2 Tx 2 writes idx 1 val 1\n"
+        "Tx 2 tryCommits => COMMIT\n";
+    CheckResult r = checkHistory(parseHistory(log, 1), 1);
+    ASSERT_EQ(r.writeSkews, 1);
+    ASSERT_FALSE(r.serializable());
+    ASSERT_TRUE(r.snapshotIsolation());
+}
+
+// ✅ Test: A lost update violates SI
+TEST(CheckerTest, LostUpdateViolatesSI) {
+    std::string log =
+        "Thread 1 Tx 1 reads idx 0 val 0\n"
+        "Thread 1 Tx 1 writes idx 0 val 3\n"
+        "Tx 1 tryCommits => COMMIT\n"
+        "Thread 2 Tx 2 reads idx 0 val 0\n"
+        "Thread 2 Tx 2 writes idx 0 val 4\n"
+        "Tx 2 tryCommits => COMMIT\n";
+    CheckResult r = checkHistory(parseHistory(log, 1), 1);
+    ASSERT_EQ(r.nonAdjacentRwCycles, 1);
+    ASSERT_FALSE(r.snapshotIsolation());
+}
+
+// ✅ Test: A cycle with two rw edges that are not adjacent violates SI
+TEST(CheckerTest, NonAdjacentRwCycleViolatesSI) {
+    // Tx 1 -rw-> Tx 2 -ww-> Tx 3 -rw-> Tx 4 -wr-> Tx 1
+    std::string log =
+        "Thread 2 Tx 2 writes idx 0 val 1\n"
+        "Thread 2 Tx 2 writes idx 1 val 2\n"
+        "Tx 2 tryCommits => COMMIT\n"
+        "Thread 3 Tx 3 reads idx 2 val 0\n"
+        "Thread 3 Tx 3 writes idx 1 val 3\n"
+        "Tx 3 tryCommits => COMMIT\n"
+        "Thread 4 Tx 4 writes idx 2 val 4\n"
+        "Thread 4 Tx 4 writes idx 3 val 5\n"
+        "Tx 4 tryCommits => COMMIT\n"
+        "Thread 1 Tx 1 reads idx 0 val 0\n"
+        "Thread 1 Tx 1 reads idx 3 val 5\n"
+        "Tx 1 tryCommits => COMMIT\n";
+    CheckResult r = checkHistory(parseHistory(log, 1), 1);
+    ASSERT_EQ(r.edges[EDGE_RW], 2);
+    ASSERT_EQ(r.g1cComponents, 0);
+    ASSERT_EQ(r.writeSkews, 0);
+    ASSERT_EQ(r.nonAdjacentRwCycles, 2);
+    ASSERT_FALSE(r.serializable());
+    ASSERT_FALSE(r.snapshotIsolation());
+}
+
+// ✅ Test: Aborted transactions, own-write reads and summary lines are ignored
+TEST(CheckerTest, ParsingSkipsNoise) {
+    std::string log =
+        "Thread 1 Tx 1 writes idx 0 val 7 at time 1\n"
+        "Thread 1 Tx 1 reads idx 0 val 7 at time 1\n"
+        "Tx 1 tryCommits => COMMIT at time 1\n"
+        "Thread 2 Tx 2 writes idx 0 val 8 at time 1\n"
+        "Tx 2 tryCommits => ABORT at time 1\n"
+        "-----------------------------\n"
+        "Average commit delay (ms): 2.2\n";
+    History h = parseHistory(log, 3);
+    ASSERT_EQ(h.txns.size(), 1u);
+    ASSERT_TRUE(h.txns[0].reads.empty());
+    ASSERT_EQ(h.txns[0].writes.size(), 1u);
+}
+
+// ✅ Test: A value nobody wrote is reported, and add() keys are skipped
+TEST(CheckerTest, UnmatchedReadsAndCounters) {
+    std::string log =
+        "Thread 1 Tx 1 reads idx 0 val 42\n"
+        "Thread 1 Tx 1 adds idx 1 delta 3\n"
+        "Tx 1 tryCommits => COMMIT\n"
+        "Thread 2 Tx 2 reads idx 1 val 3\n"
+        "Tx 2 tryCommits => COMMIT\n";
+    CheckResult r = checkHistory(parseHistory(log, 1), 1);
+    ASSERT_EQ(r.unmatchedReads, 1);
+    ASSERT_EQ(r.counterKeys, 1);
+    ASSERT_FALSE(r.snapshotIsolation());
+}
+
+// ✅ Test: Parallel parsing splits only at transaction boundaries
+TEST(CheckerTest, ParallelParseMatchesSerial) {
+    std::string log;
+    for (int t = 1; t <= 500; ++t) {
+        log += "Thread 1 Tx " + std::to_string(t) + " reads idx " + std::to_string(t % 7) + " val 0\n";
+        log += "Tx " + std::to_string(t) + " tryCommits => COMMIT\n";
+    }
+    History serial = parseHistory(log, 1);
+    History parallel = parseHistory(log, 8);
+    ASSERT_EQ(serial.txns.size(), 500u);
+    ASSERT_EQ(parallel.txns.size(), 500u);
+    for (size_t i = 0; i < serial.txns.size(); ++i) {
+        ASSERT_EQ(serial.txns[i].txID, parallel.txns[i].txID);
+    }
+}
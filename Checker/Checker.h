@@ -0,0 +1,610 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+
+// Offline isolation checker for the driver's si_log.txt. The log holds
+// committed transactions only, each as a run of read/write lines closed by
+// its "tryCommits => COMMIT" line, in the order the commits were logged.
+//
+// Versions of a key are ordered along read-modify-write chains (a writer
+// that read value v follows the version holding v), falling back to the
+// order of commit lines for blind writes. A read is matched to a version
+// holding its value, or to the initial 0. That yields Adya's direct
+// serialization graph:
+//   ww  Ti installed the version Tj overwrote
+//   wr  Tj read the version Ti installed
+//   rw  Ti read the version Tj overwrote (anti-dependency)
+// A cycle means the history is not serializable. Snapshot isolation allows
+// only cycles with two consecutive rw edges somewhere along them: one
+// without rw edges (G1c) or with no two rw edges adjacent, counting the
+// last and first edge as adjacent (G-SI: lost update, missed effects), is
+// forbidden. Two transactions linked by rw edges in both directions are
+// reported as write skew, which SI allows.
+//
+// Keys that received add() increments carry no full values to match, so
+// they are left out of the graph and counted separately.
+
+enum EdgeType {
+    EDGE_WW,
+    EDGE_WR,
+    EDGE_RW
+};
+
+struct HistoryOp {
+    int key;
+    int value;
+};
+
+struct HistoryTxn {
+    int txID = 0;
+    std::vector<HistoryOp> reads;   // First read of each key before writing it
+    std::vector<HistoryOp> writes;  // Final value written per key
+    int fuzzyReads = 0;             // Re-reads of a key that returned another value
+};
+
+struct History {
+    std::vector<HistoryTxn> txns;   // In commit-line order
+    std::unordered_set<int> counterKeys;
+};
+
+struct HistoryEdge {
+    int from;
+    int to;
+    EdgeType type;
+};
+
+struct CheckResult {
+    long long transactions = 0;
+    long long edges[3] = { 0, 0, 0 };   // Indexed by EdgeType
+    long long unmatchedReads = 0;       // Read values no committed writer produced
+    long long fuzzyReads = 0;
+    long long counterKeys = 0;
+    long long cyclicComponents = 0;     // Strongly connected components with a cycle
+    long long largestComponent = 0;
+    long long g1cComponents = 0;        // Cycles made of ww/wr edges only
+    long long nonAdjacentRwCycles = 0;  // rw edges on a cycle with no two rw edges adjacent (G-SI)
+    long long writeSkews = 0;           // Pairs with rw edges both ways
+    bool nonAdjacentCheckComplete = true; // False if the search budget ran out
+    std::vector<std::string> examples;
+
+    bool serializable() const {
+        return cyclicComponents == 0 && unmatchedReads == 0 && fuzzyReads == 0;
+    }
+
+    bool snapshotIsolation() const {
+        return g1cComponents == 0 && nonAdjacentRwCycles == 0 && unmatchedReads == 0 && fuzzyReads == 0;
+    }
+};
+
+namespace checker {
+
+constexpr size_t MAX_EXAMPLES = 10;
+constexpr long long NON_ADJACENT_RW_BUDGET = 50'000'000;  // State visits spent looking for G-SI
+
+inline bool parseInt(std::string_view s, int& out) {
+    if (s.empty()) {
+        return false;
+    }
+    bool negative = s[0] == '-';
+    size_t i = negative ? 1 : 0;
+    if (i == s.size()) {
+        return false;
+    }
+    long long v = 0;
+    for (; i < s.size(); ++i) {
+        if (s[i] < '0' || s[i] > '9') {
+            return false;
+        }
+        v = v * 10 + (s[i] - '0');
+    }
+    out = (int)(negative ? -v : v);
+    return true;
+}
+
+// Up to max space-separated tokens of a line
+inline size_t tokenize(std::string_view line, std::string_view* tokens, size_t max) {
+    size_t count = 0, pos = 0;
+    while (count < max && pos < line.size()) {
+        while (pos < line.size() && line[pos] == ' ') ++pos;
+        size_t end = line.find(' ', pos);
+        if (end == std::string_view::npos) end = line.size();
+        if (end > pos) tokens[count++] = line.substr(pos, end - pos);
+        pos = end;
+    }
+    return count;
+}
+
+// Per-transaction state while its lines are being read
+struct TxnBuilder {
+    HistoryTxn txn;
+    std::unordered_map<int, int> written;   // key -> index into txn.writes
+    std::unordered_map<int, int> readValue; // key -> first external read
+
+    void clear() {
+        txn = HistoryTxn{};
+        written.clear();
+        readValue.clear();
+    }
+
+    void read(int key, int value) {
+        if (written.count(key)) {
+            return; // Read of our own write
+        }
+        auto it = readValue.find(key);
+        if (it == readValue.end()) {
+            readValue.emplace(key, value);
+            txn.reads.push_back({ key, value });
+        }
+        else if (it->second != value) {
+            ++txn.fuzzyReads;
+        }
+    }
+
+    void write(int key, int value) {
+        auto it = written.find(key);
+        if (it == written.end()) {
+            written.emplace(key, (int)txn.writes.size());
+            txn.writes.push_back({ key, value });
+        }
+        else {
+            txn.writes[it->second].value = value;
+        }
+    }
+};
+
+// Parse [begin, end) of the log; the range starts and ends on transaction boundaries
+inline void parseRange(std::string_view text, History& out) {
+    TxnBuilder builder;
+    std::string_view tokens[10];
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        std::string_view line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+
+        size_t n = tokenize(line, tokens, 10);
+        int txID, key, value;
+        // "<Thread|Client> id Tx txID reads|writes|adds idx key val|delta value ..."
+        if (n >= 9 && tokens[2] == "Tx" && tokens[5] == "idx" &&
+            parseInt(tokens[3], txID) && parseInt(tokens[6], key) && parseInt(tokens[8], value)) {
+            builder.txn.txID = txID;
+            if (tokens[4] == "reads") {
+                builder.read(key, value);
+            }
+            else if (tokens[4] == "writes") {
+                builder.write(key, value);
+            }
+            else if (tokens[4] == "adds") {
+                out.counterKeys.insert(key);
+            }
+        }
+        // "Tx txID tryCommits => COMMIT ..."
+        else if (n >= 5 && tokens[0] == "Tx" && tokens[2] == "tryCommits" && parseInt(tokens[1], txID)) {
+            if (tokens[4] == "COMMIT") {
+                builder.txn.txID = txID;
+                out.txns.push_back(std::move(builder.txn));
+            }
+            builder.clear();
+        }
+    }
+}
+
+// Position just past the first commit line that starts after pos
+inline size_t nextBoundary(std::string_view text, size_t pos) {
+    if (pos > 0) {
+        pos = text.find('\n', pos - 1);
+        if (pos == std::string_view::npos) return text.size();
+        ++pos;
+    }
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) return text.size();
+        bool commitLine = text.compare(pos, 3, "Tx ") == 0;
+        pos = eol + 1;
+        if (commitLine) return pos;
+    }
+    return text.size();
+}
+
+} // namespace checker
+
+// Split the log at transaction boundaries and parse the pieces in parallel
+inline History parseHistory(std::string_view text, int threads = std::max(1u, std::thread::hardware_concurrency())) {
+    threads = std::max(1, threads);
+    std::vector<size_t> cuts{ 0 };
+    for (int t = 1; t < threads; ++t) {
+        size_t cut = checker::nextBoundary(text, std::max(cuts.back(), text.size() * t / threads));
+        cuts.push_back(cut);
+    }
+    cuts.push_back(text.size());
+
+    std::vector<History> parts(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            checker::parseRange(text.substr(cuts[t], cuts[t + 1] - cuts[t]), parts[t]);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    History history;
+    for (auto& part : parts) {
+        history.txns.insert(history.txns.end(), std::make_move_iterator(part.txns.begin()),
+            std::make_move_iterator(part.txns.end()));
+        history.counterKeys.insert(part.counterKeys.begin(), part.counterKeys.end());
+    }
+    return history;
+}
+
+inline bool loadHistory(const std::string& path, History& history, int threads) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    std::string text((size_t)in.tellg(), '\0');
+    in.seekg(0, std::ios::beg);
+    in.read(text.data(), (std::streamsize)text.size());
+    history = parseHistory(text, threads);
+    return true;
+}
+
+namespace checker {
+
+struct KeyAccess {
+    int txn;    // Index into History::txns, i.e. commit-line position
+    int value;
+};
+
+struct KeyWrite {
+    int txn;
+    int value;
+    bool readFirst;  // The writer read the key before writing it
+    int readValue;
+};
+
+// Version order of one key. Commit lines can be logged out of commit order,
+// so follow read-modify-write chains instead: the next version is the one
+// whose writer read the current value, no-op writes first. Blind writes,
+// and writers whose read version is already overwritten (lost updates),
+// fall back to log order and continue the chain from their own value.
+inline std::vector<KeyWrite> orderVersions(const std::vector<KeyWrite>& writes) {
+    std::unordered_map<int, std::vector<int>> byRead; // read value -> writers, in log order (reversed)
+    for (int i = (int)writes.size() - 1; i >= 0; --i) {
+        if (writes[i].readFirst) byRead[writes[i].readValue].push_back(i);
+    }
+    std::vector<char> placed(writes.size(), 0);
+    std::vector<KeyWrite> order;
+    order.reserve(writes.size());
+    int current = 0;    // Initial value
+    size_t fallback = 0;
+    while (order.size() < writes.size()) {
+        int next = -1;
+        auto it = byRead.find(current);
+        if (it != byRead.end()) {
+            auto& candidates = it->second;
+            while (!candidates.empty() && placed[candidates.back()]) candidates.pop_back();
+            // A writer that left the value unchanged must come before the
+            // ones that read the same value and changed it
+            for (auto c = candidates.rbegin(); c != candidates.rend(); ++c) {
+                if (!placed[*c] && writes[*c].value == current) {
+                    next = *c;
+                    break;
+                }
+            }
+            if (next < 0 && !candidates.empty()) {
+                next = candidates.back();
+                candidates.pop_back();
+            }
+        }
+        if (next < 0) {
+            while (placed[fallback]) ++fallback;
+            next = (int)fallback;
+        }
+        placed[next] = 1;
+        order.push_back(writes[next]);
+        current = writes[next].value;
+    }
+    return order;
+}
+
+// Edges for one shard of keys; keys are independent, so shards run in parallel
+inline void buildShard(const std::unordered_map<int, std::vector<KeyWrite>>& writesByKey,
+    const std::unordered_map<int, std::vector<KeyAccess>>& readsByKey,
+    std::vector<HistoryEdge>& edges, long long& unmatched) {
+    std::unordered_map<int, std::vector<KeyWrite>> versionsByKey;
+    for (const auto& [key, writes] : writesByKey) {
+        auto& versions = versionsByKey[key] = orderVersions(writes);
+        for (size_t i = 1; i < versions.size(); ++i) {
+            edges.push_back({ versions[i - 1].txn, versions[i].txn, EDGE_WW });
+        }
+    }
+
+    for (const auto& [key, reads] : readsByKey) {
+        static const std::vector<KeyWrite> none;
+        auto found = versionsByKey.find(key);
+        const auto& versions = found != versionsByKey.end() ? found->second : none;
+
+        std::unordered_map<int, std::vector<int>> byValue; // value -> positions in version order
+        std::unordered_map<int, int> ownVersion;            // writer -> its position
+        for (size_t i = 0; i < versions.size(); ++i) {
+            byValue[versions[i].value].push_back((int)i);
+            ownVersion[versions[i].txn] = (int)i;
+        }
+
+        // Position -1 is the initial value 0
+        auto valueAt = [&](int pos) { return pos < 0 ? 0 : versions[pos].value; };
+
+        for (const auto& r : reads) {
+            int version = -1;
+            bool matched = false;
+            // A read-modify-write read the version just before its own
+            auto own = ownVersion.find(r.txn);
+            if (own != ownVersion.end() && valueAt(own->second - 1) == r.value) {
+                version = own->second - 1;
+                matched = true;
+            }
+            // Otherwise, among versions with this value, the last one whose
+            // writer was logged before the reader; else the first one
+            auto it = byValue.find(r.value);
+            if (!matched && it != byValue.end()) {
+                for (int pos : it->second) {
+                    if (versions[pos].txn < r.txn) version = pos;
+                }
+                if (version < 0 && r.value != 0) version = it->second.front();
+                matched = true;
+            }
+            if (!matched && r.value != 0) {
+                ++unmatched;
+                continue;
+            }
+
+            // Consecutive versions holding the same value (no-op writes) look
+            // alike to a reader: depend on the first of the run and
+            // anti-depend on the first version that changes the value
+            int first = version, last = version;
+            while (first >= 0 && valueAt(first - 1) == r.value) --first;
+            while (last + 1 < (int)versions.size() && versions[last + 1].value == r.value) ++last;
+
+            if (first >= 0) {
+                edges.push_back({ versions[first].txn, r.txn, EDGE_WR });
+            }
+            if (last + 1 < (int)versions.size() && versions[last + 1].txn != r.txn) {
+                edges.push_back({ r.txn, versions[last + 1].txn, EDGE_RW });
+            }
+        }
+    }
+}
+
+// Iterative Tarjan over a CSR graph; returns the component of every node
+inline std::vector<int> stronglyConnected(int n, const std::vector<int>& offsets, const std::vector<int>& targets) {
+    std::vector<int> index(n, -1), low(n, 0), comp(n, -1), stack, callStack;
+    std::vector<size_t> edgePos(n, 0);
+    std::vector<char> onStack(n, 0);
+    int counter = 0, components = 0;
+
+    for (int root = 0; root < n; ++root) {
+        if (index[root] >= 0) continue;
+        callStack.push_back(root);
+        while (!callStack.empty()) {
+            int v = callStack.back();
+            if (index[v] < 0) {
+                index[v] = low[v] = counter++;
+                edgePos[v] = offsets[v];
+                stack.push_back(v);
+                onStack[v] = 1;
+            }
+            bool descended = false;
+            while (edgePos[v] < (size_t)offsets[v + 1]) {
+                int w = targets[edgePos[v]++];
+                if (index[w] < 0) {
+                    callStack.push_back(w);
+                    descended = true;
+                    break;
+                }
+                if (onStack[w]) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+            }
+            if (descended) continue;
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                int parent = callStack.back();
+                low[parent] = std::min(low[parent], low[v]);
+            }
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = 0;
+                    comp[w] = components;
+                } while (w != v);
+                ++components;
+            }
+        }
+    }
+    return comp;
+}
+
+// Adjacency arrays of the graph, optionally without rw edges; isRw marks
+// the rw targets when given
+inline void toCsr(int n, const std::vector<HistoryEdge>& edges, bool skipRw,
+    std::vector<int>& offsets, std::vector<int>& targets, std::vector<char>* isRw = nullptr) {
+    offsets.assign(n + 1, 0);
+    for (const auto& e : edges) {
+        if (skipRw && e.type == EDGE_RW) continue;
+        ++offsets[e.from + 1];
+    }
+    for (int i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+    targets.assign(offsets[n], 0);
+    if (isRw) {
+        isRw->assign(offsets[n], 0);
+    }
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& e : edges) {
+        if (skipRw && e.type == EDGE_RW) continue;
+        if (isRw) {
+            (*isRw)[fill[e.from]] = e.type == EDGE_RW;
+        }
+        targets[fill[e.from]++] = e.to;
+    }
+}
+
+} // namespace checker
+
+// Build the dependency graph with one thread per key shard, then look for cycles
+inline CheckResult checkHistory(const History& history, int threads = std::max(1u, std::thread::hardware_concurrency())) {
+    using namespace checker;
+    threads = std::max(1, threads);
+    CheckResult result;
+    int n = (int)history.txns.size();
+    result.transactions = n;
+    result.counterKeys = (long long)history.counterKeys.size();
+
+    std::vector<std::vector<HistoryEdge>> shardEdges(threads);
+    std::vector<long long> shardUnmatched(threads, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::unordered_map<int, std::vector<KeyWrite>> writesByKey;
+            std::unordered_map<int, std::vector<KeyAccess>> readsByKey;
+            auto mine = [&](int key) {
+                return (int)((unsigned)key % (unsigned)threads) == t && !history.counterKeys.count(key);
+            };
+            for (int i = 0; i < n; ++i) {
+                const auto& txn = history.txns[i];
+                for (const auto& w : txn.writes) {
+                    if (!mine(w.key)) continue;
+                    auto read = std::find_if(txn.reads.begin(), txn.reads.end(),
+                        [&](const HistoryOp& r) { return r.key == w.key; });
+                    bool readFirst = read != txn.reads.end();
+                    writesByKey[w.key].push_back({ i, w.value, readFirst, readFirst ? read->value : 0 });
+                }
+                for (const auto& r : txn.reads) {
+                    if (mine(r.key)) readsByKey[r.key].push_back({ i, r.value });
+                }
+            }
+            buildShard(writesByKey, readsByKey, shardEdges[t], shardUnmatched[t]);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<HistoryEdge> edges;
+    for (int t = 0; t < threads; ++t) {
+        edges.insert(edges.end(), shardEdges[t].begin(), shardEdges[t].end());
+        result.unmatchedReads += shardUnmatched[t];
+    }
+    for (const auto& e : edges) {
+        ++result.edges[e.type];
+    }
+    for (const auto& txn : history.txns) {
+        result.fuzzyReads += txn.fuzzyReads;
+    }
+
+    // Cycles in the full graph: not serializable
+    std::vector<int> offsets, targets;
+    std::vector<char> targetIsRw;
+    toCsr(n, edges, false, offsets, targets, &targetIsRw);
+    std::vector<int> comp = stronglyConnected(n, offsets, targets);
+    std::unordered_map<int, long long> compSize;
+    for (int c : comp) ++compSize[c];
+    for (const auto& [c, size] : compSize) {
+        if (size > 1) {
+            ++result.cyclicComponents;
+            result.largestComponent = std::max(result.largestComponent, size);
+        }
+    }
+
+    // Cycles of ww/wr edges alone (G1c)
+    std::vector<int> depOffsets, depTargets;
+    toCsr(n, edges, true, depOffsets, depTargets);
+    std::vector<int> depComp = stronglyConnected(n, depOffsets, depTargets);
+    std::unordered_map<int, long long> depSize;
+    for (int c : depComp) ++depSize[c];
+    for (int i = 0; i < n; ++i) {
+        long long& size = depSize[depComp[i]];
+        if (size > 1) {
+            ++result.g1cComponents;
+            if (result.examples.size() < MAX_EXAMPLES) {
+                result.examples.push_back("ww/wr cycle of " + std::to_string(size) + " transactions through Tx " +
+                    std::to_string(history.txns[i].txID));
+            }
+            size = 0; // Count each component once
+        }
+    }
+
+    // rw edges inside cyclic components: write skew pairs, and rw edges that
+    // close a cycle with no two rw edges adjacent (G-SI). The search runs
+    // over states (transaction, arrived by rw): an rw step is not taken
+    // right after another, the first step leaves the rw edge's head, and the
+    // cycle closes on a ww/wr edge into its tail.
+    std::unordered_set<uint64_t> rwPairs;
+    for (const auto& e : edges) {
+        if (e.type == EDGE_RW && e.from != e.to && comp[e.from] == comp[e.to]) {
+            rwPairs.insert((uint64_t)(uint32_t)e.from << 32 | (uint32_t)e.to);
+        }
+    }
+    std::vector<int> seen(2 * n, -1), frontier;
+    long long budget = NON_ADJACENT_RW_BUDGET;
+    int search = 0;
+    for (const auto& e : edges) {
+        if (e.type != EDGE_RW || e.from == e.to || comp[e.from] != comp[e.to]) continue;
+
+        if (e.from < e.to && rwPairs.count((uint64_t)(uint32_t)e.to << 32 | (uint32_t)e.from)) {
+            ++result.writeSkews;
+            if (result.examples.size() < MAX_EXAMPLES) {
+                result.examples.push_back("write skew: Tx " + std::to_string(history.txns[e.from].txID) +
+                    " <-rw-> Tx " + std::to_string(history.txns[e.to].txID));
+            }
+        }
+
+        if (budget <= 0) {
+            result.nonAdjacentCheckComplete = false;
+            continue;
+        }
+        ++search;
+        int startState = 2 * e.to + 1;
+        frontier.assign(1, startState);
+        seen[startState] = search;
+        bool closes = false;
+        while (!frontier.empty() && !closes && budget-- > 0) {
+            int state = frontier.back();
+            frontier.pop_back();
+            int v = state / 2;
+            bool arrivedByRw = state % 2;
+            for (int i = offsets[v]; i < offsets[v + 1]; ++i) {
+                int w = targets[i];
+                bool rw = targetIsRw[i];
+                if (rw && arrivedByRw) continue;
+                if (w == e.from && !rw) {
+                    closes = true;
+                    break;
+                }
+                int next = 2 * w + rw;
+                if (seen[next] != search && comp[w] == comp[e.from]) {
+                    seen[next] = search;
+                    frontier.push_back(next);
+                }
+            }
+        }
+        if (closes) {
+            ++result.nonAdjacentRwCycles;
+            if (result.examples.size() < MAX_EXAMPLES) {
+                result.examples.push_back("cycle without adjacent rw edges: Tx " + std::to_string(history.txns[e.from].txID) +
+                    " -rw-> Tx " + std::to_string(history.txns[e.to].txID) + " ->* back");
+            }
+        }
+    }
+    return result;
+}
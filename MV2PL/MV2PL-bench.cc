@@ -0,0 +1,6 @@
+#include "MV2PL.h"
+#include "../common/microbench.h"
+
+ENGINE_BENCHMARKS(WoundWaitManager);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MV2PL.h"
+
+// ✅ Test: Committed writes are read back by later transactions
+TEST(MV2PLTest, CommittedWriteIsVisible) {
+    WoundWaitManager manager(2);
+    int tx1 = manager.beginTrans();
+    manager.write(tx1, 0, 42);
+    ASSERT_EQ(manager.read(tx1, 0), 42);
+    ASSERT_TRUE(manager.commit(tx1));
+
+    int tx2 = manager.beginTrans(true);
+    ASSERT_EQ(manager.read(tx2, 0), 42);
+    ASSERT_EQ(manager.read(tx2, 1), 0);
+    ASSERT_TRUE(manager.commit(tx2));
+}
+
+// ✅ Test: Aborted writes leave no trace and free their locks
+TEST(MV2PLTest, AbortDiscardsWritesAndLocks) {
+    WoundWaitManager manager(1);
+    int tx1 = manager.beginTrans();
+    manager.write(tx1, 0, 7);
+    manager.abort(tx1);
+
+    int tx2 = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx2, 0), 0); // Would block if the lock were still held
+    ASSERT_TRUE(manager.commit(tx2));
+}
+
+// ✅ Test: Read-only transactions read their snapshot without waiting for a lock holder
+TEST(MV2PLTest, ReadOnlyReadsSnapshotWithoutLocks) {
+    WoundWaitManager manager(1);
+    int writer = manager.beginTrans();
+    manager.write(writer, 0, 1);
+    ASSERT_TRUE(manager.commit(writer));
+
+    int holder = manager.beginTrans();
+    manager.write(holder, 0, manager.read(holder, 0) + 1);
+    int reader = manager.beginTrans(true);
+    ASSERT_EQ(manager.read(reader, 0), 1);
+    ASSERT_TRUE(manager.commit(holder));
+    ASSERT_EQ(manager.read(reader, 0), 1); // Still its snapshot
+    ASSERT_TRUE(manager.commit(reader));
+    ASSERT_EQ(manager.readAsOf(0, manager.currentTimestamp()), 2);
+}
+
+// ✅ Test: A write in a transaction begun read-only aborts it
+TEST(MV2PLTest, WriteInReadOnlyTransactionAborts) {
+    WoundWaitManager manager(1);
+    int tx = manager.beginTrans(true);
+    manager.write(tx, 0, 5);
+    ASSERT_TRUE(manager.isAborted(tx));
+    ASSERT_FALSE(manager.commit(tx));
+    ASSERT_EQ(manager.readAsOf(0, manager.currentTimestamp()), 0);
+}
+
+// ✅ Test: Under wound-wait an older requester aborts the younger lock holder
+TEST(MV2PLTest, WoundWaitWoundsYoungerHolder) {
+    WoundWaitManager manager(1);
+    int older = manager.beginTrans();
+    int younger = manager.beginTrans();
+    manager.write(younger, 0, 1);
+
+    std::thread t([&] {
+        manager.write(older, 0, 2); // Wounds younger, then waits for its release
+    });
+    while (!manager.isAborted(younger)) {
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(manager.commit(younger)); // Releases the lock to older
+    t.join();
+    ASSERT_TRUE(manager.commit(older));
+    ASSERT_EQ(manager.readAsOf(0, manager.currentTimestamp()), 2);
+    ASSERT_EQ(manager.deadlockAborts(), 1);
+}
+
+// ✅ Test: Under wound-wait a younger requester waits for the older holder
+TEST(MV2PLTest, WoundWaitYoungerWaits) {
+    WoundWaitManager manager(1);
+    int older = manager.beginTrans();
+    int younger = manager.beginTrans();
+    manager.write(older, 0, 1);
+
+    std::atomic<int> seen{ -2 };
+    std::thread t([&] {
+        seen = manager.read(younger, 0);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(seen.load(), -2);
+    ASSERT_TRUE(manager.commit(older));
+    t.join();
+    ASSERT_EQ(seen.load(), 1);
+    ASSERT_TRUE(manager.commit(younger));
+    ASSERT_EQ(manager.deadlockAborts(), 0);
+}
+
+// ✅ Test: Under wait-die a younger requester dies instead of waiting
+TEST(MV2PLTest, WaitDieYoungerDies) {
+    WaitDieManager manager(1);
+    int older = manager.beginTrans();
+    int younger = manager.beginTrans();
+    manager.write(older, 0, 1);
+    ASSERT_EQ(manager.read(younger, 0), -1);
+    ASSERT_TRUE(manager.isAborted(younger));
+    ASSERT_FALSE(manager.commit(younger));
+    ASSERT_TRUE(manager.commit(older));
+    ASSERT_EQ(manager.deadlockAborts(), 1);
+}
+
+// ✅ Test: Under wait-die an older requester waits for the younger holder
+TEST(MV2PLTest, WaitDieOlderWaits) {
+    WaitDieManager manager(1);
+    int older = manager.beginTrans();
+    int younger = manager.beginTrans();
+    manager.write(younger, 0, 1);
+
+    std::atomic<int> seen{ -2 };
+    std::thread t([&] {
+        seen = manager.read(older, 0);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(seen.load(), -2);
+    ASSERT_TRUE(manager.commit(younger));
+    t.join();
+    ASSERT_EQ(seen.load(), 1);
+    ASSERT_TRUE(manager.commit(older));
+}
+
+// ✅ Test: A released lock goes to its waiters in arrival order
+TEST(MV2PLTest, LockHandoffIsFifo) {
+    WoundWaitManager manager(1);
+    int holder = manager.beginTrans();
+    manager.write(holder, 0, 0);
+    int first = manager.beginTrans();
+    int second = manager.beginTrans();
+
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto increment = [&](int tx) {
+        manager.write(tx, 0, manager.read(tx, 0) + 1);
+        {
+            std::lock_guard<std::mutex> lk(orderMutex);
+            order.push_back(tx);
+        }
+        manager.commit(tx);
+    };
+    std::thread t1(increment, first);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread t2(increment, second);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(manager.commit(holder));
+    t1.join();
+    t2.join();
+    ASSERT_EQ(order, (std::vector<int>{ first, second }));
+    ASSERT_EQ(manager.readAsOf(0, manager.currentTimestamp()), 2);
+}
+
+// ✅ Test: Concurrent read-modify-writes on one hot key lose no update
+TEST(MV2PLTest, HotKeyIncrementsLoseNoUpdate) {
+    WoundWaitManager manager(4);
+    const int threads = 4, perThread = 500;
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        workers.emplace_back([&] {
+            for (int done = 0; done < perThread;) {
+                int tx = manager.beginTrans();
+                int a = manager.read(tx, 0);
+                manager.write(tx, 0, a + 1);
+                int b = manager.read(tx, 1 + done % 3);
+                manager.write(tx, 1 + done % 3, b + 1);
+                if (manager.commit(tx)) {
+                    ++done;
+                }
+            }
+        });
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    int ts = manager.currentTimestamp();
+    ASSERT_EQ(manager.readAsOf(0, ts), threads * perThread);
+    ASSERT_EQ(manager.readAsOf(1, ts) + manager.readAsOf(2, ts) + manager.readAsOf(3, ts), threads * perThread);
+}
+
+// ✅ Test: Lock waits and their duration reach the live counters
+TEST(MV2PLTest, LockWaitsAreCounted) {
+    WaitDieManager manager(2);
+    long long waitsBefore = liveCounters.total(LIVE_LOCK_WAITS);
+    long long nanosBefore = liveCounters.total(LIVE_LOCK_WAIT_NS);
+    int older = manager.beginTrans();
+    int younger = manager.beginTrans();
+    manager.write(younger, 0, 1);
+
+    std::thread t([&] {
+        manager.read(older, 0);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(manager.commit(younger));
+    t.join();
+    ASSERT_TRUE(manager.commit(older));
+    ASSERT_EQ(liveCounters.total(LIVE_LOCK_WAITS) - waitsBefore, 1);
+    ASSERT_GE(liveCounters.total(LIVE_LOCK_WAIT_NS) - nanosBefore, 10000000);
+
+    VersionStats stats = manager.versionStats();
+    ASSERT_EQ(stats.versions, 3);
+    ASSERT_EQ(stats.longestChain, 2);
+    ASSERT_EQ(stats.gcBacklog, 1);
+}
+
+// ✅ Test: Aborting a finished handle leaves the slot's next owner running
+TEST(MV2PLTest, StaleAbortIgnored) {
+    WoundWaitManager manager(2, 1);
+    int a = manager.beginTrans();
+    manager.write(a, 0, 1);
+    ASSERT_TRUE(manager.commit(a));
+
+    int b = manager.beginTrans();   // Reuses the only context
+    ASSERT_NE(b, a);
+    manager.abort(a);
+    ASSERT_FALSE(manager.commit(a));
+    ASSERT_FALSE(manager.isAborted(b));
+    manager.write(b, 1, 2);
+    ASSERT_TRUE(manager.commit(b));
+    ASSERT_EQ(manager.readAsOf(1, manager.currentTimestamp()), 2);
+}
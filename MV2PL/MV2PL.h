@@ -0,0 +1,388 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <utility>
+#include <chrono>
+#include "../common/memory.h"
+#include "../common/metrics.h"
+
+// Multi-version two-phase locking, the pessimistic counterpart of SI for
+// hot-spot workloads. An update transaction locks every key it touches
+// exclusively, reads included (like SELECT ... FOR UPDATE), and holds the
+// locks until it finishes: its read-modify-writes never lose an update and
+// never need a lock upgrade. A read-only transaction takes no locks and
+// reads the version chains as of the newest fully installed commit.
+//
+// Deadlocks are avoided by transaction age (begin order):
+//   WOUND_WAIT  an older requester aborts ("wounds") the younger holder and
+//               waiters ahead of it, then waits; a younger one waits
+//   WAIT_DIE    an older requester waits; a younger one aborts itself
+// A released lock is handed straight to the first waiter in its queue.
+
+enum DeadlockPolicy { WOUND_WAIT, WAIT_DIE };
+
+struct MVVersion {
+    int value;
+    int commit_ts;
+    MVVersion* prev;    // Next older version
+};
+
+enum LockingState { TX_ACTIVE, TX_COMMITTING, TX_ABORTED };
+
+struct MVWrite {
+    int index;
+    int value;
+};
+
+// Per-transaction context. txID % poolSize selects the slot, the quotient
+// is a generation that changes whenever the slot is reused.
+struct alignas(64) LockingTransaction {
+    std::atomic<bool> inUse{ false };
+    int txID = 0;
+    int age = 0;            // Begin order: smaller is older and wins conflicts
+    int start_ts = 0;       // Snapshot of a read-only transaction
+    bool readOnly = false;
+    std::atomic<int> state{ TX_ACTIVE };
+    std::vector<int> heldKeys;
+    std::vector<MVWrite> writeSet;
+
+    // Lock wait: the releaser handing the lock over sets granted, a wounder
+    // sets state; both notify under waitMutex
+    std::mutex waitMutex;
+    std::condition_variable wakeup;
+    bool granted = false;
+};
+
+struct alignas(64) KeyLock {
+    std::mutex latch;
+    int owner = 0;                              // txID of the holder, 0 = free
+    std::vector<LockingTransaction*> queue;     // Waiters in arrival order
+};
+
+template <DeadlockPolicy Policy = WOUND_WAIT>
+class MV2PLManager {
+private:
+    std::vector<KeyLock> locks;
+    std::vector<std::atomic<MVVersion*>> heads; // Newest committed version per key
+    std::vector<LockingTransaction> txPool;
+    int poolSize;
+
+    std::atomic<int> nextAge{ 1 };
+    std::mutex commitMutex;             // Orders commits; held only to install versions
+    int lastCommitTS = 0;               // Guarded by commitMutex
+    std::vector<int> chainLengths;      // Guarded by commitMutex
+    long long versionCount;             // Guarded by commitMutex
+    int longestChain = 1;               // Guarded by commitMutex
+    std::atomic<int> visibleTS{ 0 };    // Every commit up to it is fully installed
+    std::atomic<long long> policyAborts{ 0 };
+
+    // nullptr once txID has committed or aborted, so a stale handle never
+    // reaches the slot's next owner
+    LockingTransaction* lookup(int txID) {
+        LockingTransaction* txn = &txPool[txID % poolSize];
+        return txn->inUse.load(std::memory_order_acquire) && txn->txID == txID ? txn : nullptr;
+    }
+
+    static bool isActive(const LockingTransaction* txn) {
+        return txn->state.load(std::memory_order_acquire) == TX_ACTIVE;
+    }
+
+    // Abort txn on behalf of the deadlock policy, unless it is already
+    // committing or aborted
+    void doom(LockingTransaction* txn) {
+        int expected = TX_ACTIVE;
+        if (txn->state.compare_exchange_strong(expected, TX_ABORTED, std::memory_order_acq_rel)) {
+            policyAborts.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lk(txn->waitMutex);
+            txn->wakeup.notify_one();
+        }
+    }
+
+    // Lock index for txn, waiting while the policy allows; false if txn has
+    // to abort
+    bool acquire(LockingTransaction* txn, int index) {
+        if (std::find(txn->heldKeys.begin(), txn->heldKeys.end(), index) != txn->heldKeys.end()) {
+            return true;
+        }
+        KeyLock& k = locks[index];
+        std::unique_lock<std::mutex> lk(k.latch);
+        if (k.owner == 0) {
+            k.owner = txn->txID;
+            txn->heldKeys.push_back(index);
+            return true;
+        }
+
+        // The holder's context cannot be recycled while it owns the lock
+        LockingTransaction* holder = lookup(k.owner);
+        if constexpr (Policy == WAIT_DIE) {
+            // Wait only behind younger transactions, which keeps every queue
+            // ordered youngest first and the waits-for graph acyclic
+            bool oldest = holder->age > txn->age;
+            for (auto* waiter : k.queue) {
+                oldest = oldest && waiter->age > txn->age;
+            }
+            if (!oldest) {
+                doom(txn);
+                return false;
+            }
+        }
+        else {
+            if (holder->age > txn->age) {
+                doom(holder);
+            }
+            for (auto* waiter : k.queue) {
+                if (waiter->age > txn->age) {
+                    doom(waiter);
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> w(txn->waitMutex);
+            txn->granted = false;
+        }
+        k.queue.push_back(txn);
+        lk.unlock();
+        auto waitStart = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> w(txn->waitMutex);
+            txn->wakeup.wait(w, [txn] { return txn->granted || !isActive(txn); });
+        }
+        liveCounters.add(LIVE_LOCK_WAITS);
+        liveCounters.add(LIVE_LOCK_WAIT_NS, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - waitStart).count());
+        lk.lock();
+        if (k.owner == txn->txID) {
+            txn->heldKeys.push_back(index); // Handed over, maybe just as we were wounded
+            return isActive(txn);
+        }
+        k.queue.erase(std::find(k.queue.begin(), k.queue.end(), txn));
+        return false;
+    }
+
+    // Hand index over to its first waiter, or free it
+    void releaseLock(int index) {
+        KeyLock& k = locks[index];
+        std::lock_guard<std::mutex> lk(k.latch);
+        if (k.queue.empty()) {
+            k.owner = 0;
+            return;
+        }
+        LockingTransaction* next = k.queue.front();
+        k.queue.erase(k.queue.begin());
+        k.owner = next->txID;
+        std::lock_guard<std::mutex> w(next->waitMutex);
+        next->granted = true;
+        next->wakeup.notify_one();
+    }
+
+    // Drop the locks (strict 2PL: only now) and return the context. The
+    // slot moves to its next generation before it can be claimed again, so
+    // the finished handle stops matching even while a new owner sets it up.
+    void finish(LockingTransaction* txn) {
+        for (int index : txn->heldKeys) {
+            releaseLock(index);
+        }
+        txn->heldKeys.clear();
+        txn->writeSet.clear();
+        txn->txID += poolSize;
+        txn->inUse.store(false, std::memory_order_release);
+    }
+
+    MVWrite* findWrite(LockingTransaction* txn, int index) {
+        for (auto& w : txn->writeSet) {
+            if (w.index == index) {
+                return &w;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    // Lock waits block the calling thread
+    static constexpr bool blocksOnConflict = true;
+
+    MV2PLManager(int m, int maxActiveTx = 1024)
+        : locks(m), heads(m), txPool(maxActiveTx), poolSize(maxActiveTx), chainLengths(m, 1), versionCount(m) {
+        for (auto& head : heads) {
+            head.store(new MVVersion{ 0, 0, nullptr }, std::memory_order_relaxed);
+        }
+        for (int slot = 0; slot < poolSize; ++slot) {
+            txPool[slot].txID = slot + poolSize; // generation 0 is never handed out
+        }
+    }
+
+    static MV2PLManager withContextPool(int m, int maxActiveTx) {
+        return MV2PLManager(m, maxActiveTx);
+    }
+
+    int contextPoolSize() const {
+        return poolSize;
+    }
+
+    ~MV2PLManager() {
+        for (auto& head : heads) {
+            for (MVVersion* v = head.load(); v;) {
+                MVVersion* prev = v->prev;
+                delete v;
+                v = prev;
+            }
+        }
+    }
+
+    MV2PLManager(const MV2PLManager&) = delete;
+    MV2PLManager& operator=(const MV2PLManager&) = delete;
+
+    // A read-only transaction reads a snapshot without locking; an update
+    // transaction (the default, for callers that cannot tell) locks
+    int beginTrans(bool readOnly = false) {
+        int txID;
+        while ((txID = tryBeginTrans(readOnly)) < 0) {
+            std::this_thread::yield();
+        }
+        return txID;
+    }
+
+    // Non-blocking begin: -1 if every transaction context is in use
+    int tryBeginTrans(bool readOnly = false) {
+        // Claim a free context, starting from where this thread last found one
+        static thread_local int cursor = 0;
+        for (int i = 0; i < poolSize; ++i) {
+            int slot = (cursor + i) % poolSize;
+            LockingTransaction& txn = txPool[slot];
+            bool expected = false;
+            if (txn.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                cursor = slot;
+                txn.age = nextAge.fetch_add(1, std::memory_order_relaxed);
+                txn.readOnly = readOnly;
+                txn.start_ts = visibleTS.load(std::memory_order_acquire);
+                txn.state.store(TX_ACTIVE, std::memory_order_relaxed);
+                return txn.txID;
+            }
+        }
+        return -1;
+    }
+
+    int read(int txID, int index) {
+        auto* txn = lookup(txID);
+        if (!txn || !isActive(txn)) {
+            return -1;
+        }
+        if (txn->readOnly) {
+            return readAsOf(index, txn->start_ts);
+        }
+        if (MVWrite* w = findWrite(txn, index)) {
+            return w->value;
+        }
+        if (!acquire(txn, index)) {
+            return -1;
+        }
+        // Holding the lock, the newest version cannot change under us
+        return heads[index].load(std::memory_order_acquire)->value;
+    }
+
+    void write(int txID, int index, int val) {
+        auto* txn = lookup(txID);
+        if (!txn || !isActive(txn)) {
+            return;
+        }
+        if (txn->readOnly) {
+            txn->state.store(TX_ABORTED, std::memory_order_release); // Declared read-only
+            return;
+        }
+        if (MVWrite* w = findWrite(txn, index)) {
+            w->value = val;
+            return;
+        }
+        if (acquire(txn, index)) {
+            txn->writeSet.push_back({ index, val });
+        }
+    }
+
+    bool commit(int txID) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return false; // Already finished, context recycled
+        }
+        int expected = TX_ACTIVE;
+        if (!txn->state.compare_exchange_strong(expected, TX_COMMITTING, std::memory_order_acq_rel)) {
+            finish(txn);
+            return false; // Wounded, died or wrote while read-only
+        }
+
+        if (!txn->writeSet.empty()) {
+            std::vector<MVVersion*> versions;
+            versions.reserve(txn->writeSet.size());
+            for (const auto& w : txn->writeSet) {
+                versions.push_back(new MVVersion{ w.value, 0, nullptr });
+            }
+            std::lock_guard<std::mutex> lk(commitMutex);
+            int commit_ts = ++lastCommitTS;
+            for (size_t i = 0; i < versions.size(); ++i) {
+                auto& head = heads[txn->writeSet[i].index];
+                versions[i]->commit_ts = commit_ts;
+                versions[i]->prev = head.load(std::memory_order_relaxed);
+                head.store(versions[i], std::memory_order_release);
+                longestChain = std::max(longestChain, ++chainLengths[txn->writeSet[i].index]);
+            }
+            versionCount += versions.size();
+            visibleTS.store(commit_ts, std::memory_order_release);
+        }
+        finish(txn);
+        return true;
+    }
+
+    void abort(int txID) {
+        auto* txn = lookup(txID);
+        if (txn) {
+            txn->state.store(TX_ABORTED, std::memory_order_release);
+            finish(txn);
+        }
+    }
+
+    // Lets the caller stop issuing operations once the deadlock policy has
+    // aborted the transaction. A finished handle is reported as aborted.
+    bool isAborted(int txID) {
+        auto* txn = lookup(txID);
+        return !txn || txn->state.load(std::memory_order_acquire) == TX_ABORTED;
+    }
+
+    // Aborts forced by wound-wait or wait-die, the price of never deadlocking
+    long long deadlockAborts() const {
+        return policyAborts.load();
+    }
+
+    // Chain lengths, kept up to date by every install. Nothing is ever
+    // collected, so every superseded version counts as backlog.
+    VersionStats versionStats() {
+        std::lock_guard<std::mutex> lk(commitMutex);
+        VersionStats stats;
+        stats.keys = (long long)chainLengths.size();
+        stats.versions = versionCount;
+        stats.longestChain = chainLengths.empty() ? 0 : longestChain;
+        stats.gcBacklog = versionCount - stats.keys;
+        return stats;
+    }
+
+    // Committed value of index as of ts, without a transaction or a lock
+    int readAsOf(int index, int ts) {
+        MVVersion* v = heads[index].load(std::memory_order_acquire);
+        while (v->prev && v->commit_ts > ts) {
+            v = v->prev;
+        }
+        return v->value;
+    }
+
+    // Newest timestamp whose commits are all visible
+    int currentTimestamp() {
+        return visibleTS.load(std::memory_order_acquire);
+    }
+};
+
+using WoundWaitManager = MV2PLManager<WOUND_WAIT>;
+using WaitDieManager = MV2PLManager<WAIT_DIE>;
@@ -0,0 +1,11 @@
+#include "MV2PL.h"
+#include "../common/driver.h"
+
+// Wound-wait by default; build with -DMV2PL_WAIT_DIE for wait-die
+int main(int argc, char** argv) {
+#ifdef MV2PL_WAIT_DIE
+    return runDriver<WaitDieManager>(argc, argv, "MV2PL-WaitDie");
+#else
+    return runDriver<WoundWaitManager>(argc, argv, "MV2PL");
+#endif
+}
@@ -0,0 +1,126 @@
+#!/bin/bash
+
+# Script to run MV2PL experiments
+# Experiment 1: Vary threads from 2 to 64, keep read ratio constant
+# Experiment 2: Keep threads constant at 8, vary key skew from uniform to one
+#               hot spot, comparing wound-wait, wait-die and SI with retries
+
+# Compilation (adjust compiler flags as needed)
+echo "Compiling the programs..."
+g++ -std=c++17 -O2 -pthread -o a.out SI-run.cc
+g++ -std=c++17 -O2 -pthread -DMV2PL_WAIT_DIE -o wait-die.out SI-run.cc
+g++ -std=c++17 -O2 -pthread -o si.out ../SI/SI-run.cc
+
+# Constants for experiments
+M=1000           # Number of data items
+NUM_TRANS=100    # Transactions per thread
+CONST_VAL=100    # Maximum value for writes
+NUM_ITERS=10     # Operations per transaction
+LAMBDA=10        # Mean delay between operations (ms)
+DEFAULT_READ_RATIO=0.7  # Default read ratio
+
+# Function to run a single experiment
+run_experiment() {
+    local binary=$1
+    local threads=$2
+    local read_ratio=$3
+    local skew=$4
+    local output_dir=$5
+    local tag=$6
+
+    echo "Running $binary with threads=$threads, read_ratio=$read_ratio, skew=$skew"
+
+    # Create experiment directory
+    mkdir -p "$output_dir"
+
+    # Create input parameter file
+    echo "$threads $M $NUM_TRANS $CONST_VAL $NUM_ITERS $LAMBDA $read_ratio" > inp-params.txt
+
+    # Run the experiment
+    ./$binary --skew=$skew
+
+    # Save results to the experiment directory
+    cp si_result.txt "$output_dir/result_${tag}.txt"
+    cp si_log.txt "$output_dir/log_${tag}.txt"
+
+    # Extract key metrics for summary
+    commits_per_sec=$(grep "Commits per second" si_result.txt | awk '{print $4}')
+    aborts_per_sec=$(grep "Aborts per second" si_result.txt | awk '{print $4}')
+    ser_aborts_per_sec=$(grep "Serial. aborts per second" si_result.txt | awk '{print $5}')
+}
+
+# Experiment 1: Varying threads
+echo "Starting Experiment 1: Varying thread counts from 2 to 64"
+exp1_dir="experiment_vary_threads"
+mkdir -p "$exp1_dir"
+echo "threads,read_ratio,commits_per_sec,aborts_per_sec,ser_aborts_per_sec" > "$exp1_dir/summary.csv"
+
+for threads in 2 4 8 16 24 32 48 64; do
+    run_experiment a.out $threads $DEFAULT_READ_RATIO 0 "$exp1_dir" "t${threads}_r${DEFAULT_READ_RATIO}"
+    echo "$threads,$DEFAULT_READ_RATIO,$commits_per_sec,$aborts_per_sec,$ser_aborts_per_sec" >> "$exp1_dir/summary.csv"
+done
+
+# Experiment 2: Varying skew, locking against SI with retries
+echo "Starting Experiment 2: Varying key skew from 0 to 0.99"
+exp2_dir="experiment_vary_skew"
+mkdir -p "$exp2_dir"
+echo "engine,skew,commits_per_sec,aborts_per_sec" > "$exp2_dir/summary.csv"
+
+for skew in 0 0.5 0.8 0.9 0.99; do
+    for engine in wound-wait wait-die si; do
+        case $engine in
+            wound-wait) binary=a.out ;;
+            wait-die) binary=wait-die.out ;;
+            si) binary=si.out ;;
+        esac
+        run_experiment $binary 8 $DEFAULT_READ_RATIO $skew "$exp2_dir" "${engine}_s${skew}"
+        echo "$engine,$skew,$commits_per_sec,$aborts_per_sec" >> "$exp2_dir/summary.csv"
+    done
+done
+
+# Generate plots (if gnuplot is available)
+if command -v gnuplot >/dev/null 2>&1; then
+    echo "Generating plots with gnuplot"
+
+    # Plot for varying threads
+    cat > plot_threads.gp << EOF2
+set terminal png size 800,600
+set output "experiment_vary_threads/throughput_vs_threads.png"
+set title "Transaction Throughput vs. Number of Threads"
+set xlabel "Number of Threads"
+set ylabel "Transactions per Second"
+set key outside
+set grid
+set datafile separator ","
+plot "experiment_vary_threads/summary.csv" using 1:3 with linespoints title "Commits/sec", \
+     "experiment_vary_threads/summary.csv" using 1:4 with linespoints title "Aborts/sec"
+EOF2
+    gnuplot plot_threads.gp
+
+    # Plot for varying skew, one line per engine
+    for engine in wound-wait wait-die si; do
+        grep "^$engine," "$exp2_dir/summary.csv" | cut -d, -f2- > "$exp2_dir/$engine.csv"
+    done
+    cat > plot_skew.gp << EOF2
+set terminal png size 800,600
+set output "experiment_vary_skew/throughput_vs_skew.png"
+set title "Committed Transactions per Second vs. Key Skew"
+set xlabel "Zipf Exponent"
+set ylabel "Commits per Second"
+set key outside
+set grid
+set datafile separator ","
+plot "experiment_vary_skew/wound-wait.csv" using 1:2 with linespoints title "MV2PL wound-wait", \
+     "experiment_vary_skew/wait-die.csv" using 1:2 with linespoints title "MV2PL wait-die", \
+     "experiment_vary_skew/si.csv" using 1:2 with linespoints title "SI with retries"
+EOF2
+    gnuplot plot_skew.gp
+
+    rm plot_threads.gp plot_skew.gp
+else
+    echo "gnuplot not found - skipping plot generation"
+fi
+
+echo "Experiments completed!"
+echo "Results for thread variation are in: $exp1_dir"
+echo "Results for skew variation are in: $exp2_dir"
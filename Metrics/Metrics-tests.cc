@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/metrics.h"
+
+static int countLines(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    int lines = 0;
+    while (std::getline(in, line)) {
+        ++lines;
+    }
+    return lines;
+}
+
+static std::vector<std::string> csvFields(const std::string& row) {
+    std::vector<std::string> fields;
+    std::stringstream ss(row);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// ✅ Test: Counters from many threads add up, also after the threads exit
+TEST(MetricsTest, PerThreadCountersSum) {
+    LiveCounters counters;
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&counters] {
+                for (int i = 0; i < 10000; ++i) {
+                    counters.add(LIVE_COMMITS);
+                }
+                counters.add(LIVE_LOCK_WAIT_NS, 500);
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        ASSERT_EQ(counters.total(LIVE_COMMITS), (round + 1) * 80000LL);
+        ASSERT_EQ(counters.total(LIVE_LOCK_WAIT_NS), (round + 1) * 4000LL);
+    }
+    ASSERT_EQ(counters.total(LIVE_ABORTS), 0);
+}
+
+// ✅ Test: Threads beyond the slot count share the overflow slot without losing updates
+TEST(MetricsTest, OverflowSlotIsShared) {
+    LiveCounters counters;
+    const int threadCount = LiveCounters::SLOTS + 16;
+    std::atomic<int> started{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&] {
+            counters.add(LIVE_BEGINS);
+            started.fetch_add(1);
+            while (started.load() < threadCount) {
+                std::this_thread::yield(); // Keep every slot claimed
+            }
+            for (int i = 0; i < 100; ++i) {
+                counters.add(LIVE_BEGINS);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    ASSERT_EQ(counters.total(LIVE_BEGINS), threadCount * 101LL);
+}
+
+// ✅ Test: The sampler writes rows while running and a last one at stop, with probe fields
+TEST(MetricsTest, SamplerWritesTimeSeries) {
+    LiveCounters counters;
+    counters.add(LIVE_COMMITS, 7); // Before the sampler starts: not reported
+    std::string path = testing::TempDir() + "metrics-test.csv";
+    LiveMetricsOptions options;
+    options.csvPath = path;
+    options.intervalMs = 10;
+    LiveMetricsSampler sampler(options, [](LiveSample& s) { s.versions = 42; }, counters);
+    std::string error;
+    ASSERT_TRUE(sampler.start(error)) << error;
+
+    counters.add(LIVE_BEGINS, 5);
+    counters.add(LIVE_COMMITS, 3);
+    counters.add(LIVE_ABORTS, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    sampler.stop();
+
+    ASSERT_GE(sampler.sampleCount(), 2);
+    ASSERT_EQ(countLines(path), sampler.sampleCount() + 1);
+    std::ifstream in(path);
+    std::string line, last;
+    while (std::getline(in, line)) {
+        last = line;
+    }
+    std::remove(path.c_str());
+    auto fields = csvFields(last);
+    ASSERT_EQ(fields.size(), 15u);
+    ASSERT_EQ(fields[1], "3");  // commits
+    ASSERT_EQ(fields[2], "1");  // aborts
+    ASSERT_EQ(fields[3], "1");  // in flight
+    ASSERT_EQ(fields[11], "42"); // versions, from the probe
+}
+
+// ✅ Test: A published sample is read back from the mapped page by a reader
+TEST(MetricsTest, PageRoundTrip) {
+    std::string path = testing::TempDir() + "metrics-test.page";
+    std::string error;
+    LiveMetricsPage* page = createLiveMetricsPage(path, 250, error);
+    ASSERT_NE(page, nullptr) << error;
+    const LiveMetricsPage* reader = openLiveMetricsPage(path, error);
+    ASSERT_NE(reader, nullptr) << error;
+    ASSERT_EQ(reader->intervalMs, 250u);
+
+    LiveSample s;
+    ASSERT_EQ(readLiveSample(reader, s), 0u);
+    for (int i = 1; i <= 3; ++i) {
+        LiveSample published;
+        published.commits = i * 100;
+        published.gcBacklog = i;
+        publishLiveSample(page, published);
+    }
+    ASSERT_EQ(readLiveSample(reader, s), 3u);
+    ASSERT_EQ(s.commits, 300);
+    ASSERT_EQ(s.gcBacklog, 3);
+
+    unmapLiveMetricsPage(reader);
+    unmapLiveMetricsPage(page);
+    std::remove(path.c_str());
+}
+
+// ✅ Test: Files that are not metrics pages are rejected
+TEST(MetricsTest, RejectsOtherFiles) {
+    std::string path = testing::TempDir() + "metrics-test.other";
+    {
+        std::ofstream out(path);
+        out << std::string(sizeof(LiveMetricsPage), 'x');
+    }
+    std::string error;
+    ASSERT_EQ(openLiveMetricsPage(path, error), nullptr);
+    std::remove(path.c_str());
+    ASSERT_EQ(openLiveMetricsPage(path, error), nullptr);
+}
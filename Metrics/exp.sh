@@ -0,0 +1,104 @@
+#!/bin/bash
+
+# Script to watch runs while they are in progress
+# Experiment 1: SI-SSN with and without a memory budget, sampling throughput,
+#               aborts by cause, chain lengths and GC backlog over time
+# Experiment 2: MV2PL at rising key skew, sampling lock waits and deadlock aborts
+# A watcher follows the shared page of each run next to the CSV time series
+
+# Compilation (adjust compiler flags as needed)
+echo "Compiling the programs..."
+g++ -std=c++17 -O2 -pthread -o metrics-watch metrics-watch.cc
+g++ -std=c++17 -O2 -pthread -o ssn.out ../SI-SSN/SI-run.cc
+g++ -std=c++17 -O2 -pthread -o mv2pl.out ../MV2PL/SI-run.cc
+
+# Constants for experiments
+THREADS=8        # Number of threads
+M=1000           # Number of data items
+NUM_TRANS=500    # Transactions per thread
+CONST_VAL=100    # Maximum value for writes
+NUM_ITERS=10     # Operations per transaction
+LAMBDA=2         # Mean delay between operations (ms)
+READ_RATIO=0.7
+INTERVAL=100     # Sampling interval (ms)
+
+# Function to run one experiment with live metrics
+run_live() {
+    local binary=$1
+    local output_dir=$2
+    local tag=$3
+    shift 3
+
+    echo "Running $binary $* with live metrics every ${INTERVAL} ms"
+    mkdir -p "$output_dir"
+    echo "$THREADS $M $NUM_TRANS $CONST_VAL $NUM_ITERS $LAMBDA $READ_RATIO" > inp-params.txt
+
+    ./metrics-watch "$output_dir/page_${tag}" > "$output_dir/watch_${tag}.csv" &
+    watcher=$!
+    ./$binary "$@" --metrics="$output_dir/live_${tag}.csv" --metrics-page="$output_dir/page_${tag}" \
+        --metrics-interval=$INTERVAL
+    wait $watcher
+    rm -f "$output_dir/page_${tag}"
+
+    cp si_result.txt "$output_dir/result_${tag}.txt"
+}
+
+# Experiment 1: Version store over time, unbounded and under a budget
+exp1_dir="experiment_live_memory"
+for budget in 0 6; do
+    if [ "$budget" = 0 ]; then
+        run_live ssn.out "$exp1_dir" "unbounded"
+    else
+        run_live ssn.out "$exp1_dir" "budget${budget}" --memory-budget=$budget
+    fi
+done
+
+# Experiment 2: Lock waits over time as skew rises
+exp2_dir="experiment_live_locks"
+for skew in 0 0.9 0.99; do
+    run_live mv2pl.out "$exp2_dir" "s${skew}" --skew=$skew
+done
+
+# Generate plots (if gnuplot is available)
+if command -v gnuplot >/dev/null 2>&1; then
+    echo "Generating plots with gnuplot"
+
+    cat > plot_memory.gp << EOF2
+set terminal png size 800,600
+set output "experiment_live_memory/backlog_over_time.png"
+set title "SI-SSN Version Store During the Run"
+set xlabel "Time (s)"
+set ylabel "Versions"
+set key outside
+set grid
+set datafile separator ","
+plot "experiment_live_memory/live_unbounded.csv" using 1:12 with lines title "versions, unbounded", \
+     "experiment_live_memory/live_unbounded.csv" using 1:14 with lines title "GC backlog, unbounded", \
+     "experiment_live_memory/live_budget6.csv" using 1:12 with lines title "versions, 6 MB budget", \
+     "experiment_live_memory/live_budget6.csv" using 1:14 with lines title "GC backlog, 6 MB budget"
+EOF2
+    gnuplot plot_memory.gp
+
+    cat > plot_locks.gp << EOF2
+set terminal png size 800,600
+set output "experiment_live_locks/throughput_over_time.png"
+set title "MV2PL Commits per Second During the Run"
+set xlabel "Time (s)"
+set ylabel "Commits per Second"
+set key outside
+set grid
+set datafile separator ","
+plot "experiment_live_locks/live_s0.csv" using 1:5 with lines title "skew 0", \
+     "experiment_live_locks/live_s0.9.csv" using 1:5 with lines title "skew 0.9", \
+     "experiment_live_locks/live_s0.99.csv" using 1:5 with lines title "skew 0.99"
+EOF2
+    gnuplot plot_locks.gp
+
+    rm plot_memory.gp plot_locks.gp
+else
+    echo "gnuplot not found - skipping plot generation"
+fi
+
+echo "Experiments completed!"
+echo "Results for the version store are in: $exp1_dir"
+echo "Results for lock waits are in: $exp2_dir"
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include "../common/metrics.h"
+
+// Usage: ./metrics-watch [--count=N] [--latest] PAGE
+//   PAGE        the file a run publishes to with --metrics-page=PAGE; the
+//               watcher waits for it to appear, so it may start first
+//   --count=N   stop after N samples
+//   --latest    print only the newest sample and exit
+// Prints every new sample as a CSV row (the --metrics format) until the
+// run finishes. Exit status is 2 if PAGE is not a metrics page.
+int main(int argc, char** argv) {
+    std::string path;
+    long long count = -1;
+    bool latest = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.rfind("--count=", 0) == 0) {
+            count = std::stoll(arg.substr(8));
+        }
+        else if (arg == "--latest") {
+            latest = true;
+        }
+        else {
+            path = arg;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--count=N] [--latest] PAGE\n";
+        return 2;
+    }
+
+    std::string error;
+    const LiveMetricsPage* page;
+    while (!(page = openLiveMetricsPage(path, error))) {
+        if (error.find("cannot open") != 0) {
+            std::cerr << "Error: " << error << "\n";
+            return 2;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    // Poll twice per sampling interval so no sample is missed
+    auto poll = std::chrono::milliseconds(std::max(1u, page->intervalMs / 2));
+    writeLiveCsvHeader(std::cout);
+    LiveSample s;
+    uint64_t seen = 0;
+    long long printed = 0;
+    while (count < 0 || printed < count) {
+        bool finished = page->finished.load(std::memory_order_acquire);
+        uint64_t seq = readLiveSample(page, s);
+        if (seq != seen) {
+            writeLiveCsvRow(std::cout, s);
+            std::cout.flush();
+            seen = seq;
+            ++printed;
+            if (latest) {
+                break;
+            }
+        }
+        if (finished) {
+            break;
+        }
+        std::this_thread::sleep_for(poll);
+    }
+    unmapLiveMetricsPage(page);
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "OCC.h"
+#include "../common/microbench.h"
+
+ENGINE_BENCHMARKS(SiloOCCManager);
+
+BENCHMARK_MAIN();
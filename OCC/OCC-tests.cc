@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "OCC.h"
+
+// ✅ Test: Read-only transactions with no concurrent writers commit
+TEST(SiloOCCTest, ReadOnlyCommits) {
+    SiloOCCManager manager(2);
+    int tx = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx, 0), 0);
+    ASSERT_EQ(manager.read(tx, 1), 0);
+    ASSERT_TRUE(manager.commit(tx));
+}
+
+// ✅ Test: Writers on different keys should not abort
+TEST(SiloOCCTest, DisjointWritesNoAbort) {
+    SiloOCCManager manager(2);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 100);
+    manager.write(tx2, 1, 200);
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_TRUE(manager.commit(tx2));
+}
+
+// ✅ Test: Read-modify-write on a key changed since the read must abort
+TEST(SiloOCCTest, StaleReadAborts) {
+    SiloOCCManager manager(1);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, manager.read(tx1, 0) + 1);
+    manager.write(tx2, 0, manager.read(tx2, 0) + 1);
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_FALSE(manager.commit(tx2));
+}
+
+// ✅ Test: Blind writes serialize without conflict, last committer wins
+TEST(SiloOCCTest, BlindWritesSerialize) {
+    SiloOCCManager manager(1);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 111);
+    manager.write(tx2, 0, 222);
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_TRUE(manager.commit(tx2));
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 222);
+    ASSERT_TRUE(manager.commit(check));
+}
+
+// ✅ Test: Classic write skew is rejected by read-set validation
+TEST(SiloOCCTest, WriteSkewAborted) {
+    SiloOCCManager manager(2);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    if (manager.read(tx1, 0) == 0 && manager.read(tx1, 1) == 0) manager.write(tx1, 0, 1);
+    if (manager.read(tx2, 0) == 0 && manager.read(tx2, 1) == 0) manager.write(tx2, 1, 1);
+
+    bool c1 = manager.commit(tx1);
+    bool c2 = manager.commit(tx2);
+    EXPECT_FALSE(c1 && c2) << "OCC must not let both write-skew transactions commit.";
+}
+
+// ✅ Test: Read-your-writes and invisibility of uncommitted writes
+TEST(SiloOCCTest, ReadYourWritesOnly) {
+    SiloOCCManager manager(1);
+    int tx1 = manager.beginTrans();
+    manager.write(tx1, 0, 55);
+    ASSERT_EQ(manager.read(tx1, 0), 55);
+
+    int tx2 = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx2, 0), 0);
+    ASSERT_TRUE(manager.commit(tx2));
+    ASSERT_TRUE(manager.commit(tx1));
+}
+
+// ✅ Test: Concurrent increments with retry never lose an update
+TEST(SiloOCCTest, ConcurrentIncrementsSerializable) {
+    SiloOCCManager manager(1);
+    const int threads = 4, perThread = 500;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < perThread; ++i) {
+                while (true) {
+                    int tx = manager.beginTrans();
+                    manager.write(tx, 0, manager.read(tx, 0) + 1);
+                    if (manager.commit(tx)) break;
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    int tx = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx, 0), threads * perThread);
+}
+
+// ✅ Test: A finished handle is rejected and does not leak into the slot's next owner
+TEST(SiloOCCTest, StaleHandleRejected) {
+    SiloOCCManager manager(8, 1);
+    int a = manager.beginTrans();
+    manager.write(a, 0, 1);
+    ASSERT_TRUE(manager.commit(a));
+
+    manager.write(a, 5, 666);
+    ASSERT_EQ(manager.read(a, 0), -1);
+    ASSERT_FALSE(manager.commit(a));
+    manager.abort(a);
+
+    int b = manager.beginTrans();   // Reuses the only context
+    ASSERT_NE(b, a);
+    ASSERT_EQ(manager.read(b, 0), 1);
+    ASSERT_FALSE(manager.commit(a));
+    ASSERT_TRUE(manager.commit(b));
+
+    int c = manager.beginTrans();
+    ASSERT_EQ(manager.read(c, 5), 0);
+    ASSERT_TRUE(manager.commit(c));
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+// Silo-style optimistic concurrency control (Tu et al., SOSP'13).
+// Every record carries a TID word; reads are lock-free and validated at
+// commit, writers lock only their own write set while installing.
+
+// TID word layout: bit 63 = lock bit, bits 32..62 = epoch, bits 0..31 = sequence
+constexpr uint64_t TID_LOCK_BIT = 1ull << 63;
+constexpr int TID_EPOCH_SHIFT = 32;
+constexpr int EPOCH_PERIOD_MS = 40;
+
+struct Record {
+    std::atomic<uint64_t> tid{ 0 };
+    std::atomic<int> value{ 0 };
+};
+
+struct ReadEntry {
+    int index;
+    uint64_t tid;       // TID observed when the value was read
+};
+
+struct WriteEntry {
+    int index;
+    int value;
+};
+
+// Per-transaction context. txID % poolSize selects the slot, the quotient
+// is a generation that changes whenever the slot is reused.
+struct alignas(64) OCCTransaction {
+    std::atomic<bool> inUse{ false };
+    int txID = 0;
+    std::vector<ReadEntry> readSet;
+    std::vector<WriteEntry> writeSet;
+};
+
+class SiloOCCManager {
+private:
+    std::vector<Record> records;
+    std::vector<OCCTransaction> txPool;
+    int poolSize;
+
+    // Global epoch, advanced periodically by a background thread
+    std::atomic<uint64_t> globalEpoch{ 1 };
+    std::thread epochThread;
+    std::mutex epochMutex;
+    std::condition_variable epochCv;
+    bool stopping = false;
+
+    // Last TID this thread committed; new TIDs are larger, so per-thread
+    // TIDs are monotonic as Silo requires
+    static uint64_t& lastTid() {
+        static thread_local uint64_t tid = 0;
+        return tid;
+    }
+
+    // nullptr once txID has committed or aborted, so a stale handle never
+    // reaches the slot's next owner
+    OCCTransaction* lookup(int txID) {
+        OCCTransaction* txn = &txPool[txID % poolSize];
+        return txn->inUse.load(std::memory_order_acquire) && txn->txID == txID ? txn : nullptr;
+    }
+
+    // The slot moves to its next generation before it can be claimed again
+    void release(OCCTransaction* txn) {
+        txn->readSet.clear();
+        txn->writeSet.clear();
+        txn->txID += poolSize;
+        txn->inUse.store(false, std::memory_order_release);
+    }
+
+    void lockRecord(Record& r) {
+        uint64_t cur = r.tid.load(std::memory_order_relaxed);
+        while (true) {
+            if (!(cur & TID_LOCK_BIT) &&
+                r.tid.compare_exchange_weak(cur, cur | TID_LOCK_BIT, std::memory_order_acquire)) {
+                return;
+            }
+            std::this_thread::yield();
+            cur = r.tid.load(std::memory_order_relaxed);
+        }
+    }
+
+    void unlockRecord(Record& r) {
+        r.tid.fetch_and(~TID_LOCK_BIT, std::memory_order_release);
+    }
+
+    bool inWriteSet(const OCCTransaction* txn, int index) const {
+        return std::binary_search(txn->writeSet.begin(), txn->writeSet.end(), WriteEntry{ index, 0 },
+            [](const WriteEntry& a, const WriteEntry& b) { return a.index < b.index; });
+    }
+
+public:
+    SiloOCCManager(int m, int maxActiveTx = 1024)
+        : records(m), txPool(maxActiveTx), poolSize(maxActiveTx) {
+        for (int slot = 0; slot < poolSize; ++slot) {
+            txPool[slot].txID = slot + poolSize; // generation 0 is never handed out
+        }
+        epochThread = std::thread([this] {
+            std::unique_lock<std::mutex> lk(epochMutex);
+            while (!epochCv.wait_for(lk, std::chrono::milliseconds(EPOCH_PERIOD_MS), [this] { return stopping; })) {
+                globalEpoch.fetch_add(1, std::memory_order_acq_rel);
+            }
+        });
+    }
+
+    static SiloOCCManager withContextPool(int m, int maxActiveTx) {
+        return SiloOCCManager(m, maxActiveTx);
+    }
+
+    int contextPoolSize() const {
+        return poolSize;
+    }
+
+    ~SiloOCCManager() {
+        {
+            std::lock_guard<std::mutex> lk(epochMutex);
+            stopping = true;
+        }
+        epochCv.notify_one();
+        epochThread.join();
+    }
+
+    int beginTrans() {
+        int txID;
+        while ((txID = tryBeginTrans()) < 0) {
+            std::this_thread::yield();
+        }
+        return txID;
+    }
+
+    // Non-blocking begin: -1 if every transaction context is in use
+    int tryBeginTrans() {
+        // Claim a free context, starting from where this thread last found one
+        static thread_local int cursor = 0;
+        for (int i = 0; i < poolSize; ++i) {
+            int slot = (cursor + i) % poolSize;
+            bool expected = false;
+            if (txPool[slot].inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                cursor = slot;
+                txPool[slot].readSet.clear();
+                txPool[slot].writeSet.clear();
+                return txPool[slot].txID;
+            }
+        }
+        return -1;
+    }
+
+    int read(int txID, int index) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return -1;
+        }
+
+        // Read your own writes
+        for (auto it = txn->writeSet.rbegin(); it != txn->writeSet.rend(); ++it) {
+            if (it->index == index) {
+                return it->value;
+            }
+        }
+
+        // Stable read: TID unchanged and unlocked around the value load
+        Record& r = records[index];
+        uint64_t before, after;
+        int value;
+        while (true) {
+            before = r.tid.load(std::memory_order_acquire);
+            if (before & TID_LOCK_BIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            value = r.value.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = r.tid.load(std::memory_order_relaxed);
+            if (before == after) {
+                break;
+            }
+        }
+
+        txn->readSet.push_back({ index, before });
+        return value;
+    }
+
+    void write(int txID, int index, int val) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return;
+        }
+        for (auto& w : txn->writeSet) {
+            if (w.index == index) {
+                w.value = val;
+                return;
+            }
+        }
+        txn->writeSet.push_back({ index, val });
+    }
+
+    bool commit(int txID) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return false;
+        }
+
+        // Phase 1: lock the write set in a global (key) order to avoid deadlock
+        std::sort(txn->writeSet.begin(), txn->writeSet.end(),
+            [](const WriteEntry& a, const WriteEntry& b) { return a.index < b.index; });
+        for (const auto& w : txn->writeSet) {
+            lockRecord(records[w.index]);
+        }
+
+        // Order the lock bits before any value store in phase 3, and serve as
+        // the serialization point: the epoch read here bounds the commit TID
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t epoch = globalEpoch.load(std::memory_order_acquire);
+
+        // Phase 2: validate that nothing we read has changed or is being written
+        uint64_t maxSeen = lastTid();
+        bool valid = true;
+        for (const auto& rd : txn->readSet) {
+            uint64_t cur = records[rd.index].tid.load(std::memory_order_acquire);
+            if ((cur & ~TID_LOCK_BIT) != rd.tid ||
+                ((cur & TID_LOCK_BIT) && !inWriteSet(txn, rd.index))) {
+                valid = false;
+                break;
+            }
+            maxSeen = std::max(maxSeen, rd.tid);
+        }
+
+        if (!valid) {
+            for (const auto& w : txn->writeSet) {
+                unlockRecord(records[w.index]);
+            }
+            release(txn);
+            return false;
+        }
+
+        // Phase 3: pick a TID larger than every TID read or overwritten and
+        // in the current epoch, then install values and release the locks
+        for (const auto& w : txn->writeSet) {
+            maxSeen = std::max(maxSeen, records[w.index].tid.load(std::memory_order_relaxed) & ~TID_LOCK_BIT);
+        }
+        uint64_t commitTid = std::max(maxSeen + 1, epoch << TID_EPOCH_SHIFT);
+        lastTid() = commitTid;
+
+        for (const auto& w : txn->writeSet) {
+            Record& r = records[w.index];
+            r.value.store(w.value, std::memory_order_relaxed);
+            r.tid.store(commitTid, std::memory_order_release); // also clears the lock bit
+        }
+
+        release(txn);
+        return true;
+    }
+
+    void abort(int txID) {
+        auto* txn = lookup(txID);
+        if (txn) {
+            release(txn);
+        }
+    }
+};
@@ -0,0 +1,6 @@
+#include "OCC.h"
+#include "../common/driver.h"
+
+int main(int argc, char** argv) {
+    return runDriver<SiloOCCManager>(argc, argv, "OCC");
+}
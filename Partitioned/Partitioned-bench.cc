@@ -0,0 +1,6 @@
+#include "Partitioned.h"
+#include "../common/microbench.h"
+
+ENGINE_BENCHMARKS(PartitionedManager);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "Partitioned.h"
+
+// ✅ Test: Keys are split into contiguous ranges covering 0..m-1
+TEST(PartitionedTest, RangePartitioning) {
+    PartitionedManager manager(10, 3);
+    ASSERT_EQ(manager.partitionCount(), 3);
+    for (int p = 0; p < 3; ++p) {
+        for (int k = manager.firstKey(p); k < manager.firstKey(p + 1); ++k) {
+            ASSERT_EQ(manager.partitionOf(k), p);
+        }
+    }
+    ASSERT_EQ(manager.firstKey(3), 10);
+}
+
+// ✅ Test: Single-partition transaction commits and is visible afterwards
+TEST(PartitionedTest, SinglePartitionCommit) {
+    PartitionedManager manager(4, 2);
+    int tx = manager.beginTrans();
+    manager.write(tx, 0, manager.read(tx, 0) + 5);
+    ASSERT_EQ(manager.read(tx, 0), 5);
+    ASSERT_TRUE(manager.commit(tx));
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 5);
+    ASSERT_TRUE(manager.commit(check));
+}
+
+// ✅ Test: Multi-partition transaction commits atomically via two-phase commit
+TEST(PartitionedTest, MultiPartitionCommit) {
+    PartitionedManager manager(4, 2);
+    int tx = manager.beginTrans();
+    manager.write(tx, 0, 1);
+    manager.write(tx, 3, 2);
+    ASSERT_TRUE(manager.commit(tx));
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 1);
+    ASSERT_EQ(manager.read(check, 3), 2);
+    ASSERT_TRUE(manager.commit(check));
+}
+
+// ✅ Test: Stale read in a multi-partition transaction aborts it
+TEST(PartitionedTest, StaleReadAborts) {
+    PartitionedManager manager(4, 2);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.read(tx1, 0);
+    manager.write(tx1, 3, 9);
+
+    manager.write(tx2, 0, 7);
+    ASSERT_TRUE(manager.commit(tx2));
+    ASSERT_FALSE(manager.commit(tx1));
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 3), 0); // tx1 left nothing behind
+    ASSERT_TRUE(manager.commit(check));
+}
+
+// ✅ Test: Write skew across partitions is rejected
+TEST(PartitionedTest, WriteSkewAborted) {
+    PartitionedManager manager(4, 2);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    if (manager.read(tx1, 0) == 0 && manager.read(tx1, 3) == 0) manager.write(tx1, 0, 1);
+    if (manager.read(tx2, 0) == 0 && manager.read(tx2, 3) == 0) manager.write(tx2, 3, 1);
+
+    bool c1 = manager.commit(tx1);
+    bool c2 = manager.commit(tx2);
+    EXPECT_FALSE(c1 && c2);
+}
+
+// Drives one executor step at a time, so tests can choose how the
+// prepares of concurrent transactions interleave
+struct PartitionedTestAccess {
+    static bool step(PartitionedManager& manager, int txID, int p, PartitionOp op) {
+        Mailbox mb;
+        mb.op = op;
+        mb.txn = manager.lookup(txID);
+        manager.handle(manager.partitions[p], p, mb);
+        return mb.ok;
+    }
+};
+
+// ✅ Test: Interleaved prepares cannot both commit a cross-partition write skew
+TEST(PartitionedTest, InterleavedPreparesRejectWriteSkew) {
+    PartitionedManager manager(4, 2);
+    const int A = 0, B = 1, x = 0, y = 3;
+    int t = manager.beginTrans();
+    int u = manager.beginTrans();
+    ASSERT_EQ(manager.read(t, x) + manager.read(t, y), 0);
+    ASSERT_EQ(manager.read(u, x) + manager.read(u, y), 0);
+    manager.write(t, x, 1);
+    manager.write(u, y, 1);
+
+    bool tB = PartitionedTestAccess::step(manager, t, B, PART_PREPARE);
+    bool uA = PartitionedTestAccess::step(manager, u, A, PART_PREPARE);
+    bool tA = PartitionedTestAccess::step(manager, t, A, PART_PREPARE);
+    bool uB = PartitionedTestAccess::step(manager, u, B, PART_PREPARE);
+    ASSERT_FALSE(tB && uA && tA && uB);
+
+    // Finish both as the coordinator would
+    bool tOk = tA && tB, uOk = uA && uB;
+    for (int p : { A, B }) {
+        if ((p == A ? tA : tB)) PartitionedTestAccess::step(manager, t, p, tOk ? PART_COMMIT : PART_ABORT);
+        if ((p == A ? uA : uB)) PartitionedTestAccess::step(manager, u, p, uOk ? PART_COMMIT : PART_ABORT);
+    }
+    manager.abort(t);
+    manager.abort(u);
+
+    int check = manager.beginTrans();
+    ASSERT_FALSE(manager.read(check, x) == 1 && manager.read(check, y) == 1);
+    manager.write(check, x, 2);
+    manager.write(check, y, 2);
+    ASSERT_TRUE(manager.commit(check)); // No lock or pin left behind
+}
+
+// ✅ Test: Concurrent cross-partition transfers preserve the total
+TEST(PartitionedTest, ConcurrentTransfersConserveTotal) {
+    const int m = 8;
+    PartitionedManager manager(m, 2);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i) {
+                int from = (t + i) % m, to = (t * 3 + i + 1) % m;
+                if (from == to) continue;
+                while (true) {
+                    int tx = manager.beginTrans();
+                    manager.write(tx, from, manager.read(tx, from) - 1);
+                    manager.write(tx, to, manager.read(tx, to) + 1);
+                    if (manager.commit(tx)) break;
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    int tx = manager.beginTrans();
+    int total = 0;
+    for (int k = 0; k < m; ++k) total += manager.read(tx, k);
+    ASSERT_EQ(total, 0);
+    ASSERT_TRUE(manager.commit(tx));
+}
+
+// ✅ Test: A finished handle is rejected and does not leak into the slot's next owner
+TEST(PartitionedTest, StaleHandleRejected) {
+    PartitionedManager manager(8, 2, 1);
+    int a = manager.beginTrans();
+    manager.write(a, 0, 1);
+    ASSERT_TRUE(manager.commit(a));
+
+    manager.write(a, 5, 666);
+    ASSERT_EQ(manager.read(a, 0), -1);
+    ASSERT_FALSE(manager.commit(a));
+    manager.abort(a);
+
+    int b = manager.beginTrans();   // Reuses the only context
+    ASSERT_NE(b, a);
+    ASSERT_EQ(manager.read(b, 0), 1);
+    ASSERT_FALSE(manager.commit(a));
+    ASSERT_TRUE(manager.commit(b));
+
+    int c = manager.beginTrans();
+    ASSERT_EQ(manager.read(c, 5), 0);
+    ASSERT_TRUE(manager.commit(c));
+}
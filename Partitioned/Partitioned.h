@@ -0,0 +1,394 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+// Shared-nothing execution (H-Store style). Keys 0..m-1 are split into
+// contiguous ranges, one per executor thread, and only that executor ever
+// touches its slice: no locks or atomics on the data itself.
+//
+// Clients talk to executors through single-producer/single-consumer
+// mailboxes, one per (transaction context, executor) pair. Reads are
+// served by the owner; writes are buffered at the client. A transaction
+// that touched one partition commits with a single validate-and-install
+// message; one that touched several runs two-phase commit with the client
+// as coordinator (prepare validates, locks the writes and pins the reads,
+// then commit or abort). A pinned read blocks writers of that key until
+// its transaction finishes, so two prepared transactions cannot both
+// overwrite what the other read.
+
+enum PartitionOp {
+    PART_READ,
+    PART_COMMIT_LOCAL,  // single-partition: validate and install in one step
+    PART_PREPARE,       // multi-partition phase 1: validate, lock writes, pin reads
+    PART_COMMIT,        // multi-partition phase 2: install, unlock and unpin
+    PART_ABORT          // multi-partition phase 2: unlock and unpin
+};
+
+enum MailState {
+    MAIL_EMPTY,
+    MAIL_REQUEST,
+    MAIL_RESPONSE
+};
+
+struct PartitionedTransaction;
+
+// One-slot SPSC channel: the client fills a request, the executor answers it
+struct alignas(64) Mailbox {
+    std::atomic<int> state{ MAIL_EMPTY };
+    PartitionOp op;
+    int key;
+    const PartitionedTransaction* txn;
+    int value;
+    int version;
+    bool ok;
+};
+
+struct PartitionReadEntry {
+    int key;
+    int version;
+};
+
+struct PartitionWriteEntry {
+    int key;
+    int value;
+};
+
+struct alignas(64) PartitionedTransaction {
+    std::atomic<bool> inUse{ false };
+    int txID = 0;
+    std::vector<PartitionReadEntry> readSet;
+    std::vector<PartitionWriteEntry> writeSet;
+    std::vector<int> partitions;    // Partitions touched so far
+};
+
+// State owned by exactly one executor thread
+struct Partition {
+    int base;
+    std::vector<int> values;
+    std::vector<int> versions;
+    std::vector<int> lockOwner;     // txID holding a prepared write, 0 if none
+    std::vector<int> readPins;      // Reads of prepared transactions not yet finished
+};
+
+class PartitionedManager {
+private:
+    friend struct PartitionedTestAccess;
+
+    int numDataItems;
+    int numPartitions;
+    int poolSize;
+    std::vector<Partition> partitions;
+    std::vector<PartitionedTransaction> txPool;
+    std::vector<Mailbox> mailboxes;          // mailboxes[slot * numPartitions + partition]
+    std::atomic<int> highWater{ 0 };         // Executors scan slots below this
+    std::atomic<bool> stopping{ false };
+    std::vector<std::thread> executors;
+
+    Mailbox& mailbox(int slot, int p) {
+        return mailboxes[slot * numPartitions + p];
+    }
+
+    // nullptr once txID has committed or aborted, so a stale handle never
+    // reaches the slot's next owner
+    PartitionedTransaction* lookup(int txID) {
+        PartitionedTransaction* txn = &txPool[txID % poolSize];
+        return txn->inUse.load(std::memory_order_acquire) && txn->txID == txID ? txn : nullptr;
+    }
+
+    // The slot moves to its next generation before it can be claimed again
+    void release(PartitionedTransaction* txn) {
+        txn->readSet.clear();
+        txn->writeSet.clear();
+        txn->partitions.clear();
+        txn->txID += poolSize;
+        txn->inUse.store(false, std::memory_order_release);
+    }
+
+    void touch(PartitionedTransaction* txn, int p) {
+        if (std::find(txn->partitions.begin(), txn->partitions.end(), p) == txn->partitions.end()) {
+            txn->partitions.push_back(p);
+        }
+    }
+
+    // ---------------- client side ---------------- //
+
+    void post(int slot, int p, PartitionOp op, int key, const PartitionedTransaction* txn) {
+        Mailbox& mb = mailbox(slot, p);
+        mb.op = op;
+        mb.key = key;
+        mb.txn = txn;
+        mb.state.store(MAIL_REQUEST, std::memory_order_release);
+    }
+
+    Mailbox& await(int slot, int p) {
+        Mailbox& mb = mailbox(slot, p);
+        for (int spins = 0; mb.state.load(std::memory_order_acquire) != MAIL_RESPONSE; ++spins) {
+            if (spins > 64) {
+                std::this_thread::yield();
+            }
+        }
+        mb.state.store(MAIL_EMPTY, std::memory_order_relaxed);
+        return mb;
+    }
+
+    // ---------------- executor side ---------------- //
+
+    bool validate(Partition& part, int p, const PartitionedTransaction* txn) {
+        for (const auto& rd : txn->readSet) {
+            if (partitionOf(rd.key) != p) continue;
+            int local = rd.key - part.base;
+            if (part.versions[local] != rd.version ||
+                (part.lockOwner[local] != 0 && part.lockOwner[local] != txn->txID)) {
+                return false;
+            }
+        }
+        for (const auto& w : txn->writeSet) {
+            if (partitionOf(w.key) != p) continue;
+            int local = w.key - part.base;
+            int owner = part.lockOwner[local];
+            if ((owner != 0 && owner != txn->txID) || part.readPins[local] > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void install(Partition& part, int p, const PartitionedTransaction* txn) {
+        for (const auto& w : txn->writeSet) {
+            if (partitionOf(w.key) != p) continue;
+            int local = w.key - part.base;
+            part.values[local] = w.value;
+            ++part.versions[local];
+            part.lockOwner[local] = 0;
+        }
+    }
+
+    // Lock the writes of txn for owner and pin its reads, or with owner 0
+    // release both
+    void setLocks(Partition& part, int p, const PartitionedTransaction* txn, int owner) {
+        for (const auto& w : txn->writeSet) {
+            if (partitionOf(w.key) != p) continue;
+            int& lock = part.lockOwner[w.key - part.base];
+            if (lock == 0 || lock == txn->txID) {
+                lock = owner;
+            }
+        }
+        for (const auto& rd : txn->readSet) {
+            if (partitionOf(rd.key) != p) continue;
+            part.readPins[rd.key - part.base] += owner != 0 ? 1 : -1;
+        }
+    }
+
+    void handle(Partition& part, int p, Mailbox& mb) {
+        switch (mb.op) {
+        case PART_READ:
+            mb.value = part.values[mb.key - part.base];
+            mb.version = part.versions[mb.key - part.base];
+            break;
+        case PART_COMMIT_LOCAL:
+            mb.ok = validate(part, p, mb.txn);
+            if (mb.ok) {
+                install(part, p, mb.txn);
+            }
+            break;
+        case PART_PREPARE:
+            mb.ok = validate(part, p, mb.txn);
+            if (mb.ok) {
+                setLocks(part, p, mb.txn, mb.txn->txID);
+            }
+            break;
+        case PART_COMMIT:
+            install(part, p, mb.txn);
+            setLocks(part, p, mb.txn, 0);
+            break;
+        case PART_ABORT:
+            setLocks(part, p, mb.txn, 0);
+            break;
+        }
+    }
+
+    void executorLoop(int p) {
+        Partition& part = partitions[p];
+        while (!stopping.load(std::memory_order_acquire)) {
+            bool worked = false;
+            int limit = highWater.load(std::memory_order_acquire);
+            for (int slot = 0; slot < limit; ++slot) {
+                Mailbox& mb = mailbox(slot, p);
+                if (mb.state.load(std::memory_order_acquire) == MAIL_REQUEST) {
+                    handle(part, p, mb);
+                    mb.state.store(MAIL_RESPONSE, std::memory_order_release);
+                    worked = true;
+                }
+            }
+            if (!worked) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    static int defaultExecutorCount() {
+        return (int)std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+
+    PartitionedManager(int m, int executorCount = defaultExecutorCount(), int maxActiveTx = 256)
+        : numDataItems(m), numPartitions(std::max(1, std::min(executorCount, m))), poolSize(maxActiveTx),
+          partitions(numPartitions), txPool(maxActiveTx), mailboxes((size_t)maxActiveTx * numPartitions) {
+        for (int p = 0; p < numPartitions; ++p) {
+            int first = firstKey(p), last = firstKey(p + 1);
+            partitions[p].base = first;
+            partitions[p].values.assign(last - first, 0);
+            partitions[p].versions.assign(last - first, 0);
+            partitions[p].lockOwner.assign(last - first, 0);
+            partitions[p].readPins.assign(last - first, 0);
+        }
+        for (int slot = 0; slot < poolSize; ++slot) {
+            txPool[slot].txID = slot + poolSize; // generation 0 is never handed out
+        }
+        for (int p = 0; p < numPartitions; ++p) {
+            executors.emplace_back(&PartitionedManager::executorLoop, this, p);
+        }
+    }
+
+    static PartitionedManager withContextPool(int m, int maxActiveTx) {
+        return PartitionedManager(m, defaultExecutorCount(), maxActiveTx);
+    }
+
+    int contextPoolSize() const {
+        return poolSize;
+    }
+
+    ~PartitionedManager() {
+        stopping.store(true, std::memory_order_release);
+        for (auto& t : executors) {
+            t.join();
+        }
+    }
+
+    // Contiguous range partitioning: partition p owns [firstKey(p), firstKey(p + 1))
+    int firstKey(int p) const {
+        return (int)(((long long)p * numDataItems + numPartitions - 1) / numPartitions);
+    }
+
+    int partitionOf(int index) const {
+        return (int)((long long)index * numPartitions / numDataItems);
+    }
+
+    int partitionCount() const {
+        return numPartitions;
+    }
+
+    int beginTrans() {
+        int txID;
+        while ((txID = tryBeginTrans()) < 0) {
+            std::this_thread::yield();
+        }
+        return txID;
+    }
+
+    // Non-blocking begin: -1 if every transaction context is in use
+    int tryBeginTrans() {
+        static thread_local int cursor = 0;
+        for (int i = 0; i < poolSize; ++i) {
+            int slot = (cursor + i) % poolSize;
+            bool expected = false;
+            if (txPool[slot].inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                cursor = slot;
+                int hw = highWater.load(std::memory_order_relaxed);
+                while (hw <= slot && !highWater.compare_exchange_weak(hw, slot + 1, std::memory_order_acq_rel)) {
+                }
+                txPool[slot].readSet.clear();
+                txPool[slot].writeSet.clear();
+                txPool[slot].partitions.clear();
+                return txPool[slot].txID;
+            }
+        }
+        return -1;
+    }
+
+    int read(int txID, int index) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return -1;
+        }
+        for (const auto& w : txn->writeSet) {
+            if (w.key == index) {
+                return w.value;
+            }
+        }
+
+        int slot = txID % poolSize;
+        int p = partitionOf(index);
+        touch(txn, p);
+        post(slot, p, PART_READ, index, txn);
+        Mailbox& mb = await(slot, p);
+        txn->readSet.push_back({ index, mb.version });
+        return mb.value;
+    }
+
+    void write(int txID, int index, int val) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return;
+        }
+        touch(txn, partitionOf(index));
+        for (auto& w : txn->writeSet) {
+            if (w.key == index) {
+                w.value = val;
+                return;
+            }
+        }
+        txn->writeSet.push_back({ index, val });
+    }
+
+    bool commit(int txID) {
+        auto* txn = lookup(txID);
+        if (!txn) {
+            return false;
+        }
+        int slot = txID % poolSize;
+        bool ok = true;
+
+        if (txn->partitions.size() == 1) {
+            // Fast path: the owner validates and installs serially, no locks
+            int p = txn->partitions[0];
+            post(slot, p, PART_COMMIT_LOCAL, 0, txn);
+            ok = await(slot, p).ok;
+        }
+        else if (txn->partitions.size() > 1) {
+            // Two-phase commit across the touched partitions
+            for (int p : txn->partitions) {
+                post(slot, p, PART_PREPARE, 0, txn);
+            }
+            std::vector<int> prepared;
+            for (int p : txn->partitions) {
+                if (await(slot, p).ok) {
+                    prepared.push_back(p);
+                }
+                else {
+                    ok = false;
+                }
+            }
+            const auto& decided = ok ? txn->partitions : prepared;
+            for (int p : decided) {
+                post(slot, p, ok ? PART_COMMIT : PART_ABORT, 0, txn);
+            }
+            for (int p : decided) {
+                await(slot, p);
+            }
+        }
+
+        release(txn);
+        return ok;
+    }
+
+    void abort(int txID) {
+        auto* txn = lookup(txID);
+        if (txn) {
+            release(txn);
+        }
+    }
+};
@@ -0,0 +1,6 @@
+#include "Partitioned.h"
+#include "../common/driver.h"
+
+int main(int argc, char** argv) {
+    return runDriver<PartitionedManager>(argc, argv, "Partitioned");
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "../SI-SSN/SI-SSN.h"
+#include "Replica.h"
+#include "../Server/Server.h"
+#include "../Server/Client.h"
+
+using namespace std::chrono_literals;
+
+// ✅ Test: Committed writes reach the replica with their history
+TEST(ReplicaTest, CommitsReplicateInOrder) {
+    SnapshotIsolationManager primary(10);
+    CommitLog log;
+    primary.attachCommitLog(&log);
+    LogShipper<SnapshotIsolationManager> shipper(primary, log);
+    ReplicaStore replica(10, "127.0.0.1", shipper.start());
+
+    std::vector<int> stamps;
+    for (int v = 1; v <= 5; ++v) {
+        int tx = primary.beginTrans();
+        primary.write(tx, 0, v * 10);
+        primary.write(tx, v, v);
+        ASSERT_TRUE(primary.commit(tx));
+        stamps.push_back(primary.currentTimestamp());
+    }
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+    ASSERT_EQ(replica.recordsApplied(), 5);
+
+    int tx = replica.beginTrans();
+    ASSERT_EQ(replica.read(tx, 0), 50);
+    ASSERT_EQ(replica.read(tx, 3), 3);
+    ASSERT_TRUE(replica.commit(tx));
+    for (int ts : stamps) {
+        ASSERT_EQ(replica.readAsOf(0, ts), primary.readAsOf(0, ts));
+    }
+}
+
+// ✅ Test: Finishing a replica handle twice does not return its context twice
+TEST(ReplicaTest, FinishedHandleReleasedOnce) {
+    SnapshotIsolationManager primary(4);
+    CommitLog log;
+    primary.attachCommitLog(&log);
+    LogShipper<SnapshotIsolationManager> shipper(primary, log);
+    ReplicaStore replica(4, "127.0.0.1", shipper.start(), 2);
+
+    int a = replica.beginTrans();
+    ASSERT_TRUE(replica.commit(a));
+    replica.abort(a);
+    ASSERT_FALSE(replica.commit(a));
+    ASSERT_TRUE(replica.isAborted(a));
+    ASSERT_EQ(replica.read(a, 0), -1);
+
+    int b = replica.beginTrans();
+    int c = replica.beginTrans();
+    ASSERT_NE(b % 2, c % 2);
+    ASSERT_EQ(replica.tryBeginTrans(), -1);
+    ASSERT_TRUE(replica.commit(b));
+    ASSERT_TRUE(replica.commit(c));
+}
+
+// ✅ Test: Replica snapshots never see a transaction half applied
+TEST(ReplicaTest, SnapshotReadsAreConsistent) {
+    SnapshotIsolationManager primary(2);
+    CommitLog log;
+    primary.attachCommitLog(&log);
+    int init = primary.beginTrans();
+    primary.write(init, 0, 100);
+    ASSERT_TRUE(primary.commit(init));
+    LogShipper<SnapshotIsolationManager> shipper(primary, log);
+    ReplicaStore replica(2, "127.0.0.1", shipper.start());
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+
+    std::atomic<bool> done{ false };
+    std::thread writer([&] {
+        for (int i = 0; i < 2000; ++i) {
+            int tx = primary.beginTrans();
+            int a = primary.read(tx, 0);
+            int b = primary.read(tx, 1);
+            primary.write(tx, 0, a - 1 + (i % 3));
+            primary.write(tx, 1, b + 1 - (i % 3));
+            primary.commit(tx);
+        }
+        done = true;
+    });
+    long long checked = 0;
+    while (!done || checked == 0) {
+        int tx = replica.beginTrans();
+        ASSERT_EQ(replica.read(tx, 0) + replica.read(tx, 1), 100);
+        ASSERT_TRUE(replica.commit(tx));
+        ++checked;
+    }
+    writer.join();
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+}
+
+// ✅ Test: A replica started late catches up from the retained log, and its lag drains
+TEST(ReplicaTest, LateReplicaCatchesUpAndLagDrains) {
+    SnapshotIsolationManager primary(100);
+    CommitLog log;
+    primary.attachCommitLog(&log);
+    LogShipper<SnapshotIsolationManager> shipper(primary, log);
+    int port = shipper.start();
+    for (int i = 0; i < 100; ++i) {
+        int tx = primary.beginTrans();
+        primary.write(tx, i, i + 1);
+        ASSERT_TRUE(primary.commit(tx));
+    }
+
+    ReplicaStore replica(100, "127.0.0.1", port);
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(replica.readAsOf(i, replica.currentTimestamp()), i + 1);
+    }
+
+    // Read-only traffic on the primary moves its timestamp; heartbeats keep up
+    int reader = primary.beginTrans();
+    primary.commit(reader);
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (replica.lagTimestamps() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_EQ(replica.lagTimestamps(), 0);
+    ASSERT_GE(replica.lagMicros(), 0);
+    ASSERT_LT(replica.lagMicros(), 1000000);
+}
+
+// ✅ Test: A replica whose stream breaks resumes where it stopped, without duplicates
+TEST(ReplicaTest, ResumesAfterShipperRestart) {
+    SnapshotIsolationManager primary(10);
+    CommitLog log;
+    primary.attachCommitLog(&log);
+    auto shipper = std::make_unique<LogShipper<SnapshotIsolationManager>>(primary, log);
+    int port = shipper->start();
+    ReplicaStore replica(10, "127.0.0.1", port);
+
+    auto commitValue = [&](int v) {
+        int tx = primary.beginTrans();
+        primary.write(tx, v % 10, v);
+        ASSERT_TRUE(primary.commit(tx));
+    };
+    for (int v = 0; v < 5; ++v) {
+        commitValue(v);
+    }
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+
+    shipper.reset();
+    for (int v = 5; v < 10; ++v) {
+        commitValue(v);
+    }
+    shipper = std::make_unique<LogShipper<SnapshotIsolationManager>>(primary, log, "127.0.0.1", port);
+    shipper->start();
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+    ASSERT_EQ(replica.recordsApplied(), 10);
+    for (int v = 0; v < 10; ++v) {
+        ASSERT_EQ(replica.readAsOf(v, replica.currentTimestamp()), v);
+    }
+}
+
+// ✅ Test: Replicas refuse writes and serve reads through the transaction server
+TEST(ReplicaTest, ServesReadOnlyTransactionsOverTheNetwork) {
+    SnapshotIsolationManager primary(10);
+    CommitLog log;
+    primary.attachCommitLog(&log);
+    LogShipper<SnapshotIsolationManager> shipper(primary, log);
+    ReplicaStore replica(10, "127.0.0.1", shipper.start());
+
+    int tx = primary.beginTrans();
+    primary.write(tx, 4, 44);
+    ASSERT_TRUE(primary.commit(tx));
+    ASSERT_TRUE(replica.waitFor(primary.currentTimestamp(), 5s));
+
+    TxServer<ReplicaStore> server(replica, 10, "127.0.0.1", 0, 1);
+    TxClient client("127.0.0.1", server.start());
+    auto read = client.call({ { OP_BEGIN, 0, 0, 0 }, { OP_READ, TX_OF_BATCH, 4, 0 }, { OP_COMMIT, TX_OF_BATCH, 0, 0 } });
+    ASSERT_EQ(read[1].value, 44);
+    ASSERT_EQ(read[2].status, ST_OK);
+
+    auto write = client.call({ { OP_BEGIN, 0, 0, 0 }, { OP_WRITE, TX_OF_BATCH, 4, 1 }, { OP_COMMIT, TX_OF_BATCH, 0, 0 } });
+    ASSERT_EQ(write[1].status, ST_ABORTED);
+    ASSERT_EQ(write[2].status, ST_ABORTED);
+    ASSERT_EQ(replica.readAsOf(4, replica.currentTimestamp()), 44);
+}
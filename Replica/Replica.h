@@ -0,0 +1,497 @@
+#pragma once
+
+// Log-shipping read replicas. A primary engine with a CommitLog attached
+// streams its committed write sets, in commit-timestamp order, to followers
+// through a LogShipper. A ReplicaStore follows one primary, applies the
+// stream to its own version store and serves read-only snapshot
+// transactions as of the newest timestamp it has fully applied, so read
+// traffic can move off the primary's cores.
+//
+// Stream, primary to follower, after the follower sends the i32 timestamp
+// it has applied up to:
+//
+//   batch  := u32 length | i32 primaryTs | i64 sentMicros | u32 count | record[count]
+//   record := i32 ts | i64 committedMicros | u32 writes | (i32 index | i32 value)[writes]
+//
+// length counts the bytes after itself. A batch without records is a
+// heartbeat: every commit up to primaryTs has already been shipped. Times
+// are monotonicMicros(), so lag is measurable between processes on a host.
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/commitlog.h"
+#include "../common/traits.h"
+#include "../Server/Protocol.h"
+
+constexpr std::chrono::milliseconds SHIP_HEARTBEAT{ 10 };   // Longest silence towards a follower
+constexpr size_t SHIP_MAX_RECORDS = 4096;                   // Records per batch while catching up
+constexpr std::chrono::milliseconds REPLICA_RECONNECT{ 100 };
+constexpr size_t REPLICA_BATCH_HEADER = 20;
+constexpr size_t REPLICA_RECORD_HEADER = 16;
+
+inline bool sendFully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t w = send(fd, data, size, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) {
+            continue;
+        }
+        if (w <= 0) {
+            return false;
+        }
+        data += w;
+        size -= (size_t)w;
+    }
+    return true;
+}
+
+inline bool receiveFully(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t r = read(fd, data, size);
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        if (r <= 0) {
+            return false;
+        }
+        data += r;
+        size -= (size_t)r;
+    }
+    return true;
+}
+
+// ---------------- primary side ---------------- //
+
+template <class Manager>
+class LogShipper {
+    static_assert(HasCommitLog<Manager>::value, "the engine cannot feed a replication stream");
+
+    Manager& manager;
+    CommitLog& log;
+    std::string address;
+    int port;
+    int listenFd = -1;
+    std::atomic<bool> running{ false };
+    std::thread acceptor;
+    std::mutex followersMutex;
+    std::vector<std::thread> followers;
+    std::vector<int> followerFds;
+
+public:
+    // The manager must already have log attached. port 0 picks a free port;
+    // start() returns the one bound
+    LogShipper(Manager& manager, CommitLog& log, const std::string& address = "127.0.0.1", int port = 0)
+        : manager(manager), log(log), address(address), port(port) {}
+
+    ~LogShipper() {
+        stop();
+    }
+
+    LogShipper(const LogShipper&) = delete;
+    LogShipper& operator=(const LogShipper&) = delete;
+
+    int start() {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1 ||
+            bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+            close(listenFd);
+            throw std::runtime_error("cannot listen on " + address + ":" + std::to_string(port));
+        }
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd, (sockaddr*)&addr, &len);
+        port = ntohs(addr.sin_port);
+        running = true;
+        acceptor = std::thread(&LogShipper::acceptLoop, this);
+        return port;
+    }
+
+    void stop() {
+        if (!running.exchange(false)) {
+            return;
+        }
+        shutdown(listenFd, SHUT_RDWR);
+        acceptor.join();
+        close(listenFd);
+        {
+            std::lock_guard<std::mutex> lk(followersMutex);
+            for (int fd : followerFds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto& t : followers) {
+            t.join();
+        }
+        for (int fd : followerFds) {
+            close(fd);
+        }
+        followers.clear();
+        followerFds.clear();
+    }
+
+private:
+    void acceptLoop() {
+        while (running) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                return; // Listening socket shut down
+            }
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            std::lock_guard<std::mutex> lk(followersMutex);
+            followerFds.push_back(fd);
+            followers.emplace_back(&LogShipper::ship, this, fd);
+        }
+    }
+
+    // Stream one follower from the timestamp it asks for until it goes away
+    void ship(int fd) {
+        char hello[4];
+        if (!receiveFully(fd, hello, sizeof(hello))) {
+            return;
+        }
+        int lastTs = loadAt<int32_t>(hello);
+        size_t pos = log.positionAfter(lastTs);
+        std::vector<CommitRecord> batch;
+        std::vector<char> frame;
+        while (running) {
+            // Read before waiting: if the wait finds nothing new, every
+            // commit up to this timestamp has been shipped already
+            int watermark = manager.currentTimestamp();
+            pos = log.readFrom(pos, batch, SHIP_HEARTBEAT, SHIP_MAX_RECORDS);
+            if (!batch.empty()) {
+                lastTs = batch.back().ts;
+            }
+
+            size_t size = REPLICA_BATCH_HEADER;
+            for (const auto& r : batch) {
+                size += REPLICA_RECORD_HEADER + r.writes.size() * 8;
+            }
+            frame.resize(size);
+            char* p = frame.data();
+            storeAt<uint32_t>(p, (uint32_t)(size - 4));
+            storeAt<int32_t>(p + 4, std::max(watermark, lastTs));
+            storeAt<int64_t>(p + 8, monotonicMicros());
+            storeAt<uint32_t>(p + 16, (uint32_t)batch.size());
+            p += REPLICA_BATCH_HEADER;
+            for (const auto& r : batch) {
+                storeAt<int32_t>(p, r.ts);
+                storeAt<int64_t>(p + 4, r.committedMicros);
+                storeAt<uint32_t>(p + 12, (uint32_t)r.writes.size());
+                p += REPLICA_RECORD_HEADER;
+                for (const auto& [index, value] : r.writes) {
+                    storeAt<int32_t>(p, index);
+                    storeAt<int32_t>(p + 4, value);
+                    p += 8;
+                }
+            }
+            if (!sendFully(fd, frame.data(), frame.size())) {
+                return;
+            }
+        }
+    }
+};
+
+// ---------------- follower side ---------------- //
+
+// Read-only transaction context, pooled; txID % poolSize is the slot and
+// the quotient a generation, as in the engines
+struct ReplicaReadTxn {
+    int txID = 0;
+    bool inUse = false;
+    int snapshot = 0;
+    bool wrote = false; // A replica takes no writes; such a transaction cannot commit
+};
+
+class ReplicaStore {
+    int numDataItems;
+    int poolSize;
+    std::vector<std::vector<int>> commitStamps; // Per key, ascending, packed for binary search
+    std::vector<std::vector<int>> values;       // values[index][i] committed at commitStamps[index][i]
+    std::shared_mutex storeMutex;               // Shared by readers, exclusive while applying a batch
+
+    std::atomic<int> appliedTS{ 0 };            // Every commit up to it is applied
+    std::atomic<int> primaryTS{ 0 };            // Newest timestamp the primary has reported
+    std::atomic<long long> freshMicros{ 0 };    // Primary time at which it was in the applied state
+    std::atomic<long long> appliedRecords{ 0 };
+    std::mutex appliedMutex;
+    std::condition_variable applied;
+
+    std::mutex poolMutex;
+    std::vector<ReplicaReadTxn> txPool;
+    std::vector<int> freeSlots;
+
+    std::string host;
+    int port;
+    std::atomic<bool> running{ true };
+    std::atomic<bool> connected{ false };
+    std::mutex fdMutex;
+    int fd = -1;
+    std::thread applier;
+
+    // nullptr once txID has committed or aborted, whether or not its slot
+    // has been claimed again
+    ReplicaReadTxn* lookup(int txID) {
+        ReplicaReadTxn* txn = &txPool[txID % poolSize];
+        return txn->inUse && txn->txID == txID ? txn : nullptr;
+    }
+
+    // Return the slot to the pool once, however often txn is finished
+    void release(ReplicaReadTxn* txn) {
+        std::lock_guard<std::mutex> lk(poolMutex);
+        if (txn->inUse) {
+            txn->inUse = false;
+            freeSlots.push_back(txn->txID % poolSize);
+        }
+    }
+
+public:
+    // Follows the LogShipper at host:port, reconnecting (and resuming from
+    // the applied timestamp) whenever the stream breaks. m must match the
+    // primary's.
+    ReplicaStore(int m, const std::string& host, int port, int maxActiveTx = 1024)
+        : numDataItems(m), poolSize(maxActiveTx), commitStamps(m, std::vector<int>{ 0 }),
+          values(m, std::vector<int>{ 0 }), txPool(maxActiveTx), host(host), port(port) {
+        for (int slot = poolSize - 1; slot >= 0; --slot) {
+            txPool[slot].txID = slot; // generation 0, never handed out
+            freeSlots.push_back(slot);
+        }
+        applier = std::thread(&ReplicaStore::follow, this);
+    }
+
+    ~ReplicaStore() {
+        running = false;
+        {
+            std::lock_guard<std::mutex> lk(fdMutex);
+            if (fd >= 0) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        applier.join();
+    }
+
+    ReplicaStore(const ReplicaStore&) = delete;
+    ReplicaStore& operator=(const ReplicaStore&) = delete;
+
+    // ---- read-only transactions, the engines' interface ---- //
+
+    int beginTrans() {
+        int txID;
+        while ((txID = tryBeginTrans()) < 0) {
+            std::this_thread::yield();
+        }
+        return txID;
+    }
+
+    // Snapshot at the replicated timestamp; -1 if every context is in use
+    int tryBeginTrans() {
+        std::lock_guard<std::mutex> lk(poolMutex);
+        if (freeSlots.empty()) {
+            return -1;
+        }
+        ReplicaReadTxn& txn = txPool[freeSlots.back()];
+        freeSlots.pop_back();
+        txn.txID += poolSize;
+        txn.inUse = true;
+        txn.snapshot = appliedTS.load(std::memory_order_acquire);
+        txn.wrote = false;
+        return txn.txID;
+    }
+
+    int read(int txID, int index) {
+        ReplicaReadTxn* txn = lookup(txID);
+        return txn ? readAsOf(index, txn->snapshot) : -1;
+    }
+
+    // Writes go to the primary; one here dooms the transaction
+    void write(int txID, int, int) {
+        if (ReplicaReadTxn* txn = lookup(txID)) {
+            txn->wrote = true;
+        }
+    }
+
+    bool commit(int txID) {
+        ReplicaReadTxn* txn = lookup(txID);
+        if (!txn) {
+            return false;
+        }
+        bool readOnly = !txn->wrote;
+        release(txn);
+        return readOnly;
+    }
+
+    void abort(int txID) {
+        if (ReplicaReadTxn* txn = lookup(txID)) {
+            release(txn);
+        }
+    }
+
+    bool isAborted(int txID) {
+        ReplicaReadTxn* txn = lookup(txID);
+        return !txn || txn->wrote;
+    }
+
+    // Committed value of index as of ts (at most the replicated timestamp)
+    int readAsOf(int index, int ts) {
+        std::shared_lock<std::shared_mutex> lk(storeMutex);
+        const auto& stamps = commitStamps[index];
+        auto pos = std::upper_bound(stamps.begin(), stamps.end(), ts) - stamps.begin();
+        return pos == 0 ? 0 : values[index][pos - 1];
+    }
+
+    // ---- replication state ---- //
+
+    // Replicated timestamp: every commit of the primary up to it is applied
+    int currentTimestamp() const {
+        return appliedTS.load(std::memory_order_acquire);
+    }
+
+    // Wait until the replica has applied everything up to ts, e.g. a commit
+    // the caller just made on the primary; false on timeout
+    bool waitFor(int ts, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lk(appliedMutex);
+        return applied.wait_for(lk, timeout, [&] { return currentTimestamp() >= ts; });
+    }
+
+    // Timestamps the primary had issued beyond the replicated one when it
+    // last sent anything
+    int lagTimestamps() const {
+        return std::max(0, primaryTS.load() - currentTimestamp());
+    }
+
+    // Age of the replica's state: time since the primary was last known to
+    // be at the replicated timestamp (at least the heartbeat interval while
+    // idle); -1 before the first batch
+    long long lagMicros() const {
+        long long fresh = freshMicros.load();
+        return fresh == 0 ? -1 : std::max(0LL, monotonicMicros() - fresh);
+    }
+
+    long long recordsApplied() const {
+        return appliedRecords.load();
+    }
+
+    bool isConnected() const {
+        return connected.load();
+    }
+
+private:
+    void follow() {
+        std::vector<char> frame;
+        while (running) {
+            int s = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons((uint16_t)port);
+            if (s < 0 || inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+                connect(s, (sockaddr*)&addr, sizeof(addr)) < 0) {
+                if (s >= 0) {
+                    close(s);
+                }
+                std::this_thread::sleep_for(REPLICA_RECONNECT);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lk(fdMutex);
+                if (!running) {
+                    close(s);
+                    return;
+                }
+                fd = s;
+            }
+            connected = true;
+
+            char hello[4];
+            storeAt<int32_t>(hello, currentTimestamp());
+            if (sendFully(s, hello, sizeof(hello))) {
+                char length[4];
+                while (receiveFully(s, length, sizeof(length))) {
+                    frame.resize(loadAt<uint32_t>(length));
+                    if (!receiveFully(s, frame.data(), frame.size()) || !apply(frame)) {
+                        break;
+                    }
+                }
+            }
+
+            connected = false;
+            std::lock_guard<std::mutex> lk(fdMutex);
+            close(s);
+            fd = -1;
+        }
+    }
+
+    // Apply one batch (length field stripped); false if it is malformed
+    bool apply(const std::vector<char>& frame) {
+        if (frame.size() < REPLICA_BATCH_HEADER - 4) {
+            return false;
+        }
+        const char* p = frame.data();
+        const char* end = p + frame.size();
+        int reportedTs = loadAt<int32_t>(p);
+        long long sentMicros = loadAt<int64_t>(p + 4);
+        uint32_t count = loadAt<uint32_t>(p + 12);
+        p += REPLICA_BATCH_HEADER - 4;
+
+        int newest = currentTimestamp();
+        long long newestMicros = sentMicros;
+        {
+            std::unique_lock<std::shared_mutex> lk(storeMutex);
+            for (uint32_t r = 0; r < count; ++r) {
+                if (end - p < (ptrdiff_t)REPLICA_RECORD_HEADER) {
+                    return false;
+                }
+                int ts = loadAt<int32_t>(p);
+                newestMicros = loadAt<int64_t>(p + 4);
+                uint32_t writes = loadAt<uint32_t>(p + 12);
+                p += REPLICA_RECORD_HEADER;
+                if ((size_t)(end - p) < writes * 8ULL || ts <= newest) {
+                    return false;
+                }
+                for (uint32_t w = 0; w < writes; ++w, p += 8) {
+                    int index = loadAt<int32_t>(p);
+                    if (index < 0 || index >= numDataItems) {
+                        return false; // Primary has a different key space
+                    }
+                    commitStamps[index].push_back(ts);
+                    values[index].push_back(loadAt<int32_t>(p + 4));
+                }
+                newest = ts;
+            }
+        }
+
+        // A heartbeat vouches for everything up to the primary's timestamp;
+        // records only for themselves
+        if (count == 0) {
+            newest = std::max(newest, reportedTs);
+        }
+        primaryTS.store(std::max(primaryTS.load(), reportedTs));
+        freshMicros.store(newestMicros);
+        appliedRecords.fetch_add(count);
+        {
+            std::lock_guard<std::mutex> lk(appliedMutex);
+            appliedTS.store(newest, std::memory_order_release);
+        }
+        applied.notify_all();
+        return true;
+    }
+};
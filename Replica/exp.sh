@@ -0,0 +1,62 @@
+#!/bin/bash
+
+# Script to measure read scale-out over log-shipping replicas
+# Experiment 1: Read-only load spread over the primary and 0 to 3 replicas,
+#               with a write load on the primary running alongside
+# The replicas' lag reports are kept next to the results
+
+# Compilation (adjust compiler flags as needed, e.g. -DENGINE_SI for the SI primary)
+echo "Compiling the programs..."
+g++ -std=c++17 -O2 -pthread -o primary primary.cc
+g++ -std=c++17 -O2 -pthread -o replica replica.cc
+g++ -std=c++17 -O2 -pthread -o loadgen ../Server/loadgen.cc
+
+# Constants for experiments
+PORT=7450        # Primary transaction port; replicas use PORT+1, PORT+2, ...
+LOG_PORT=7460    # Replication stream port
+M=1000           # Number of data items
+TXNS=5000        # Transactions per connection
+NUM_ITERS=10     # Operations per transaction
+CONNECTIONS=4    # Reader connections per serving instance
+
+exp_dir="experiment_vary_replicas"
+mkdir -p "$exp_dir"
+echo "replicas,reader_commits_per_sec,writer_commits_per_sec,writer_aborts_per_sec" > "$exp_dir/summary.csv"
+
+for replicas in 0 1 2 3; do
+    echo "Running experiment with replicas=$replicas"
+
+    ./primary --port=$PORT --log-port=$LOG_PORT --keys=$M > "$exp_dir/primary_r${replicas}.txt" &
+    pids=($!)
+    sleep 1
+    for r in $(seq 1 $replicas); do
+        ./replica --log-port=$LOG_PORT --port=$((PORT + r)) --keys=$M --report-ms=500 \
+            > "$exp_dir/replica${r}_r${replicas}.txt" &
+        pids+=($!)
+    done
+    sleep 1
+
+    # Writers on the primary, readers on every replica (or the primary alone)
+    ./loadgen --port=$PORT --keys=$M --txns=$TXNS --iters=$NUM_ITERS --read-ratio=0 --batch \
+        --connections=$CONNECTIONS > "$exp_dir/writers_r${replicas}.txt" &
+    writer=$!
+    readers=()
+    for r in $(seq $((replicas > 0 ? 1 : 0)) $replicas); do
+        ./loadgen --port=$((PORT + r)) --keys=$M --txns=$TXNS --iters=$NUM_ITERS --read-ratio=1 --batch \
+            --connections=$CONNECTIONS > "$exp_dir/readers${r}_r${replicas}.txt" &
+        readers+=($!)
+    done
+    wait "${readers[@]}" $writer
+
+    # Extract key metrics for summary
+    reader_commits=$(cat "$exp_dir"/readers*_r${replicas}.txt | grep "Commits per second" | awk '{s += $4} END {print s}')
+    writer_commits=$(grep "Commits per second" "$exp_dir/writers_r${replicas}.txt" | awk '{print $4}')
+    writer_aborts=$(grep "Aborts per second" "$exp_dir/writers_r${replicas}.txt" | awk '{print $4}')
+    echo "$replicas,$reader_commits,$writer_commits,$writer_aborts" >> "$exp_dir/summary.csv"
+
+    kill -INT "${pids[@]}"
+    wait "${pids[@]}" 2>/dev/null
+done
+
+echo "Experiments completed!"
+echo "Results for replica variation are in: $exp_dir"
@@ -0,0 +1,73 @@
+#include "../Server/Engine.h"
+#include "../Server/Server.h"
+#include "Replica.h"
+#include <csignal>
+#include <iostream>
+
+// Usage: ./primary [--bind=ADDR] [--port=P] [--log-port=L] [--loops=N] [--pin] [--keys=M]
+//   --bind=ADDR      listen address of both services (default 127.0.0.1)
+//   --port=P         transaction service port (default 7450)
+//   --log-port=L     replication stream port followers connect to (default 7460)
+//   --loops=N        event loops, one per core by default
+//   --pin            pin loop i to the i-th CPU, filling one NUMA node before the next
+//   --keys=M         data items 0..M-1 (default 1000)
+// Serves SI-SSN, or SI when built with -DENGINE_SI, until SIGINT or SIGTERM.
+int main(int argc, char** argv) {
+    std::string address = "127.0.0.1";
+    int port = 7450;
+    int logPort = 7460;
+    int loops = std::max(1u, std::thread::hardware_concurrency());
+    bool pin = false;
+    int m = 1000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.rfind("--bind=", 0) == 0) {
+            address = arg.substr(7);
+        }
+        else if (arg.rfind("--port=", 0) == 0) {
+            port = std::stoi(arg.substr(7));
+        }
+        else if (arg.rfind("--log-port=", 0) == 0) {
+            logPort = std::stoi(arg.substr(11));
+        }
+        else if (arg.rfind("--loops=", 0) == 0) {
+            loops = std::max(1, std::stoi(arg.substr(8)));
+        }
+        else if (arg == "--pin") {
+            pin = true;
+        }
+        else if (arg.rfind("--keys=", 0) == 0) {
+            m = std::max(1, std::stoi(arg.substr(7)));
+        }
+    }
+
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    ServedManager manager(m);
+    CommitLog log;
+    manager.attachCommitLog(&log);
+    LogShipper<ServedManager> shipper(manager, log, address, logPort);
+    TxServer<ServedManager> server(manager, m, address, port, loops, pin);
+    try {
+        logPort = shipper.start();
+        port = server.start();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Primary " << SERVED_ENGINE << " (m=" << m << ") serving " << address << ":" << port
+        << ", replication stream on port " << logPort << std::endl;
+
+    int signal = 0;
+    sigwait(&stopSignals, &signal);
+    server.stop();
+    shipper.stop();
+    std::cout << "Served " << server.requestsServed() << " requests, shipped "
+        << log.size() << " commits\n";
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "Replica.h"
+#include "../Server/Server.h"
+#include <csignal>
+#include <ctime>
+#include <iostream>
+
+// Usage: ./replica [--primary=ADDR] [--log-port=L] [--bind=ADDR] [--port=P] [--loops=N] [--pin]
+//                  [--keys=M] [--report-ms=T]
+//   --primary=ADDR   address of the primary's replication stream (default 127.0.0.1)
+//   --log-port=L     its port (default 7460)
+//   --bind=ADDR      listen address of the read-only transaction service (default 127.0.0.1)
+//   --port=P         its port (default 7451)
+//   --loops=N        event loops, one per core by default
+//   --pin            pin loop i to the i-th CPU, filling one NUMA node before the next
+//   --keys=M         data items 0..M-1, as on the primary (default 1000)
+//   --report-ms=T    print the replication lag every T ms (default 1000, 0 = never)
+// Serves read-only transactions until SIGINT or SIGTERM.
+int main(int argc, char** argv) {
+    std::string primary = "127.0.0.1";
+    int logPort = 7460;
+    std::string address = "127.0.0.1";
+    int port = 7451;
+    int loops = std::max(1u, std::thread::hardware_concurrency());
+    bool pin = false;
+    int m = 1000;
+    int reportMs = 1000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.rfind("--primary=", 0) == 0) {
+            primary = arg.substr(10);
+        }
+        else if (arg.rfind("--log-port=", 0) == 0) {
+            logPort = std::stoi(arg.substr(11));
+        }
+        else if (arg.rfind("--bind=", 0) == 0) {
+            address = arg.substr(7);
+        }
+        else if (arg.rfind("--port=", 0) == 0) {
+            port = std::stoi(arg.substr(7));
+        }
+        else if (arg.rfind("--loops=", 0) == 0) {
+            loops = std::max(1, std::stoi(arg.substr(8)));
+        }
+        else if (arg == "--pin") {
+            pin = true;
+        }
+        else if (arg.rfind("--keys=", 0) == 0) {
+            m = std::max(1, std::stoi(arg.substr(7)));
+        }
+        else if (arg.rfind("--report-ms=", 0) == 0) {
+            reportMs = std::max(0, std::stoi(arg.substr(12)));
+        }
+    }
+
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    ReplicaStore store(m, primary, logPort);
+    TxServer<ReplicaStore> server(store, m, address, port, loops, pin);
+    try {
+        port = server.start();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Replica of " << primary << ":" << logPort << " (m=" << m << ") serving "
+        << address << ":" << port << std::endl;
+
+    timespec interval{ reportMs / 1000, (reportMs % 1000) * 1000000L };
+    while (true) {
+        int signal = reportMs > 0 ? sigtimedwait(&stopSignals, nullptr, &interval) : sigwaitinfo(&stopSignals, nullptr);
+        if (signal > 0) {
+            break;
+        }
+        std::cout << "replicated_ts=" << store.currentTimestamp()
+            << " lag_ts=" << store.lagTimestamps()
+            << " lag_ms=" << store.lagMicros() / 1000.0
+            << " records=" << store.recordsApplied()
+            << (store.isConnected() ? "" : " (disconnected)") << std::endl;
+    }
+    server.stop();
+    std::cout << "Served " << server.requestsServed() << " requests\n";
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "SI-SSN.h"
+#include "../common/microbench.h"
+
+ENGINE_BENCHMARKS(SnapshotIsolationManager);
+
+BENCHMARK_MAIN();
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 #include "SI-SSN.h"
 
 // ✅ Test: Read-only transactions always commit
@@ -91,3 +92,332 @@ TEST(SnapshotIsolationSSNTest, UncommittedWriteInvisible) {
     ASSERT_TRUE(manager.commit(tx2));
     ASSERT_TRUE(manager.commit(tx1));
 }
+
+// ✅ Test: Write after a newer committed version aborts immediately
+TEST(SnapshotIsolationSSNTest, EarlyAbortOnWrite) {
+    SnapshotIsolationManager manager(1);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 10);
+    ASSERT_TRUE(manager.commit(tx1));
+
+    manager.write(tx2, 0, 20);
+    ASSERT_TRUE(manager.isAborted(tx2));
+    ASSERT_FALSE(manager.commit(tx2));
+}
+
+// ✅ Test: Reader whose exclusion window closes is aborted before commit
+TEST(SnapshotIsolationSSNTest, EarlyAbortOnClosedWindow) {
+    SnapshotIsolationManager manager(1);
+    int tx1 = manager.beginTrans();
+    manager.read(tx1, 0);
+    ASSERT_FALSE(manager.isAborted(tx1));
+
+    int tx2 = manager.beginTrans();
+    manager.write(tx2, 0, 5);
+    ASSERT_TRUE(manager.commit(tx2));
+
+    ASSERT_TRUE(manager.isAborted(tx1));
+    ASSERT_EQ(manager.read(tx1, 0), -1);
+    ASSERT_FALSE(manager.commit(tx1));
+}
+
+// ✅ Test: Every in-flight reader slot is seen by the overwriting committer
+TEST(SnapshotIsolationSSNTest, AllRegisteredReadersTracked) {
+    SnapshotIsolationManager manager(1);
+    std::vector<int> readers;
+    for (int i = 0; i < MAX_VERSION_READERS; ++i) {
+        int tx = manager.beginTrans();
+        manager.read(tx, 0);
+        ASSERT_FALSE(manager.isAborted(tx));
+        readers.push_back(tx);
+    }
+
+    // No slot left for another in-flight reader: it reads untracked
+    int extra = manager.beginTrans();
+    ASSERT_EQ(manager.read(extra, 0), 0);
+    ASSERT_EQ(manager.untrackedReads(), 1);
+
+    int writer = manager.beginTrans();
+    manager.write(writer, 0, 7);
+    ASSERT_TRUE(manager.commit(writer));
+
+    for (int tx : readers) {
+        ASSERT_TRUE(manager.isAborted(tx));
+    }
+
+    // The untracked reader finds the overwrite at commit
+    ASSERT_FALSE(manager.commit(extra));
+}
+
+// ✅ Test: More concurrent readers than reader slots all commit without a writer
+TEST(SnapshotIsolationSSNTest, ReaderSlotOverflowDoesNotAbort) {
+    SnapshotIsolationManager manager(1);
+    std::vector<int> readers;
+    for (int i = 0; i < MAX_VERSION_READERS + 4; ++i) {
+        int tx = manager.beginTrans();
+        ASSERT_EQ(manager.read(tx, 0), 0);
+        readers.push_back(tx);
+    }
+    for (int tx : readers) {
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_EQ(manager.untrackedReads(), 4);
+    ASSERT_EQ(manager.serializationAborts(), 0);
+}
+
+// ✅ Test: Transaction contexts are recycled and stale handles are rejected
+TEST(SnapshotIsolationSSNTest, PooledContextsRecycled) {
+    SnapshotIsolationManager manager(1, 2);
+    int first = manager.beginTrans();
+    manager.write(first, 0, 1);
+    ASSERT_TRUE(manager.commit(first));
+
+    for (int i = 2; i <= 10; ++i) {
+        int tx = manager.beginTrans();
+        ASSERT_EQ(manager.read(tx, 0), i - 1);
+        manager.write(tx, 0, i);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+
+    ASSERT_TRUE(manager.isAborted(first));
+    ASSERT_FALSE(manager.commit(first));
+}
+
+// ✅ Test: Finishing a handle twice does not return its context to the pool twice
+TEST(SnapshotIsolationSSNTest, FinishedHandleReleasedOnce) {
+    SnapshotIsolationManager manager(4, 2);
+    int a = manager.beginTrans();
+    ASSERT_TRUE(manager.commit(a));
+    manager.abort(a);
+    ASSERT_FALSE(manager.commit(a));
+
+    int b = manager.beginTrans();
+    int c = manager.beginTrans();
+    ASSERT_NE(b % 2, c % 2);
+    ASSERT_EQ(manager.tryBeginTrans(), -1);
+
+    manager.write(b, 0, 1);
+    ASSERT_TRUE(manager.commit(b));
+    ASSERT_TRUE(manager.commit(c));
+}
+
+// ✅ Test: AS OF reads and transactions begun in the past see history
+TEST(SnapshotIsolationSSNTest, TimeTravelReads) {
+    SnapshotIsolationManager manager(2);
+
+    std::vector<int> stamps;
+    for (int v = 1; v <= 100; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        manager.write(tx, 1, 2 * v);
+        ASSERT_TRUE(manager.commit(tx));
+        stamps.push_back(manager.currentTimestamp());
+    }
+
+    ASSERT_EQ(manager.readAsOf(0, 0), 0);
+    for (int v = 1; v <= 100; ++v) {
+        ASSERT_EQ(manager.readAsOf(0, stamps[v - 1]), v);
+    }
+
+    int audit = manager.beginAt(stamps[41]);
+    ASSERT_EQ(manager.read(audit, 0), 42);
+    ASSERT_EQ(manager.read(audit, 1), 84);
+    ASSERT_TRUE(manager.commit(audit)); // read-only
+
+    int stale = manager.beginAt(stamps[0]);
+    manager.write(stale, 0, 7);
+    ASSERT_TRUE(manager.isAborted(stale));
+}
+
+// ✅ Test: Under a memory budget, versions no snapshot can see are collected
+TEST(SnapshotIsolationSSNTest, MemoryBudgetCollectsUnseenVersions) {
+    SnapshotIsolationManager manager(4);
+    MemoryBudget budget;
+    budget.limitBytes = manager.memoryStats().total + 4 * 1024; // Overwritten versions are packed
+    budget.abortOldest = false;
+    budget.throttle = false;
+    manager.setMemoryBudget(budget);
+
+    int old = manager.beginTrans();
+    for (int v = 1; v <= 5000; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 1, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_EQ(manager.read(old, 1), 0);     // Its version survived collection
+    ASSERT_TRUE(manager.commit(old));
+
+    int tx = manager.beginTrans();
+    manager.write(tx, 2, 1);
+    ASSERT_TRUE(manager.commit(tx));
+    ASSERT_EQ(manager.readAsOf(1, manager.currentTimestamp()), 5000);
+    MemoryStats stats = manager.memoryStats();
+    ASSERT_GT(stats.gcRuns, 0);
+    ASSERT_GT(stats.versionsReclaimed, 4000);
+    ASSERT_LE(stats.total, budget.limitBytes);
+}
+
+// ✅ Test: A snapshot pinning too many versions is aborted to stay within budget
+TEST(SnapshotIsolationSSNTest, MemoryBudgetShedsOldestSnapshot) {
+    SnapshotIsolationManager manager(4);
+    MemoryBudget budget;
+    budget.limitBytes = manager.memoryStats().total + 4 * 1024; // Overwritten versions are packed
+    budget.throttle = false;
+    manager.setMemoryBudget(budget);
+
+    int old = manager.beginTrans();
+    for (int v = 1; v <= 5000; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 1, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_TRUE(manager.isAborted(old));
+    ASSERT_EQ(manager.read(old, 1), -1);
+    ASSERT_FALSE(manager.commit(old));
+    MemoryStats stats = manager.memoryStats();
+    ASSERT_EQ(stats.budgetAborts, 1);
+    ASSERT_LE(stats.total, budget.limitBytes);
+}
+
+// ✅ Test: Over budget, new transactions wait until a running one finishes
+TEST(SnapshotIsolationSSNTest, MemoryBudgetThrottlesNewTransactions) {
+    SnapshotIsolationManager manager(4);
+    MemoryBudget budget;
+    budget.limitBytes = 1;  // Below the live data: nothing to collect or shed
+    manager.setMemoryBudget(budget);
+
+    int running = manager.beginTrans();     // Nothing running yet, so admitted
+    ASSERT_EQ(manager.tryBeginTrans(), -1);
+    manager.write(running, 0, 1);
+    ASSERT_TRUE(manager.commit(running));
+    int next = manager.tryBeginTrans();
+    ASSERT_GE(next, 0);
+    ASSERT_TRUE(manager.commit(next));
+    ASSERT_EQ(manager.memoryStats().budgetAborts, 0);
+}
+
+// ✅ Test: Version statistics count chains and the garbage an open snapshot pins
+TEST(SnapshotIsolationSSNTest, VersionStatsReportBacklog) {
+    SnapshotIsolationManager manager(4);
+    int old = manager.beginTrans();  // Reads nothing, or the writers would abort it
+    for (int v = 1; v <= 5; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    VersionStats stats = manager.versionStats();
+    ASSERT_EQ(stats.keys, 4);
+    ASSERT_EQ(stats.versions, 9);
+    ASSERT_EQ(stats.longestChain, 6);
+    ASSERT_EQ(stats.gcBacklog, 0);  // The old snapshot still sees the first version
+
+    ASSERT_TRUE(manager.commit(old));
+    ASSERT_EQ(manager.versionStats().gcBacklog, 5);
+}
+
+// ✅ Test: Version statistics follow collection and sample the backlog of many keys
+TEST(SnapshotIsolationSSNTest, VersionStatsTrackCollection) {
+    const int keys = 4096;
+    SnapshotIsolationManager manager(keys);
+    int old = manager.beginTrans();
+    for (int index = 0; index < keys; ++index) {
+        int tx = manager.beginTrans();
+        manager.write(tx, index, index + 1);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_TRUE(manager.commit(old));
+    VersionStats stats = manager.versionStats();
+    ASSERT_EQ(stats.versions, 2 * keys);
+    ASSERT_EQ(stats.longestChain, 2);
+    ASSERT_EQ(stats.gcBacklog, keys);   // Every key has one collectable version
+
+    MemoryBudget budget;
+    budget.limitBytes = 1;              // Collect at the next begin
+    budget.abortOldest = false;
+    budget.throttle = false;
+    manager.setMemoryBudget(budget);
+    ASSERT_TRUE(manager.commit(manager.beginTrans()));
+    stats = manager.versionStats();
+    ASSERT_EQ(stats.versions, keys);
+    ASSERT_EQ(stats.longestChain, 1);
+    ASSERT_EQ(stats.gcBacklog, 0);
+}
+
+// ✅ Test: Packed history returns every pair it was given, before and after collection
+TEST(SnapshotIsolationSSNTest, ColdChainRoundTrip) {
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 50; ++trial) {
+        ColdChain cold;
+        std::vector<ColdChain::Entry> expected;
+        int stamp = 1;
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 150; ++i) {
+                stamp += 1 + (int)(rng() % (trial % 2 ? 3 : 100000));
+                int value = trial % 3 ? (int)(rng() % 1000) - 500 : (int)rng();
+                cold.push(stamp, value);
+                expected.push_back({ stamp, value });
+            }
+            ASSERT_EQ(cold.size(), expected.size());
+            ColdChain::Entry e;
+            ASSERT_FALSE(cold.find(expected.front().stamp - 1, e));
+            for (size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_TRUE(cold.find(expected[i].stamp, e));
+                ASSERT_EQ(e.stamp, expected[i].stamp);
+                ASSERT_EQ(e.value, expected[i].value);
+                ASSERT_EQ(cold.countUpTo(expected[i].stamp), i + 1);
+                if (i + 1 < expected.size()) {
+                    ASSERT_TRUE(cold.find(expected[i + 1].stamp - 1, e));   // Between two versions
+                    ASSERT_EQ(e.value, expected[i].value);
+                }
+            }
+            size_t drop = rng() % expected.size();
+            cold.dropOldest(drop);
+            expected.erase(expected.begin(), expected.begin() + drop);
+        }
+    }
+}
+
+// ✅ Test: Long-lived snapshots read the right value at every point of a long history
+TEST(SnapshotIsolationSSNTest, HistoricalReadsAcrossPackedBlocks) {
+    SnapshotIsolationManager manager(2);
+    std::vector<int> stamps, values;
+    for (int v = 1; v <= 1000; ++v) {
+        int value = (v % 7 == 0) ? -v * 1000 : v;
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, value);
+        ASSERT_TRUE(manager.commit(tx));
+        stamps.push_back(manager.currentTimestamp());
+        values.push_back(value);
+    }
+    ASSERT_EQ(manager.readAsOf(0, 0), 0);
+    for (size_t i = 0; i < stamps.size(); ++i) {
+        ASSERT_EQ(manager.readAsOf(0, stamps[i]), values[i]);
+        ASSERT_EQ(manager.readAsOf(0, stamps[i] + 1), values[i]);  // Before the next commit
+    }
+    int snapshot = manager.beginAt(stamps[500]);
+    ASSERT_EQ(manager.read(snapshot, 0), values[500]);
+    ASSERT_TRUE(manager.commit(snapshot));
+
+    VersionStats stats = manager.versionStats();
+    ASSERT_EQ(stats.longestChain, 1001);
+}
+
+// ✅ Test: Overwritten versions cost a few bytes each instead of a full version
+TEST(SnapshotIsolationSSNTest, OverwrittenVersionsArePacked) {
+    SnapshotIsolationManager manager(16);
+    int old = manager.beginTrans();     // Keeps every version visible to someone
+    long long before = manager.memoryStats().bytes[MEM_VERSIONS] + manager.memoryStats().bytes[MEM_READERS];
+    const int versions = 16000;
+    for (int v = 1; v <= versions; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, v % 16, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    MemoryStats stats = manager.memoryStats();
+    long long perVersion = (stats.bytes[MEM_VERSIONS] + stats.bytes[MEM_READERS] - before) / versions;
+    ASSERT_LE(perVersion, 8);
+    ASSERT_LT(perVersion * 10, (long long)sizeof(Version));
+    ASSERT_EQ(manager.versionStats().versions, versions + 16);
+    ASSERT_TRUE(manager.commit(old));
+}
@@ -4,22 +4,32 @@
 #include <mutex>
 #include <atomic>
 #include <thread>
-#include <unordered_map>
-#include <unordered_set>
-#include <list>
 #include <algorithm>
+#include <utility>
 #include <climits>
-
-// Metadata required for SSN as per Table 1 in the paper
+#include <new>
+#include "../common/affinity.h"
+#include "../common/perf.h"
+#include "../common/commitlog.h"
+#include "../common/memory.h"
+#include "../common/coldchain.h"
+
+// Fixed reader slots per version; a reader that finds them all taken by
+// in-flight transactions is not tracked there and instead checks at
+// commit whether the version it read has been overwritten
+constexpr int MAX_VERSION_READERS = 16;
+
+// Metadata required for SSN as per Table 1 in the paper. Only the latest
+// version of a key is kept in this form; once overwritten, readers are
+// done with its slots and only its stamp and value are packed into the
+// key's history (see common/coldchain.h).
 struct Version {
     int value;
     int t_cstamp;       // Transaction commit timestamp, c(T)
     int r_pstamp;       // Predecessor high-water mark, p(T)
     int s_pstamp;       // Successor low-water mark, s(T)
     int v_pstamp;       // Version predecessor stamp, p(V)
-    Version* v_prev;    // Pointer to overwritten version
-    std::unordered_set<int> t_reads;  // Transactions that read this version
-    std::unordered_set<int> t_writes; // Transactions that wrote this version
+    std::atomic<int> t_reads[MAX_VERSION_READERS] = {}; // Handles of in-flight readers, 0 = free
 };
 
 enum TransactionStatus {
@@ -28,131 +38,494 @@ enum TransactionStatus {
     ABORTED
 };
 
-struct Transaction {
-    int txID;
+// Pooled transaction context, one cache line apart from its neighbours.
+// txID doubles as the pool handle: txID % poolSize is the slot and the
+// quotient is a generation that changes each time the slot is reused.
+struct alignas(64) Transaction {
+    int txID = 0;
+    bool inUse = false;
     int start_ts;
     int t_cstamp = -1;      // Commit timestamp
     int t_pstamp = 0;       // Predecessor high-water mark
-    int s_pstamp = INT_MAX; // Successor low-water mark
+    std::atomic<int> s_pstamp{ INT_MAX }; // Successor low-water mark, lowered by committers
     TransactionStatus t_status = IN_FLIGHT;
-    std::unordered_set<int> t_reads;  // Read set indices
-    std::unordered_set<int> t_writes; // Write set indices
-    std::vector<int> writeValues;     // -1 means no write for that index
+    std::vector<std::pair<int, int>> t_writes; // Write set, (index, value) in first-write order
+    std::vector<std::pair<int, int>> untrackedReads; // (index, c(V)) of reads that found no free reader slot
 };
 
 class SnapshotIsolationManager {
 private:
-    std::atomic<int> nextTxID{ 1000 };
     std::atomic<int> globalTS{ 1 };
     std::mutex dataMutex;
+    std::atomic<long long> serializationFailures{ 0 }; // Aborts by the exclusion window check
+    std::atomic<long long> untrackedReadCount{ 0 };    // Reads past a full set of reader slots
 
     int numDataItems;
-    std::vector<std::vector<Version*>> versionChain; // versionChain[index] = list of versions
-    std::unordered_map<int, Transaction*> transactions; // txID -> Transaction
+    int poolSize;
+    int numNodes;
+    std::vector<NodeArena> nodeArenas;               // Versions and contexts, one arena per NUMA node
+    std::vector<Version*> latest;                    // latest[index] = newest committed version
+    std::vector<ColdChain> history;                  // Overwritten versions still kept, oldest first
+    std::vector<Transaction*> txPool;                // txPool[txID % poolSize]
+    std::vector<std::vector<int>> freeSlots;         // Unused txPool slots, per home node
+    int activeContexts = 0;
+    std::vector<std::vector<Version*>> freeVersions; // Overwritten versions, reused per node
+    CommitLog* commitLog = nullptr;                  // Replication stream, if any
+    MemoryGovernor memory;
+    int reclaimedTS = 0;                             // History before it has been collected
+    ChainLengths chainLengths;                       // Latest version plus history, per key
+    long long statsOffset = 0;                       // Where the next backlog sample starts
+
+    // A version's reader slots are accounted apart from the rest of it
+    static constexpr long long VERSION_BYTES = sizeof(Version) - sizeof(Version::t_reads);
+    static constexpr long long READER_BYTES = sizeof(Version::t_reads);
+
+    // Direct-indexed lookup; nullptr once txID has committed or aborted,
+    // whether or not its slot has been claimed again
+    Transaction* lookup(int txID) {
+        Transaction* txn = txPool[txID % poolSize];
+        return txn->inUse && txn->txID == txID ? txn : nullptr;
+    }
+
+    // Buffered write of index, or nullptr; write sets are short, so a
+    // scan beats a per-context array sized to the key space
+    static std::pair<int, int>* findWrite(Transaction* txn, int index) {
+        for (auto& w : txn->t_writes) {
+            if (w.first == index) {
+                return &w;
+            }
+        }
+        return nullptr;
+    }
+
+    // Pool slots are split into contiguous ranges, one per node
+    int slotNode(int slot) const {
+        return (int)((long long)slot * numNodes / poolSize);
+    }
+
+    // Versions live on the home node of their key, recycled ones first
+    Version* newVersion(int index, int value, int t_cstamp, int v_pstamp) {
+        int node = keyHomeNode(index, numDataItems, numNodes);
+        void* mem;
+        if (!freeVersions[node].empty()) {
+            mem = freeVersions[node].back();
+            freeVersions[node].pop_back();
+        }
+        else {
+            mem = nodeArenas[node].allocate(sizeof(Version), alignof(Version));
+        }
+        memory.account.charge(MEM_VERSIONS, VERSION_BYTES);
+        memory.account.charge(MEM_READERS, READER_BYTES);
+        return new (mem) Version{ value, t_cstamp, 0, INT_MAX, v_pstamp };
+    }
+
+    // Make v the latest version of index. The version it replaces hands
+    // its readers their successor stamp, moves into the history as a
+    // (stamp, value) pair and goes back to the free list.
+    void installVersion(int index, Version* v) {
+        Version* old = latest[index];
+        latest[index] = v;
+        update_version_timestamps(old);
+
+        ColdChain& cold = history[index];
+        long long before = cold.bytes();
+        cold.push(old->t_cstamp, old->value);
+        chainLengths.resized(cold.size(), cold.size() + 1);
+        memory.account.recharge(MEM_VERSIONS, before, cold.bytes());
+
+        old->~Version();
+        freeVersions[keyHomeNode(index, numDataItems, numNodes)].push_back(old);
+        memory.account.charge(MEM_VERSIONS, -VERSION_BYTES);
+        memory.account.charge(MEM_READERS, -READER_BYTES);
+    }
+
+    // Oldest snapshot of a transaction that can still read; versions it
+    // cannot see are garbage
+    int horizon() {
+        int oldest = globalTS.load() - 1;
+        for (auto* txn : txPool) {
+            if (txn->inUse && txn->t_status == IN_FLIGHT) {
+                oldest = std::min(oldest, txn->start_ts);
+            }
+        }
+        return oldest;
+    }
+
+    // Overwritten versions of index older than the one visible at h
+    size_t collectable(int index, int h) const {
+        const ColdChain& cold = history[index];
+        if (latest[index]->t_cstamp <= h) {
+            return cold.size();
+        }
+        size_t visible = cold.countUpTo(h);
+        return visible > 0 ? visible - 1 : 0;
+    }
+
+    // Drop every overwritten version older than the one visible at the
+    // horizon. Only reads under dataMutex reach the history.
+    void collectVersions() {
+        int h = horizon();
+        long long reclaimed = 0, pinned = 0;
+        for (int index = 0; index < numDataItems; ++index) {
+            ColdChain& cold = history[index];
+            size_t garbage = collectable(index, h);
+            if (garbage > 0) {
+                long long before = cold.bytes();
+                cold.dropOldest(garbage);
+                chainLengths.resized(1 + cold.size() + garbage, 1 + cold.size());
+                memory.account.recharge(MEM_VERSIONS, before, cold.bytes());
+                reclaimed += garbage;
+            }
+            pinned += cold.size();
+        }
+        reclaimedTS = std::max(reclaimedTS, h);
+        memory.collected(reclaimed, pinned, h);
+    }
+
+    // Abort the in-flight transaction with the oldest snapshot; its context
+    // stays claimed until the owner commits or aborts, but no longer pins
+    // versions. False if there is none.
+    bool shedOldest() {
+        Transaction* victim = nullptr;
+        for (auto* txn : txPool) {
+            if (txn->inUse && txn->t_status == IN_FLIGHT && (!victim || txn->start_ts < victim->start_ts)) {
+                victim = txn;
+            }
+        }
+        if (!victim) {
+            return false;
+        }
+        victim->t_status = ABORTED;
+        memory.budgetAborts.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Escalation steps 1 and 2 of common/memory.h; caller holds dataMutex
+    void relieveMemory() {
+        if (memory.wantsCollection([this] { return horizon(); })) {
+            collectVersions();
+        }
+        if (memory.shouldShed() && shedOldest()) {
+            collectVersions();
+        }
+    }
+
+    // The version of index a snapshot at ts sees: the latest one, or the
+    // newest overwritten one committed at or before ts, found by binary
+    // search over the history's blocks
+    struct Visible {
+        bool found = false;
+        Version* latest = nullptr;  // Set when the latest version is visible
+        int value = 0;
+        int t_cstamp = 0;
+    };
+
+    Visible visibleAt(int index, int ts) {
+        Visible v;
+        Version* head = latest[index];
+        if (head->t_cstamp <= ts) {
+            v = { true, head, head->value, head->t_cstamp };
+        }
+        else {
+            ColdChain::Entry e;
+            if (history[index].find(ts, e)) {
+                v = { true, nullptr, e.value, e.stamp };
+            }
+        }
+        return v;
+    }
+
+    // Claim a pooled context with snapshot asOf, or a fresh timestamp if
+    // asOf < 0; -1 if every context is in use, or if memory is over budget
+    // and running transactions may still free some (throttled is set then)
+    int claimContext(int asOf, bool& throttled) {
+        int home = currentNode();
+        PerfLockGuard lk(dataMutex);
+        throttled = memory.shouldThrottle() && activeContexts > 0;
+        if (throttled) {
+            return -1;
+        }
+
+        // Prefer a context on the caller's node, fall back to any other
+        int node = -1;
+        for (int i = 0; i < numNodes && node < 0; ++i) {
+            int candidate = (home + i) % numNodes;
+            if (!freeSlots[candidate].empty()) {
+                node = candidate;
+            }
+        }
+        if (node < 0) {
+            return -1;
+        }
+        int slot = freeSlots[node].back();
+        freeSlots[node].pop_back();
+
+        Transaction* txn = txPool[slot];
+        txn->txID += poolSize; // next generation of this slot
+        txn->inUse = true;
+        ++activeContexts;
+        txn->start_ts = asOf < 0 ? globalTS.fetch_add(1) : std::max(reclaimedTS, std::min(asOf, globalTS.load() - 1));
+        txn->t_cstamp = -1;
+        txn->t_pstamp = 0;
+        txn->s_pstamp.store(INT_MAX, std::memory_order_relaxed);
+        txn->t_status = IN_FLIGHT;
+        relieveMemory();
+        return txn->txID;
+    }
+
+    // Claim a context, waiting while the pool is exhausted or memory is
+    // throttled; the first wait for memory is counted
+    int claimContextWaiting(int asOf) {
+        bool throttled, counted = false;
+        int txID;
+        while ((txID = claimContext(asOf, throttled)) < 0) {
+            if (throttled && !counted) {
+                memory.throttledBegins.fetch_add(1, std::memory_order_relaxed);
+                counted = true;
+            }
+            std::this_thread::yield();
+        }
+        return txID;
+    }
+
+    // Return the context to the pool. Stale handles left in reader slots
+    // no longer match txID once the slot is reused, so no scrub is needed.
+    void release(Transaction* txn) {
+        txn->t_writes.clear();
+        txn->untrackedReads.clear();
+        txn->inUse = false;
+        --activeContexts;
+        int slot = txn->txID % poolSize;
+        freeSlots[slotNode(slot)].push_back(slot);
+    }
 
 public:
-    SnapshotIsolationManager(int m)
-        : numDataItems(m), versionChain(m) {
+    // maxActiveTx bounds the number of concurrently open transactions;
+    // beginTrans() waits for a free context once they are all in use
+    SnapshotIsolationManager(int m, int maxActiveTx = 1024)
+        : numDataItems(m), poolSize(maxActiveTx), numNodes(numaNodeCount()),
+          latest(m), history(m), txPool(maxActiveTx), freeSlots(numNodes), freeVersions(numNodes) {
+        for (int node = 0; node < numNodes; ++node) {
+            nodeArenas.emplace_back(node);
+        }
+        memory.account.charge(MEM_INDEX, containerBytes(latest) + containerBytes(history));
         for (int i = 0; i < m; ++i) {
-            Version* initialVersion = new Version{ 0, 0, 0, INT_MAX, 0, nullptr };
-            versionChain[i].push_back(initialVersion);
+            latest[i] = newVersion(i, 0, 0, 0);
+            chainLengths.added(1);
         }
+        for (int slot = poolSize - 1; slot >= 0; --slot) {
+            NodeArena& arena = nodeArenas[slotNode(slot)];
+            Transaction* txn = new (arena.allocate(sizeof(Transaction), alignof(Transaction))) Transaction();
+            txn->txID = slot; // generation 0, never handed out
+            txPool[slot] = txn;
+            freeSlots[slotNode(slot)].push_back(slot);
+        }
+        memory.account.charge(MEM_TX_STATE, (long long)poolSize * sizeof(Transaction) + containerBytes(txPool));
+    }
+
+    static SnapshotIsolationManager withContextPool(int m, int maxActiveTx) {
+        return SnapshotIsolationManager(m, maxActiveTx);
+    }
+
+    int contextPoolSize() const {
+        return poolSize;
     }
 
     ~SnapshotIsolationManager() {
-        // Cleanup all memory
-        for (auto& versions : versionChain) {
-            for (auto* v : versions) {
-                delete v;
-            }
+        // Arenas release the memory; only run destructors here
+        for (auto* v : latest) {
+            v->~Version();
         }
-        for (auto& [_, txn] : transactions) {
-            delete txn;
+        for (auto* txn : txPool) {
+            txn->~Transaction();
         }
     }
 
     int beginTrans() {
-        int txID = nextTxID.fetch_add(1);
-        int ts = globalTS.fetch_add(1);
-        {
-            std::lock_guard<std::mutex> lk(dataMutex);
-            Transaction* txn = new Transaction();
-            txn->txID = txID;
-            txn->start_ts = ts;
-            txn->writeValues.assign(numDataItems, -1);
-            transactions[txID] = txn;
-        }
-        return txID;
+        return claimContextWaiting(-1);
+    }
+
+    // Non-blocking begin: -1 if every transaction context is in use, or
+    // if new transactions are being held back for memory
+    int tryBeginTrans() {
+        bool throttled;
+        return claimContext(-1, throttled);
+    }
+
+    // Time travel: a transaction whose snapshot is the database as of an
+    // earlier timestamp (clamped to the past). Meant for reading history;
+    // a write to a key changed after ts aborts it.
+    int beginAt(int ts) {
+        return claimContextWaiting(std::max(0, ts));
+    }
+
+    // Committed value of index as of ts, without a transaction. Under a
+    // memory budget, history older than the collected horizon is gone and
+    // such reads see the oldest retained state.
+    int readAsOf(int index, int ts) {
+        PerfLockGuard lk(dataMutex);
+        return visibleAt(index, std::max(ts, reclaimedTS)).value;
+    }
+
+    // Bound the memory of versions and transaction state (see
+    // common/memory.h); a zero limit turns reclamation off
+    void setMemoryBudget(const MemoryBudget& budget) {
+        PerfLockGuard lk(dataMutex);
+        memory.setBudget(budget);
+    }
+
+    MemoryStats memoryStats() const {
+        return memory.stats();
+    }
+
+    // Chain lengths, kept up to date by every install and collection, and
+    // uncollected garbage estimated from a sample of the keys
+    VersionStats versionStats() {
+        PerfLockGuard lk(dataMutex);
+        VersionStats stats;
+        int h = horizon();
+        stats.keys = numDataItems;
+        stats.versions = chainLengths.versions();
+        stats.longestChain = chainLengths.longestChain();
+        stats.gcBacklog = sampledTotal(stats.keys, statsOffset, [&](long long index) {
+            return (long long)collectable((int)index, h);
+        });
+        return stats;
+    }
+
+    // Append the write set of every later commit to log
+    void attachCommitLog(CommitLog* log) {
+        PerfLockGuard lk(dataMutex);
+        commitLog = log;
+    }
+
+    // Latest timestamp handed out; every commit up to it is visible
+    int currentTimestamp() {
+        PerfLockGuard lk(dataMutex);
+        return globalTS.load() - 1;
     }
 
     int read(int txID, int index) {
-        std::lock_guard<std::mutex> lk(dataMutex);
-        auto* txn = transactions[txID];
+        PerfLockGuard lk(dataMutex);
+        auto* txn = lookup(txID);
 
         // Check if transaction is still valid
-        if (txn->t_status == ABORTED) {
+        if (!txn || txn->t_status == ABORTED) {
             return -1; // Transaction already aborted
         }
 
-        // Record read in transaction's read set
-        txn->t_reads.insert(index);
-
         // First check if we've written to this item
-        if (txn->writeValues[index] != -1) {
-            return txn->writeValues[index];
+        if (auto* w = findWrite(txn, index)) {
+            return w->second;
         }
 
         // Get the visible version according to snapshot isolation
-        int start_ts = txn->start_ts;
-        Version* visibleVersion = nullptr;
-
-        for (auto it = versionChain[index].rbegin(); it != versionChain[index].rend(); ++it) {
-            if ((*it)->t_cstamp <= start_ts) {
-                visibleVersion = *it;
-                break;
-            }
-        }
+        Visible visible = visibleAt(index, txn->start_ts);
 
         // No visible version found (shouldn't happen with initial versions)
-        if (!visibleVersion) {
+        if (!visible.found) {
             return 0;
         }
 
-        // Update the version's reader set and transaction's read set
-        visibleVersion->t_reads.insert(txID);
+        // Register as a reader so the overwriter can lower our s(T); only the
+        // latest version can still be overwritten, older ones need no tracking.
+        // With every slot held by an in-flight reader, commit() looks for the
+        // overwrite itself instead.
+        if (visible.latest && !register_reader(visible.latest, txn)) {
+            long long before = containerBytes(txn->untrackedReads);
+            txn->untrackedReads.push_back({ index, visible.t_cstamp });
+            memory.account.recharge(MEM_TX_STATE, before, containerBytes(txn->untrackedReads));
+            untrackedReadCount.fetch_add(1, std::memory_order_relaxed);
+        }
 
         // SSN: Update transaction's predecessor timestamp (t_pstamp)
         // t_pstamp = max(t_pstamp, c(V))
-        txn->t_pstamp = std::max(txn->t_pstamp, visibleVersion->t_cstamp);
+        txn->t_pstamp = std::max(txn->t_pstamp, visible.t_cstamp);
+
+        // Update the transaction's predecessor high-water mark based on the
+        // version's predecessor timestamp. An overwritten version's p(V) is
+        // the commit stamp of the one before it, below c(V), so it adds
+        // nothing and is not kept in the history.
+        if (visible.latest) {
+            txn->t_pstamp = std::max(txn->t_pstamp, visible.latest->v_pstamp);
+        }
 
-        // Update the transaction's predecessor high-water mark
-        // based on the version's predecessor timestamp
-        txn->t_pstamp = std::max(txn->t_pstamp, visibleVersion->v_pstamp);
+        // Early abort: p(T) only grows and s(T) only shrinks, so once the
+        // exclusion window closes the commit-time check is bound to fail
+        if (!validateSSN(txn)) {
+            txn->t_status = ABORTED;
+            serializationFailures.fetch_add(1);
+            return -1;
+        }
 
-        return visibleVersion->value;
+        return visible.value;
     }
 
     void write(int txID, int index, int val) {
-        std::lock_guard<std::mutex> lk(dataMutex);
-        auto* txn = transactions[txID];
+        PerfLockGuard lk(dataMutex);
+        auto* txn = lookup(txID);
 
         // Check if transaction is still valid
-        if (txn->t_status == ABORTED) {
+        if (!txn || txn->t_status == ABORTED) {
             return; // Transaction already aborted
         }
 
+        // Early abort: a version committed after our snapshot already exists,
+        // so the write-write check in commit() cannot succeed
+        if (latest[index]->t_cstamp > txn->start_ts) {
+            txn->t_status = ABORTED;
+            return;
+        }
+
         // Record write intent
-        txn->writeValues[index] = val;
-        txn->t_writes.insert(index);
+        if (auto* w = findWrite(txn, index)) {
+            w->second = val;
+            return;
+        }
+        long long before = containerBytes(txn->t_writes);
+        txn->t_writes.push_back({ index, val });
+        memory.account.recharge(MEM_TX_STATE, before, containerBytes(txn->t_writes));
+    }
+
+    // Claim a free reader slot with a single CAS per slot (wait-free, no
+    // allocation). Slots held by finished transactions are reusable.
+    bool register_reader(Version* v, Transaction* txn) {
+        for (auto& slot : v->t_reads) {
+            int cur = slot.load(std::memory_order_acquire);
+            if (cur == txn->txID) {
+                return true;
+            }
+            Transaction* holder = cur ? lookup(cur) : nullptr;
+            if ((holder == nullptr || holder->t_status != IN_FLIGHT) &&
+                slot.compare_exchange_strong(cur, txn->txID, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Atomic s_pstamp = min(s_pstamp, stamp)
+    static void lower_s_pstamp(Transaction* txn, int stamp) {
+        int cur = txn->s_pstamp.load(std::memory_order_relaxed);
+        while (stamp < cur &&
+            !txn->s_pstamp.compare_exchange_weak(cur, stamp, std::memory_order_acq_rel)) {
+        }
     }
 
     // Function to update version timestamps based on SSN
     void update_version_timestamps(Version* v) {
-        for (int readerID : v->t_reads) {
-            auto readerIt = transactions.find(readerID);
-            if (readerIt != transactions.end() && readerIt->second->t_status == IN_FLIGHT) {
+        for (auto& slot : v->t_reads) {
+            int readerID = slot.exchange(0, std::memory_order_acq_rel);
+            Transaction* reader = readerID ? lookup(readerID) : nullptr;
+            if (reader && reader->t_status == IN_FLIGHT) {
                 // Update s_pstamp = min(s_pstamp, r.t_cstamp)
-                readerIt->second->s_pstamp = std::min(readerIt->second->s_pstamp, v->t_cstamp);
+                lower_s_pstamp(reader, v->t_cstamp);
+
+                // Reader's exclusion window just closed; abort it eagerly
+                if (!validateSSN(reader)) {
+                    reader->t_status = ABORTED;
+                    serializationFailures.fetch_add(1);
+                }
             }
         }
     }
@@ -164,11 +537,15 @@ public:
     }
 
     bool commit(int txID) {
-        std::lock_guard<std::mutex> lk(dataMutex);
-        auto* txn = transactions[txID];
+        PerfLockGuard lk(dataMutex);
+        auto* txn = lookup(txID);
 
         // Check if transaction is still valid
+        if (!txn) {
+            return false; // Already finished, context recycled
+        }
         if (txn->t_status == ABORTED) {
+            release(txn);
             return false; // Transaction already aborted
         }
 
@@ -178,17 +555,27 @@ public:
         int commit_ts = globalTS.fetch_add(1);
         txn->t_cstamp = commit_ts;
 
-        // 3. Check exclusion window
+        // 3. Untracked reads: an overwriter could not reach us, so apply what
+        // update_version_timestamps() would have done
+        for (const auto& r : txn->untrackedReads) {
+            if (latest[r.first]->t_cstamp != r.second) {
+                lower_s_pstamp(txn, r.second);
+            }
+        }
+
+        // 4. Check exclusion window
         if (!validateSSN(txn)) {
             txn->t_status = ABORTED;
+            serializationFailures.fetch_add(1);
+            release(txn);
             return false; // Abort due to serializability violation
         }
 
-        // 4. Check for write-write conflicts (basic SI)
-        for (int index : txn->t_writes) {
-            Version* latest = versionChain[index].back();
-            if (latest->t_cstamp > txn->start_ts) {
+        // 5. Check for write-write conflicts (basic SI)
+        for (const auto& w : txn->t_writes) {
+            if (latest[w.first]->t_cstamp > txn->start_ts) {
                 txn->t_status = ABORTED;
+                release(txn);
                 return false; // Write-write conflict
             }
         }
@@ -197,46 +584,53 @@ public:
         txn->t_status = COMMITTED;
 
         // Create new versions for each written item
-        for (int index : txn->t_writes) {
-            Version* oldVersion = versionChain[index].back();
-            Version* newVersion = new Version{
-                txn->writeValues[index],  // value
-                txn->t_cstamp,           // t_cstamp
-                0,                       // r_pstamp (initialized to 0)
-                INT_MAX,                 // s_pstamp (initialized to ∞)
-                oldVersion->t_cstamp,    // v_pstamp = commit timestamp of overwritten version
-                oldVersion               // v_prev points to overwritten version
-            };
-
-            versionChain[index].push_back(newVersion);
+        for (const auto& w : txn->t_writes) {
+            Version* version = newVersion(
+                w.first,
+                w.second,                  // value
+                txn->t_cstamp,             // t_cstamp
+                latest[w.first]->t_cstamp  // v_pstamp = commit timestamp of overwritten version
+            );
+
+            // Update version timestamps and retire the overwritten version
+            installVersion(w.first, version);
+        }
 
-            // Update version timestamps
-            update_version_timestamps(oldVersion);
+        if (commitLog && !txn->t_writes.empty()) {
+            commitLog->append(commit_ts, txn->t_writes);
         }
 
+        release(txn);
+        relieveMemory();
         return true;
     }
 
-    void abort(int txID) {
-        std::lock_guard<std::mutex> lk(dataMutex);
-        auto* txn = transactions[txID];
-        txn->t_status = ABORTED;
+    // Lets the caller stop issuing operations for a doomed transaction.
+    // A finished (recycled) handle is reported as aborted: it is no longer usable.
+    bool isAborted(int txID) {
+        PerfLockGuard lk(dataMutex);
+        auto* txn = lookup(txID);
+        return !txn || txn->t_status == ABORTED;
     }
 
-    // Clean up memory for completed transactions
-    void cleanup() {
-        std::lock_guard<std::mutex> lk(dataMutex);
-        std::vector<int> toRemove;
+    // Aborts caused by SSN itself rather than by a write-write conflict;
+    // an upper bound on false-positive aborts
+    long long serializationAborts() const {
+        return serializationFailures.load();
+    }
 
-        for (auto& [id, txn] : transactions) {
-            if (txn->t_status != IN_FLIGHT) {
-                toRemove.push_back(id);
-            }
-        }
+    // Reads that found every reader slot of their version taken and were
+    // checked at commit instead; they cause no aborts of their own
+    long long untrackedReads() const {
+        return untrackedReadCount.load();
+    }
 
-        for (int id : toRemove) {
-            delete transactions[id];
-            transactions.erase(id);
+    void abort(int txID) {
+        PerfLockGuard lk(dataMutex);
+        auto* txn = lookup(txID);
+        if (txn) {
+            txn->t_status = ABORTED;
+            release(txn);
         }
     }
 };
\ No newline at end of file
@@ -114,3 +114,314 @@ TEST(SnapshotIsolationTest, WriteWriteConflictShouldAbort) {
     ASSERT_TRUE(manager.commit(tx1));
     ASSERT_FALSE(manager.commit(tx2));
 }
+
+// ✅ Test: Abort discards buffered writes and conflicts with nothing
+TEST(SnapshotIsolationTest, AbortDiscardsWrites) {
+    SnapshotIsolationManager manager(1);
+
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 10);
+    manager.abort(tx1);
+
+    manager.write(tx2, 0, 20);
+    ASSERT_TRUE(manager.commit(tx2));
+
+    int tx3 = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx3, 0), 20);
+}
+
+// ✅ Test: Concurrent increments to the same key both commit and both count
+TEST(SnapshotIsolationTest, ConcurrentAddsCommute) {
+    SnapshotIsolationManager manager(1);
+
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.add(tx1, 0, 5);
+    manager.add(tx2, 0, 7);
+    ASSERT_EQ(manager.read(tx1, 0), 5); // own pending increment
+
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_TRUE(manager.commit(tx2));
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 12);
+}
+
+// ✅ Test: An increment still conflicts with a concurrent full write
+TEST(SnapshotIsolationTest, WriteAfterConcurrentAddAborts) {
+    SnapshotIsolationManager manager(1);
+
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.add(tx1, 0, 5);
+    manager.write(tx2, 0, 100);
+
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_FALSE(manager.commit(tx2));
+}
+
+// ✅ Test: An increment over a concurrent full write aborts too
+TEST(SnapshotIsolationTest, AddAfterConcurrentWriteAborts) {
+    SnapshotIsolationManager manager(1);
+
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.add(tx1, 0, 1);
+    manager.write(tx2, 0, 5);
+
+    ASSERT_TRUE(manager.commit(tx2));
+    ASSERT_FALSE(manager.commit(tx1));
+    ASSERT_EQ(manager.readAsOf(0, manager.currentTimestamp()), 5);
+}
+
+// ✅ Test: Increments keep commuting across a consolidated version
+TEST(SnapshotIsolationTest, ConcurrentAddsCommuteAcrossConsolidation) {
+    SnapshotIsolationManager manager(1);
+    int slow = manager.beginTrans();
+    manager.add(slow, 0, 1000);
+    for (int i = 0; i < 2 * CONSOLIDATE_DELTAS; ++i) {
+        int tx = manager.beginTrans();
+        manager.add(tx, 0, 1);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_TRUE(manager.commit(slow));
+    ASSERT_EQ(manager.readAsOf(0, manager.currentTimestamp()), 1000 + 2 * CONSOLIDATE_DELTAS);
+}
+
+// ✅ Test: Consolidated delta chains keep every snapshot's value
+TEST(SnapshotIsolationTest, DeltaConsolidationPreservesSnapshots) {
+    SnapshotIsolationManager manager(1);
+
+    int old = manager.beginTrans();
+    manager.read(old, 0);
+    for (int i = 0; i < 3 * CONSOLIDATE_DELTAS + 1; ++i) {
+        int tx = manager.beginTrans();
+        manager.add(tx, 0, 1);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 3 * CONSOLIDATE_DELTAS + 1);
+    ASSERT_EQ(manager.read(old, 0), 0);
+}
+
+// ✅ Test: AS OF reads return the value committed at each past timestamp
+TEST(SnapshotIsolationTest, ReadAsOfReturnsHistory) {
+    SnapshotIsolationManager manager(1);
+
+    std::vector<int> stamps;
+    for (int v = 1; v <= 100; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+        stamps.push_back(manager.currentTimestamp());
+    }
+
+    ASSERT_EQ(manager.readAsOf(0, 0), 0);
+    for (int v = 1; v <= 100; ++v) {
+        ASSERT_EQ(manager.readAsOf(0, stamps[v - 1]), v);
+    }
+}
+
+// ✅ Test: A transaction begun in the past sees that snapshot of every key
+TEST(SnapshotIsolationTest, BeginAtSeesPastSnapshot) {
+    SnapshotIsolationManager manager(2);
+
+    int tx1 = manager.beginTrans();
+    manager.write(tx1, 0, 10);
+    manager.write(tx1, 1, 20);
+    ASSERT_TRUE(manager.commit(tx1));
+    int before = manager.currentTimestamp();
+
+    int tx2 = manager.beginTrans();
+    manager.write(tx2, 0, 11);
+    manager.add(tx2, 1, 1);
+    ASSERT_TRUE(manager.commit(tx2));
+
+    int audit = manager.beginAt(before);
+    ASSERT_EQ(manager.read(audit, 0), 10);
+    ASSERT_EQ(manager.read(audit, 1), 20);
+
+    // Writing a key that changed since the snapshot cannot commit
+    manager.write(audit, 0, 99);
+    ASSERT_FALSE(manager.commit(audit));
+}
+
+// ✅ Test: The commit log carries write sets in commit order, increments folded
+TEST(SnapshotIsolationTest, CommitLogShipsResultingValues) {
+    SnapshotIsolationManager manager(2);
+    CommitLog log;
+    manager.attachCommitLog(&log);
+
+    int tx1 = manager.beginTrans();
+    manager.write(tx1, 0, 5);
+    ASSERT_TRUE(manager.commit(tx1));
+    int tx2 = manager.beginTrans();
+    manager.add(tx2, 0, 3);
+    manager.write(tx2, 1, 7);
+    ASSERT_TRUE(manager.commit(tx2));
+    int reader = manager.beginTrans();
+    manager.read(reader, 0);
+    ASSERT_TRUE(manager.commit(reader)); // Nothing written, nothing shipped
+
+    std::vector<CommitRecord> records;
+    log.readFrom(0, records, std::chrono::milliseconds(0), 10);
+    ASSERT_EQ(records.size(), 2u);
+    ASSERT_LT(records[0].ts, records[1].ts);
+    auto writes = records[1].writes;
+    std::sort(writes.begin(), writes.end());
+    ASSERT_EQ(writes, (std::vector<std::pair<int, int>>{ { 0, 8 }, { 1, 7 } }));
+}
+
+// ✅ Test: Under a memory budget, versions no snapshot can see are collected
+TEST(SnapshotIsolationTest, MemoryBudgetCollectsUnseenVersions) {
+    SnapshotIsolationManager manager(4);
+    MemoryBudget budget;
+    budget.limitBytes = manager.memoryStats().total + 16 * 1024;
+    budget.abortOldest = false;
+    budget.throttle = false;
+    manager.setMemoryBudget(budget);
+
+    int old = manager.beginTrans();
+    for (int v = 1; v <= 5000; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_EQ(manager.read(old, 0), 0);     // Its version survived collection
+    ASSERT_TRUE(manager.commit(old));
+
+    int tx = manager.beginTrans();
+    manager.write(tx, 1, 1);
+    ASSERT_TRUE(manager.commit(tx));
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 5000);
+    MemoryStats stats = manager.memoryStats();
+    ASSERT_GT(stats.gcRuns, 0);
+    ASSERT_GT(stats.versionsReclaimed, 4000);
+    ASSERT_LE(stats.total, budget.limitBytes);
+}
+
+// ✅ Test: A snapshot pinning too many versions is aborted to stay within budget
+TEST(SnapshotIsolationTest, MemoryBudgetShedsOldestSnapshot) {
+    SnapshotIsolationManager manager(4);
+    MemoryBudget budget;
+    budget.limitBytes = manager.memoryStats().total + 16 * 1024;
+    budget.throttle = false;
+    manager.setMemoryBudget(budget);
+
+    int old = manager.beginTrans();
+    ASSERT_EQ(manager.read(old, 0), 0);
+    for (int v = 1; v <= 5000; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_TRUE(manager.isAborted(old));
+    ASSERT_EQ(manager.read(old, 0), -1);
+    ASSERT_FALSE(manager.commit(old));
+    ASSERT_FALSE(manager.isAborted(old));   // Finished now
+    MemoryStats stats = manager.memoryStats();
+    ASSERT_EQ(stats.budgetAborts, 1);
+    ASSERT_LE(stats.total, budget.limitBytes);
+}
+
+// ✅ Test: Throttled begins fail without blocking, and time travel waits like any begin
+TEST(SnapshotIsolationTest, ThrottledBeginsDoNotBlock) {
+    SnapshotIsolationManager manager(4);
+    MemoryBudget budget;
+    budget.limitBytes = 1;              // Always over budget
+    budget.abortOldest = false;
+    manager.setMemoryBudget(budget);
+
+    int open = manager.beginTrans();    // Nothing running, so nothing to wait for
+    ASSERT_EQ(manager.tryBeginTrans(), -1);
+    std::atomic<bool> started{ false };
+    std::thread traveller([&] {
+        ASSERT_TRUE(manager.commit(manager.beginAt(0)));
+        started = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(started);
+    ASSERT_TRUE(manager.commit(open));
+    traveller.join();
+    ASSERT_EQ(manager.memoryStats().throttledBegins, 1);
+
+    int next = manager.tryBeginTrans();
+    ASSERT_GE(next, 0);
+    ASSERT_TRUE(manager.commit(next));
+}
+
+// ✅ Test: Finished transactions give back the state they were charged for
+TEST(SnapshotIsolationTest, MemoryAccountingReturnsTransactionState) {
+    SnapshotIsolationManager manager(8);
+    auto run = [&](int count) {
+        for (int i = 0; i < count; ++i) {
+            int tx = manager.beginTrans();
+            manager.write(tx, i % 8, i);
+            manager.add(tx, (i + 1) % 8, 1);
+            manager.read(tx, (i + 2) % 8);
+            if (i % 2) {
+                manager.commit(tx);
+            }
+            else {
+                manager.abort(tx);
+            }
+        }
+    };
+    run(100);
+    MemoryStats before = manager.memoryStats();
+    run(1000);
+    MemoryStats after = manager.memoryStats();
+    ASSERT_EQ(after.bytes[MEM_TX_STATE], before.bytes[MEM_TX_STATE]);
+    ASSERT_GE(after.bytes[MEM_VERSIONS] - before.bytes[MEM_VERSIONS], (long long)(1000 * sizeof(Version)));
+}
+
+// ✅ Test: Version statistics count chains and the garbage an open snapshot pins
+TEST(SnapshotIsolationTest, VersionStatsReportBacklog) {
+    SnapshotIsolationManager manager(4);
+    int old = manager.beginTrans();
+    ASSERT_EQ(manager.read(old, 0), 0);
+    for (int v = 1; v <= 5; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    VersionStats stats = manager.versionStats();
+    ASSERT_EQ(stats.keys, 4);
+    ASSERT_EQ(stats.versions, 9);
+    ASSERT_EQ(stats.longestChain, 6);
+    ASSERT_EQ(stats.gcBacklog, 0);  // The old snapshot still sees the first version
+
+    ASSERT_TRUE(manager.commit(old));
+    ASSERT_EQ(manager.versionStats().gcBacklog, 5);
+}
+
+// ✅ Test: Version statistics follow collection and sample the backlog of many keys
+TEST(SnapshotIsolationTest, VersionStatsTrackCollection) {
+    const int keys = 4096;
+    SnapshotIsolationManager manager(keys);
+    int old = manager.beginTrans();
+    for (int index = 0; index < keys; ++index) {
+        int tx = manager.beginTrans();
+        manager.write(tx, index, index + 1);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_TRUE(manager.commit(old));
+    VersionStats stats = manager.versionStats();
+    ASSERT_EQ(stats.versions, 2 * keys);
+    ASSERT_EQ(stats.longestChain, 2);
+    ASSERT_EQ(stats.gcBacklog, keys);   // Every key has one collectable version
+
+    MemoryBudget budget;
+    budget.limitBytes = 1;              // Collect at the next begin
+    budget.abortOldest = false;
+    budget.throttle = false;
+    manager.setMemoryBudget(budget);
+    ASSERT_TRUE(manager.commit(manager.beginTrans()));
+    stats = manager.versionStats();
+    ASSERT_EQ(stats.versions, keys);
+    ASSERT_EQ(stats.longestChain, 1);
+    ASSERT_EQ(stats.gcBacklog, 0);
+}
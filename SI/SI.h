@@ -6,10 +6,24 @@
 #include <mutex>
 #include <atomic>
 #include <thread>
+#include <algorithm>
+#include <iterator>
+#include <climits>
+#include <chrono>
+
+#include "../common/perf.h"
+#include "../common/commitlog.h"
+#include "../common/memory.h"
+
+// Every CONSOLIDATE_DELTAS-th delta in a row is stored as a full value,
+// so a read folds at most that many delta versions
+constexpr int CONSOLIDATE_DELTAS = 16;
 
 struct Version {
     int value;
     int commit_ts;
+    bool delta = false;     // value is an increment on top of the previous version
+    bool consolidated = false;  // Full value an increment folded its deltas into
 };
 
 class SnapshotIsolationManager {
@@ -21,64 +35,418 @@ private:
     std::unordered_map<int, std::vector<Version>> versionChain;
     std::unordered_map<int, int> txStartTimestamps;
     std::unordered_map<int, std::unordered_map<int, int>> txLocalViews;
+    std::unordered_map<int, std::unordered_map<int, int>> txLocalDeltas; // Blind increments not yet committed
+    std::unordered_set<int> txShed;     // Aborted to free memory, until the owner commits or aborts
+    CommitLog* commitLog = nullptr; // Replication stream, if any
+    MemoryGovernor memory;
+    int reclaimedTS = 0;                // History before it has been collected
+    ChainLengths chainLengths;
+    long long statsOffset = 0;          // Where the next backlog sample starts
+
+    // Value of index as of ts: the newest full value plus the deltas above it.
+    // Chains are in commit order, so the visible version is found by binary
+    // search and old snapshots cost O(log chain length).
+    int snapshotValue(int index, int ts) {
+        const auto& chain = versionChain[index];
+        auto visible = std::upper_bound(chain.begin(), chain.end(), ts,
+            [](int t, const Version& v) { return t < v.commit_ts; });
+        auto it = std::make_reverse_iterator(visible);
+        int value = 0;
+        for (; it != chain.rend(); ++it) {
+            value += it->value;
+            if (!it->delta) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    // Number of delta versions at the head of the chain
+    int trailingDeltas(int index) {
+        const auto& chain = versionChain[index];
+        int count = 0;
+        for (auto it = chain.rbegin(); it != chain.rend() && it->delta; ++it) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Bytes of the transaction tables plus txID's buffered writes
+    long long txStateBytes(int txID) {
+        long long bytes = containerBytes(txStartTimestamps) + containerBytes(txLocalViews)
+            + containerBytes(txLocalDeltas) + containerBytes(txShed);
+        auto view = txLocalViews.find(txID);
+        if (view != txLocalViews.end()) {
+            bytes += containerBytes(view->second);
+        }
+        auto deltas = txLocalDeltas.find(txID);
+        if (deltas != txLocalDeltas.end()) {
+            bytes += containerBytes(deltas->second);
+        }
+        return bytes;
+    }
+
+    // Charges whatever the enclosing operation did to txID's state
+    struct TxStateCharge {
+        SnapshotIsolationManager& manager;
+        int txID;
+        long long before;
+        TxStateCharge(SnapshotIsolationManager& manager, int txID)
+            : manager(manager), txID(txID), before(manager.txStateBytes(txID)) {}
+        ~TxStateCharge() {
+            manager.memory.account.recharge(MEM_TX_STATE, before, manager.txStateBytes(txID));
+        }
+    };
+
+    // Append to a chain, charging any growth of its storage
+    void appendVersion(int index, const Version& v) {
+        auto& chain = versionChain[index];
+        long long before = containerBytes(chain);
+        chain.push_back(v);
+        chainLengths.resized(chain.size() - 1, chain.size());
+        memory.account.recharge(MEM_VERSIONS, before, containerBytes(chain));
+    }
+
+    // Caller holds dataMutex
+    void forget(int txID) {
+        TxStateCharge charge(*this, txID);
+        txLocalViews.erase(txID);
+        txLocalDeltas.erase(txID);
+        txStartTimestamps.erase(txID);
+    }
+
+    // Oldest snapshot still in use; versions it cannot see are garbage
+    int horizon() {
+        int oldest = globalTS.load() - 1;
+        for (const auto& [txID, ts] : txStartTimestamps) {
+            oldest = std::min(oldest, ts);
+        }
+        return oldest;
+    }
+
+    // Versions of chain older than the one visible at h, or than the full
+    // value its deltas build on: nothing can read them any more
+    static size_t collectable(const std::vector<Version>& chain, int h) {
+        if (chain.size() <= 1) {
+            return 0;
+        }
+        auto visible = std::upper_bound(chain.begin(), chain.end(), h,
+            [](int t, const Version& v) { return t < v.commit_ts; });
+        if (visible == chain.begin()) {
+            return 0;
+        }
+        auto base = std::prev(visible);
+        while (base != chain.begin() && base->delta) {
+            --base;
+        }
+        return base - chain.begin();
+    }
+
+    // Drop every collectable version and give back the freed storage
+    void collectVersions() {
+        int h = horizon();
+        long long reclaimed = 0, pinned = 0;
+        for (auto& [index, chain] : versionChain) {
+            if (chain.size() > 1) {
+                size_t garbage = collectable(chain, h);
+                long long before = containerBytes(chain);
+                reclaimed += garbage;
+                chain.erase(chain.begin(), chain.begin() + garbage);
+                chainLengths.resized(chain.size() + garbage, chain.size());
+                if (chain.capacity() > 2 * chain.size() + 8) {
+                    chain.shrink_to_fit();
+                }
+                memory.account.recharge(MEM_VERSIONS, before, containerBytes(chain));
+            }
+            // Versions below the newest full one serve snapshots only
+            for (size_t i = chain.size() - 1; i > 0; --i) {
+                if (!chain[i].delta) {
+                    pinned += i;
+                    break;
+                }
+            }
+        }
+        reclaimedTS = std::max(reclaimedTS, h);
+        memory.collected(reclaimed, pinned, h);
+    }
+
+    // Abort the transaction with the oldest snapshot; false if there is none
+    bool shedOldest() {
+        int victim = -1, oldest = INT_MAX;
+        for (const auto& [txID, ts] : txStartTimestamps) {
+            if (ts < oldest) {
+                oldest = ts;
+                victim = txID;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+        forget(victim);
+        {
+            TxStateCharge charge(*this, victim);
+            txShed.insert(victim);
+        }
+        memory.budgetAborts.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Escalation steps 1 and 2 of common/memory.h; caller holds dataMutex
+    void relieveMemory() {
+        if (memory.wantsCollection([this] { return horizon(); })) {
+            collectVersions();
+        }
+        if (memory.shouldShed() && shedOldest()) {
+            collectVersions();
+        }
+    }
+
+    // Start a transaction with snapshot asOf (clamped to the past), or a
+    // fresh timestamp if asOf < 0; -1 while memory is over budget and
+    // running transactions may still free some (step 3)
+    int startTransaction(int asOf) {
+        PerfLockGuard lk(dataMutex);
+        if (memory.shouldThrottle() && !txStartTimestamps.empty()) {
+            return -1;
+        }
+        int txID = nextTxID.fetch_add(1);
+        {
+            TxStateCharge charge(*this, txID);
+            txStartTimestamps[txID] = asOf < 0 ? globalTS.fetch_add(1)
+                : std::max(reclaimedTS, std::min(asOf, globalTS.load() - 1));
+            txLocalViews[txID] = {};
+        }
+        relieveMemory();
+        return txID;
+    }
+
+    // Start a transaction, waiting while memory is throttled; the first
+    // wait is counted
+    int startWaiting(int asOf) {
+        bool counted = false;
+        int txID;
+        while ((txID = startTransaction(asOf)) < 0) {
+            if (!counted) {
+                memory.throttledBegins.fetch_add(1, std::memory_order_relaxed);
+                counted = true;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        return txID;
+    }
+
+    // A shed transaction stays aborted until its owner finishes it
+    bool shed(int txID) {
+        return !txShed.empty() && txShed.count(txID) > 0;
+    }
+
+    // Owner finished a shed transaction; caller holds dataMutex
+    void unshed(int txID) {
+        if (shed(txID)) {
+            TxStateCharge charge(*this, txID);
+            txShed.erase(txID);
+        }
+    }
 
 public:
     SnapshotIsolationManager(int m) {
         for (int i = 0; i < m; ++i) {
             versionChain[i] = { {0, 0} };
+            chainLengths.added(1);
+            memory.account.charge(MEM_VERSIONS, containerBytes(versionChain[i]));
         }
+        memory.account.charge(MEM_INDEX, containerBytes(versionChain));
+        memory.account.charge(MEM_TX_STATE, txStateBytes(0));
     }
 
     int beginTrans() {
-        int txID = nextTxID.fetch_add(1);
-        int ts = globalTS.fetch_add(1);
-        txStartTimestamps[txID] = ts;
-        txLocalViews[txID] = {};
-        return txID;
+        return startWaiting(-1);
+    }
+
+    // Non-blocking begin: -1 if new transactions are being held back for
+    // memory. Lets a caller that multiplexes clients on one thread run the
+    // transactions that have to finish first.
+    int tryBeginTrans() {
+        return startTransaction(-1);
+    }
+
+    // Time travel: a transaction whose snapshot is the database as of an
+    // earlier timestamp (clamped to the past). Meant for reading history;
+    // a write aborts at commit if the key changed after ts. It pins old
+    // versions like any snapshot, so it waits for memory the same way.
+    int beginAt(int ts) {
+        return startWaiting(std::max(0, ts));
+    }
+
+    // Committed value of index as of ts, without a transaction. Under a
+    // memory budget, history older than the collected horizon is gone and
+    // such reads see the oldest retained state.
+    int readAsOf(int index, int ts) {
+        PerfLockGuard lk(dataMutex);
+        return snapshotValue(index, std::max(ts, reclaimedTS));
+    }
+
+    // Bound the memory of versions and transaction state (see
+    // common/memory.h); a zero limit turns reclamation off
+    void setMemoryBudget(const MemoryBudget& budget) {
+        PerfLockGuard lk(dataMutex);
+        memory.setBudget(budget);
+    }
+
+    MemoryStats memoryStats() const {
+        return memory.stats();
+    }
+
+    // Chain lengths, kept up to date by every append and collection, and
+    // uncollected garbage estimated from a sample of the chains
+    VersionStats versionStats() {
+        PerfLockGuard lk(dataMutex);
+        VersionStats stats;
+        int h = horizon();
+        stats.keys = (long long)versionChain.size();
+        stats.versions = chainLengths.versions();
+        stats.longestChain = chainLengths.longestChain();
+        stats.gcBacklog = sampledTotal(stats.keys, statsOffset, [&](long long index) {
+            auto chain = versionChain.find((int)index);
+            return chain != versionChain.end() ? (long long)collectable(chain->second, h) : 0LL;
+        });
+        return stats;
+    }
+
+    // Set while the transaction was aborted to free memory
+    bool isAborted(int txID) {
+        PerfLockGuard lk(dataMutex);
+        return shed(txID);
+    }
+
+    // Append the write set of every later commit to log
+    void attachCommitLog(CommitLog* log) {
+        PerfLockGuard lk(dataMutex);
+        commitLog = log;
+    }
+
+    // Latest timestamp handed out; every commit up to it is visible
+    int currentTimestamp() {
+        PerfLockGuard lk(dataMutex);
+        return globalTS.load() - 1;
     }
 
     int read(int txID, int index) {
+        PerfLockGuard lk(dataMutex);
+        auto start = txStartTimestamps.find(txID);
+        if (start == txStartTimestamps.end()) {
+            return -1; // Finished, or shed to free memory
+        }
         auto& localView = txLocalViews[txID];
         if (localView.find(index) != localView.end()) {
             return localView[index];
         }
 
-        int start_ts = txStartTimestamps[txID];
-        std::lock_guard<std::mutex> lk(dataMutex);
-        for (auto it = versionChain[index].rbegin(); it != versionChain[index].rend(); ++it) {
-            if (it->commit_ts <= start_ts) {
-                return it->value;
-            }
+        int value = snapshotValue(index, start->second);
+        auto deltas = txLocalDeltas.find(txID);
+        if (deltas == txLocalDeltas.end()) {
+            return value;
         }
-        return 0; // fallback
+        auto delta = deltas->second.find(index);
+        return delta != deltas->second.end() ? value + delta->second : value;
     }
 
     void write(int txID, int index, int val) {
+        PerfLockGuard lk(dataMutex);
+        if (!txStartTimestamps.count(txID)) {
+            return;
+        }
+        TxStateCharge charge(*this, txID);
         txLocalViews[txID][index] = val;
+        auto deltas = txLocalDeltas.find(txID);
+        if (deltas != txLocalDeltas.end()) {
+            deltas->second.erase(index); // A full write supersedes our pending increments
+        }
     }
 
-    bool commit(int txID) {
-        int start_ts = txStartTimestamps[txID];
+    // Blind increment: commutes with other increments, so concurrent adds to
+    // the same key never conflict; a full write committed on either side
+    // after the other's snapshot does
+    void add(int txID, int index, int delta) {
+        PerfLockGuard lk(dataMutex);
+        if (!txStartTimestamps.count(txID)) {
+            return;
+        }
+        TxStateCharge charge(*this, txID);
         auto& localView = txLocalViews[txID];
+        auto written = localView.find(index);
+        if (written != localView.end()) {
+            written->second += delta;
+        }
+        else {
+            txLocalDeltas[txID][index] += delta;
+        }
+    }
 
-        std::lock_guard<std::mutex> lk(dataMutex);
+    bool commit(int txID) {
+        PerfLockGuard lk(dataMutex);
+        auto start = txStartTimestamps.find(txID);
+        if (start == txStartTimestamps.end()) {
+            unshed(txID);
+            return false;
+        }
+        int start_ts = start->second;
+        auto& localView = txLocalViews[txID];
+        static const std::unordered_map<int, int> noDeltas;
+        auto deltas = txLocalDeltas.find(txID);
+        const auto& localDeltas = deltas != txLocalDeltas.end() ? deltas->second : noDeltas;
 
-        // Conflict check
+        // Conflict check; the newest version has the largest commit
+        // timestamp. A write conflicts with any later version, an increment
+        // only with a later full write.
         for (const auto& [index, _] : localView) {
-            for (const auto& v : versionChain[index]) {
-                if (v.commit_ts > start_ts) {
-                    return false; // write-write conflict
+            const auto& chain = versionChain[index];
+            if (!chain.empty() && chain.back().commit_ts > start_ts) {
+                forget(txID);
+                return false; // write-write conflict
+            }
+        }
+        for (const auto& [index, _] : localDeltas) {
+            const auto& chain = versionChain[index];
+            for (auto it = chain.rbegin(); it != chain.rend() && it->commit_ts > start_ts; ++it) {
+                if (!it->delta && !it->consolidated) {
+                    forget(txID);
+                    return false; // increment over a concurrent full write
                 }
             }
         }
 
         int commit_ts = globalTS.fetch_add(1);
         for (const auto& [index, val] : localView) {
-            versionChain[index].push_back({ val, commit_ts });
+            appendVersion(index, { val, commit_ts });
+        }
+        for (const auto& [index, delta] : localDeltas) {
+            if (trailingDeltas(index) + 1 >= CONSOLIDATE_DELTAS) {
+                appendVersion(index, { snapshotValue(index, commit_ts) + delta, commit_ts, false, true });
+            }
+            else {
+                appendVersion(index, { delta, commit_ts, true });
+            }
         }
 
-        txLocalViews.erase(txID);
-        txStartTimestamps.erase(txID);
+        // Ship resulting values, so followers need not fold deltas
+        if (commitLog && (!localView.empty() || !localDeltas.empty())) {
+            std::vector<std::pair<int, int>> writes(localView.begin(), localView.end());
+            for (const auto& [index, _] : localDeltas) {
+                writes.push_back({ index, snapshotValue(index, commit_ts) });
+            }
+            commitLog->append(commit_ts, std::move(writes));
+        }
+
+        forget(txID);
+        relieveMemory();
         return true;
     }
+
+    // Drop a transaction's buffered writes without installing them
+    void abort(int txID) {
+        PerfLockGuard lk(dataMutex);
+        unshed(txID);
+        forget(txID);
+    }
 };
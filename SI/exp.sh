@@ -1,12 +1,12 @@
 #!/bin/bash
 
 # Script to run SI experiments with varying threads and read ratios
-# Experiment 1: Vary threads from 2 to 32, keep read ratio constant
+# Experiment 1: Vary threads from 2 to 64, keep read ratio constant
 # Experiment 2: Keep threads constant at 8, vary read ratio from 0.1 to 0.9
 
 # Compilation (adjust compiler flags as needed)
 echo "Compiling the program..."
-g++ -std=c++17 -pthread -o si_experiment main.cpp
+g++ -std=c++17 -O2 -pthread -o a.out SI-run.cc
 
 # Constants for experiments
 M=1000           # Number of data items
@@ -40,17 +40,18 @@ run_experiment() {
     # Extract key metrics for summary
     commits_per_sec=$(grep "Commits per second" si_result.txt | awk '{print $4}')
     aborts_per_sec=$(grep "Aborts per second" si_result.txt | awk '{print $4}')
+    ser_aborts_per_sec=$(grep "Serial. aborts per second" si_result.txt | awk '{print $5}')
     
-    echo "$threads,$read_ratio,$commits_per_sec,$aborts_per_sec" >> "$output_dir/summary.csv"
+    echo "$threads,$read_ratio,$commits_per_sec,$aborts_per_sec,$ser_aborts_per_sec" >> "$output_dir/summary.csv"
 }
 
 # Experiment 1: Varying threads
-echo "Starting Experiment 1: Varying thread counts from 2 to 32"
+echo "Starting Experiment 1: Varying thread counts from 2 to 64"
 exp1_dir="experiment_vary_threads"
 mkdir -p "$exp1_dir"
-echo "threads,read_ratio,commits_per_sec,aborts_per_sec" > "$exp1_dir/summary.csv"
+echo "threads,read_ratio,commits_per_sec,aborts_per_sec,ser_aborts_per_sec" > "$exp1_dir/summary.csv"
 
-for threads in 2 4 8 16 24 32; do
+for threads in 2 4 8 16 24 32 48 64; do
     run_experiment $threads $DEFAULT_READ_RATIO "$exp1_dir"
 done
 
@@ -58,7 +59,7 @@ done
 echo "Starting Experiment 2: Varying read ratios from 0.1 to 0.9"
 exp2_dir="experiment_vary_readratio"
 mkdir -p "$exp2_dir"
-echo "threads,read_ratio,commits_per_sec,aborts_per_sec" > "$exp2_dir/summary.csv"
+echo "threads,read_ratio,commits_per_sec,aborts_per_sec,ser_aborts_per_sec" > "$exp2_dir/summary.csv"
 
 for read_ratio in 0.1 0.3 0.5 0.7 0.9; do
     run_experiment 8 $read_ratio "$exp2_dir"
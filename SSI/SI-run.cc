@@ -0,0 +1,6 @@
+#include "SSI.h"
+#include "../common/driver.h"
+
+int main(int argc, char** argv) {
+    return runDriver<SerializableSIManager>(argc, argv, "SSI");
+}
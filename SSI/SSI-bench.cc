@@ -0,0 +1,6 @@
+#include "SSI.h"
+#include "../common/microbench.h"
+
+ENGINE_BENCHMARKS(SerializableSIManager);
+
+BENCHMARK_MAIN();
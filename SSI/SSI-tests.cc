@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "SSI.h"
+
+// ✅ Test: Read-only transactions always commit
+TEST(SerializableSITest, ReadOnlyAlwaysCommits) {
+    SerializableSIManager manager(1);
+    int tx = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx, 0), 0);
+    ASSERT_TRUE(manager.commit(tx));
+}
+
+// ✅ Test: Writers on different keys should not abort
+TEST(SerializableSITest, DisjointWritesNoAbort) {
+    SerializableSIManager manager(2);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 100);
+    manager.write(tx2, 1, 200);
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_TRUE(manager.commit(tx2));
+}
+
+// ✅ Test: Write-write conflict must abort one, and is not a serialization abort
+TEST(SerializableSITest, ConflictingWritesMustAbort) {
+    SerializableSIManager manager(1);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 111);
+    manager.write(tx2, 0, 222);
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_FALSE(manager.commit(tx2));
+    ASSERT_EQ(manager.serializationAborts(), 0);
+}
+
+// ✅ Test: Classic write skew — the pivot's partner must abort
+TEST(SerializableSITest, WriteSkewShouldBeAborted) {
+    SerializableSIManager manager(2);
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+
+    manager.read(tx1, 0);
+    manager.write(tx1, 1, 1);
+    manager.read(tx2, 1);
+    manager.write(tx2, 0, 1);
+
+    bool c1 = manager.commit(tx1);
+    bool c2 = manager.commit(tx2);
+    EXPECT_FALSE(c1 && c2) << "SSI should prevent both tx1 and tx2 from committing due to write skew.";
+    ASSERT_EQ(manager.serializationAborts(), 1);
+}
+
+// ✅ Test: Reading an item a committed concurrent pivot overwrote aborts early
+TEST(SerializableSITest, ReadAfterCommittedPivotAborts) {
+    SerializableSIManager manager(3);
+    int reader = manager.beginTrans();   // will read y after pivot overwrote it
+    int pivot = manager.beginTrans();
+    int last = manager.beginTrans();
+
+    manager.read(pivot, 0);              // pivot -rw-> last (last overwrites x)
+    manager.write(pivot, 1, 5);
+    manager.write(last, 0, 7);
+    ASSERT_TRUE(manager.commit(last));
+    ASSERT_TRUE(manager.commit(pivot));  // only an outgoing conflict so far
+
+    // reader -rw-> pivot would give the committed pivot an incoming one too
+    ASSERT_EQ(manager.read(reader, 1), -1);
+    ASSERT_TRUE(manager.isAborted(reader));
+    ASSERT_FALSE(manager.commit(reader));
+}
+
+// ✅ Test: Ignore uncommitted writes from others
+TEST(SerializableSITest, UncommittedWriteInvisible) {
+    SerializableSIManager manager(1);
+    int tx1 = manager.beginTrans();
+    manager.write(tx1, 0, 123);
+
+    int tx2 = manager.beginTrans();
+    ASSERT_EQ(manager.read(tx2, 0), 0);
+    ASSERT_TRUE(manager.commit(tx2));
+    ASSERT_TRUE(manager.commit(tx1));
+}
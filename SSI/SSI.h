@@ -0,0 +1,234 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <climits>
+#include <algorithm>
+
+#include "../common/perf.h"
+
+// Serializable Snapshot Isolation after Cahill et al. (SIGMOD'08), the
+// scheme PostgreSQL's SSI is based on. It keeps SI.h's version store and
+// adds SIREAD markers plus inConflict/outConflict flags per transaction:
+// a transaction with both an incoming and an outgoing rw-antidependency
+// may be the pivot of a cycle and is aborted.
+
+struct SSIVersion {
+    int value;
+    int commit_ts;
+    int writer;     // txID that installed this version
+};
+
+struct SSITransaction {
+    int start_ts;
+    int commit_ts = INT_MAX;   // INT_MAX while the transaction is active
+    bool committed = false;
+    bool aborted = false;
+    bool inConflict = false;   // a concurrent reader read what we overwrite
+    bool outConflict = false;  // we read something a concurrent writer overwrote
+    std::unordered_map<int, int> localView;
+    std::vector<int> readKeys; // keys holding our SIREAD marker
+};
+
+class SerializableSIManager {
+private:
+    std::atomic<int> nextTxID{ 1000 };
+    std::atomic<int> globalTS{ 1 };
+    std::mutex dataMutex;
+
+    std::unordered_map<int, std::vector<SSIVersion>> versionChain;
+    std::unordered_map<int, SSITransaction> txns;              // active, and committed ones still overlapping an active one
+    std::unordered_map<int, std::unordered_set<int>> sireadLocks; // index -> txIDs that read it
+
+    std::atomic<long long> serializationFailures{ 0 };
+    int commitsSincePrune = 0;
+
+    static constexpr int PRUNE_INTERVAL = 64;
+
+    // other's lifetime overlaps self's: other committed after self started, or is still active
+    static bool concurrent(const SSITransaction& other, const SSITransaction& self) {
+        return !other.aborted && other.commit_ts > self.start_ts;
+    }
+
+    // Drop a finished transaction and its SIREAD markers
+    void forget(int txID, SSITransaction& txn) {
+        for (int index : txn.readKeys) {
+            sireadLocks[index].erase(txID);
+        }
+        txns.erase(txID);
+    }
+
+    void failSerialization(int txID, SSITransaction& txn) {
+        txn.aborted = true;
+        serializationFailures.fetch_add(1);
+        forget(txID, txn);
+    }
+
+    // Committed transactions that finished before every active one started
+    // can no longer take part in a dangerous structure
+    void prune() {
+        int minActiveStart = INT_MAX;
+        for (const auto& [_, txn] : txns) {
+            if (!txn.committed) {
+                minActiveStart = std::min(minActiveStart, txn.start_ts);
+            }
+        }
+        std::vector<int> done;
+        for (const auto& [id, txn] : txns) {
+            if (txn.committed && txn.commit_ts < minActiveStart) {
+                done.push_back(id);
+            }
+        }
+        for (int id : done) {
+            forget(id, txns[id]);
+        }
+    }
+
+public:
+    SerializableSIManager(int m) {
+        for (int i = 0; i < m; ++i) {
+            versionChain[i] = { {0, 0, 0} };
+        }
+    }
+
+    int beginTrans() {
+        int txID = nextTxID.fetch_add(1);
+        PerfLockGuard lk(dataMutex);
+        txns[txID].start_ts = globalTS.fetch_add(1);
+        return txID;
+    }
+
+    int read(int txID, int index) {
+        PerfLockGuard lk(dataMutex);
+        auto it = txns.find(txID);
+        if (it == txns.end()) {
+            return -1; // Already aborted
+        }
+        SSITransaction& txn = it->second;
+
+        auto local = txn.localView.find(index);
+        if (local != txn.localView.end()) {
+            return local->second;
+        }
+
+        if (sireadLocks[index].insert(txID).second) {
+            txn.readKeys.push_back(index);
+        }
+
+        int value = 0;
+        const auto& chain = versionChain[index];
+        for (auto v = chain.rbegin(); v != chain.rend(); ++v) {
+            if (v->commit_ts <= txn.start_ts) {
+                value = v->value;
+                break;
+            }
+
+            // Newer version from a concurrent writer W: rw-antidependency txn -> W
+            auto writer = txns.find(v->writer);
+            if (writer == txns.end()) {
+                continue;
+            }
+            if (writer->second.committed && writer->second.outConflict) {
+                failSerialization(txID, txn); // W is a committed pivot
+                return -1;
+            }
+            txn.outConflict = true;
+            writer->second.inConflict = true;
+        }
+
+        if (txn.inConflict && txn.outConflict) {
+            failSerialization(txID, txn);
+            return -1;
+        }
+        return value;
+    }
+
+    void write(int txID, int index, int val) {
+        PerfLockGuard lk(dataMutex);
+        auto it = txns.find(txID);
+        if (it != txns.end()) {
+            it->second.localView[index] = val;
+        }
+    }
+
+    bool commit(int txID) {
+        PerfLockGuard lk(dataMutex);
+        auto it = txns.find(txID);
+        if (it == txns.end() || it->second.committed) {
+            return false; // Already aborted, or already committed
+        }
+        SSITransaction& txn = it->second;
+
+        // Write-write conflict check (first committer wins, as in SI)
+        for (const auto& [index, _] : txn.localView) {
+            if (versionChain[index].back().commit_ts > txn.start_ts) {
+                txn.aborted = true;
+                forget(txID, txn);
+                return false;
+            }
+        }
+
+        // Concurrent readers R of what we overwrite: rw-antidependency R -> txn
+        for (const auto& [index, _] : txn.localView) {
+            for (int readerID : sireadLocks[index]) {
+                if (readerID == txID) {
+                    continue;
+                }
+                auto reader = txns.find(readerID);
+                if (reader == txns.end() || !concurrent(reader->second, txn)) {
+                    continue;
+                }
+                if (reader->second.committed && reader->second.inConflict) {
+                    failSerialization(txID, txn); // R is a committed pivot
+                    return false;
+                }
+                reader->second.outConflict = true;
+                txn.inConflict = true;
+            }
+        }
+
+        if (txn.inConflict && txn.outConflict) {
+            failSerialization(txID, txn);
+            return false;
+        }
+
+        int commit_ts = globalTS.fetch_add(1);
+        for (const auto& [index, val] : txn.localView) {
+            versionChain[index].push_back({ val, commit_ts, txID });
+        }
+        txn.commit_ts = commit_ts;
+        txn.committed = true;
+        txn.localView.clear();
+
+        if (++commitsSincePrune >= PRUNE_INTERVAL) {
+            commitsSincePrune = 0;
+            prune();
+        }
+        return true;
+    }
+
+    void abort(int txID) {
+        PerfLockGuard lk(dataMutex);
+        auto it = txns.find(txID);
+        if (it != txns.end() && !it->second.committed) {
+            it->second.aborted = true;
+            forget(txID, it->second);
+        }
+    }
+
+    // Lets the caller stop issuing operations for a doomed transaction
+    bool isAborted(int txID) {
+        PerfLockGuard lk(dataMutex);
+        return txns.find(txID) == txns.end();
+    }
+
+    // Aborts caused by the dangerous-structure check rather than by a
+    // write-write conflict; an upper bound on false-positive aborts
+    long long serializationAborts() const {
+        return serializationFailures.load();
+    }
+};
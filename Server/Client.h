@@ -0,0 +1,126 @@
+#pragma once
+
+// Blocking client for the transaction server. send() only queues a request;
+// flush() writes everything queued in one go and receive() returns replies
+// in request order, so a caller can keep several requests in flight.
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Protocol.h"
+
+class TxClient {
+    int fd = -1;
+    std::vector<char> out;
+    std::vector<char> in;
+    size_t inPos = 0;
+    size_t inLen = 0;
+
+public:
+    TxClient(const std::string& host, int port) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        if (fd < 0 || inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+            connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            throw std::runtime_error("cannot connect to " + host + ":" + std::to_string(port));
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        in.resize(64 * 1024);
+    }
+
+    ~TxClient() {
+        close(fd);
+    }
+
+    TxClient(const TxClient&) = delete;
+    TxClient& operator=(const TxClient&) = delete;
+
+    void send(uint32_t tag, const ProtoOpRecord* ops, size_t count) {
+        appendRequest(out, tag, ops, count);
+    }
+
+    void send(uint32_t tag, const std::vector<ProtoOpRecord>& ops) {
+        send(tag, ops.data(), ops.size());
+    }
+
+    void flush() {
+        size_t pos = 0;
+        while (pos < out.size()) {
+            ssize_t w = ::send(fd, out.data() + pos, out.size() - pos, MSG_NOSIGNAL);
+            if (w < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("connection lost while sending");
+            }
+            pos += (size_t)w;
+        }
+        out.clear();
+    }
+
+    // Whether receive() can return a reply without reading the socket
+    bool replyReady() const {
+        return inLen - inPos >= PROTO_HEADER_SIZE &&
+            inLen - inPos >= PROTO_LENGTH_SIZE + loadAt<uint32_t>(in.data() + inPos);
+    }
+
+    // Next reply; false once the server has closed the connection
+    bool receive(uint32_t& tag, std::vector<ProtoResult>& results) {
+        while (true) {
+            if (inLen - inPos >= PROTO_HEADER_SIZE) {
+                const char* p = in.data() + inPos;
+                uint32_t length = loadAt<uint32_t>(p);
+                if (inLen - inPos >= PROTO_LENGTH_SIZE + length) {
+                    tag = loadAt<uint32_t>(p + 4);
+                    uint16_t count = loadAt<uint16_t>(p + 8);
+                    results.resize(count);
+                    for (uint16_t i = 0; i < count; ++i) {
+                        results[i] = decodeResult(p + PROTO_HEADER_SIZE + i * PROTO_RESULT_SIZE);
+                    }
+                    inPos += PROTO_LENGTH_SIZE + length;
+                    return true;
+                }
+            }
+            if (inPos > 0) {
+                std::memmove(in.data(), in.data() + inPos, inLen - inPos);
+                inLen -= inPos;
+                inPos = 0;
+            }
+            if (inLen == in.size()) {
+                in.resize(in.size() * 2);
+            }
+            ssize_t r = read(fd, in.data() + inLen, in.size() - inLen);
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            if (r <= 0) {
+                return false;
+            }
+            inLen += (size_t)r;
+        }
+    }
+
+    // One request, waiting for its reply
+    std::vector<ProtoResult> call(const std::vector<ProtoOpRecord>& ops) {
+        send(0, ops);
+        flush();
+        uint32_t tag;
+        std::vector<ProtoResult> results;
+        if (!receive(tag, results)) {
+            throw std::runtime_error("connection closed by server");
+        }
+        return results;
+    }
+};
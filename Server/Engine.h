@@ -0,0 +1,27 @@
+#pragma once
+
+// Engine served by server.cc and driven in-process by loadgen.cc, chosen at
+// build time (SI-SSN by default), e.g.
+//   g++ -std=c++17 -O2 -pthread -DENGINE_OCC -o server server.cc
+
+#if defined(ENGINE_SI)
+#include "../SI/SI.h"
+using ServedManager = SnapshotIsolationManager;
+constexpr const char* SERVED_ENGINE = "SI";
+#elif defined(ENGINE_OCC)
+#include "../OCC/OCC.h"
+using ServedManager = SiloOCCManager;
+constexpr const char* SERVED_ENGINE = "OCC";
+#elif defined(ENGINE_SSI)
+#include "../SSI/SSI.h"
+using ServedManager = SerializableSIManager;
+constexpr const char* SERVED_ENGINE = "SSI";
+#elif defined(ENGINE_PARTITIONED)
+#include "../Partitioned/Partitioned.h"
+using ServedManager = PartitionedManager;
+constexpr const char* SERVED_ENGINE = "Partitioned";
+#else
+#include "../SI-SSN/SI-SSN.h"
+using ServedManager = SnapshotIsolationManager;
+constexpr const char* SERVED_ENGINE = "SI-SSN";
+#endif
@@ -0,0 +1,114 @@
+#pragma once
+
+// Binary protocol of the transaction server. Every request is a batch of
+// fixed-size operations executed in order and answered by one reply holding
+// a result per operation. A client may send many requests before reading
+// any reply (pipelining); replies come back in request order.
+//
+//   request := u32 length | u32 tag | u16 count | op[count]
+//   op      := u8 code | i32 txID | i32 index | i32 value
+//   reply   := u32 length | u32 tag | u16 count | result[count]
+//   result  := u8 status | i32 value
+//
+// length counts the bytes after itself and tag is echoed back unchanged.
+// Integers are in host byte order: the server is meant for local clients.
+// An operation whose txID is TX_OF_BATCH acts on the transaction started by
+// the last BEGIN of its own batch, so a whole read-only transaction fits in
+// one request.
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+
+enum ProtoOp : uint8_t {
+    OP_BEGIN = 1,  // result value: the new txID
+    OP_READ = 2,   // result value: the value read
+    OP_WRITE = 3,
+    OP_COMMIT = 4,
+    OP_ABORT = 5,
+};
+
+enum ProtoStatus : uint8_t {
+    ST_OK = 0,
+    ST_ABORTED = 1,      // The transaction is doomed or failed to commit
+    ST_BUSY = 2,         // BEGIN found no free transaction context
+    ST_BAD_REQUEST = 3,  // Unknown op, key out of range or not our transaction
+};
+
+constexpr int32_t TX_OF_BATCH = 0;       // No engine hands out txID 0
+constexpr size_t PROTO_LENGTH_SIZE = 4;
+constexpr size_t PROTO_HEADER_SIZE = 10; // length + tag + count
+constexpr size_t PROTO_OP_SIZE = 13;
+constexpr size_t PROTO_RESULT_SIZE = 5;
+constexpr size_t PROTO_MAX_OPS = 4096;
+
+struct ProtoOpRecord {
+    uint8_t code;
+    int32_t txID;
+    int32_t index;
+    int32_t value;
+};
+
+struct ProtoResult {
+    uint8_t status;
+    int32_t value;
+};
+
+template <class T>
+inline T loadAt(const char* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+template <class T>
+inline void storeAt(char* p, T v) {
+    std::memcpy(p, &v, sizeof(T));
+}
+
+inline ProtoOpRecord decodeOp(const char* p) {
+    return { (uint8_t)p[0], loadAt<int32_t>(p + 1), loadAt<int32_t>(p + 5), loadAt<int32_t>(p + 9) };
+}
+
+inline ProtoResult decodeResult(const char* p) {
+    return { (uint8_t)p[0], loadAt<int32_t>(p + 1) };
+}
+
+// Append one request to buf
+inline void appendRequest(std::vector<char>& buf, uint32_t tag, const ProtoOpRecord* ops, size_t count) {
+    size_t at = buf.size();
+    buf.resize(at + PROTO_HEADER_SIZE + count * PROTO_OP_SIZE);
+    char* p = buf.data() + at;
+    storeAt<uint32_t>(p, (uint32_t)(PROTO_HEADER_SIZE - PROTO_LENGTH_SIZE + count * PROTO_OP_SIZE));
+    storeAt<uint32_t>(p + 4, tag);
+    storeAt<uint16_t>(p + 8, (uint16_t)count);
+    p += PROTO_HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i, p += PROTO_OP_SIZE) {
+        p[0] = (char)ops[i].code;
+        storeAt<int32_t>(p + 1, ops[i].txID);
+        storeAt<int32_t>(p + 5, ops[i].index);
+        storeAt<int32_t>(p + 9, ops[i].value);
+    }
+}
+
+inline void appendRequest(std::vector<char>& buf, uint32_t tag, const std::vector<ProtoOpRecord>& ops) {
+    appendRequest(buf, tag, ops.data(), ops.size());
+}
+
+// Reserve a reply for count results at the end of buf; results are then
+// written in place with storeResult
+inline char* appendReply(std::vector<char>& buf, uint32_t tag, size_t count) {
+    size_t at = buf.size();
+    buf.resize(at + PROTO_HEADER_SIZE + count * PROTO_RESULT_SIZE);
+    char* p = buf.data() + at;
+    storeAt<uint32_t>(p, (uint32_t)(PROTO_HEADER_SIZE - PROTO_LENGTH_SIZE + count * PROTO_RESULT_SIZE));
+    storeAt<uint32_t>(p + 4, tag);
+    storeAt<uint16_t>(p + 8, (uint16_t)count);
+    return p + PROTO_HEADER_SIZE;
+}
+
+inline void storeResult(char* p, ProtoResult result) {
+    p[0] = (char)result.status;
+    storeAt<int32_t>(p + 1, result.value);
+}
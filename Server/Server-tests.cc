@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include "../SI-SSN/SI-SSN.h"
+#include "Server.h"
+#include "Client.h"
+
+using Results = std::vector<ProtoResult>;
+
+// ✅ Test: Single-operation requests run a transaction end to end
+TEST(ServerTest, SingleOperationRequests) {
+    SnapshotIsolationManager manager(10);
+    TxServer<SnapshotIsolationManager> server(manager, 10, "127.0.0.1", 0, 2);
+    TxClient client("127.0.0.1", server.start());
+
+    Results begin = client.call({ { OP_BEGIN, 0, 0, 0 } });
+    ASSERT_EQ(begin[0].status, ST_OK);
+    int tx = begin[0].value;
+    ASSERT_EQ(client.call({ { OP_WRITE, tx, 3, 42 } })[0].status, ST_OK);
+    Results read = client.call({ { OP_READ, tx, 3, 0 } });
+    ASSERT_EQ(read[0].status, ST_OK);
+    ASSERT_EQ(read[0].value, 42); // Read-your-writes through the server
+    ASSERT_EQ(client.call({ { OP_COMMIT, tx, 0, 0 } })[0].status, ST_OK);
+
+    int tx2 = client.call({ { OP_BEGIN, 0, 0, 0 } })[0].value;
+    ASSERT_EQ(client.call({ { OP_READ, tx2, 3, 0 } })[0].value, 42);
+    ASSERT_EQ(client.call({ { OP_COMMIT, tx2, 0, 0 } })[0].status, ST_OK);
+    ASSERT_EQ(server.requestsServed(), 7);
+}
+
+// ✅ Test: A batch runs a whole transaction, later ops using the batch's BEGIN
+TEST(ServerTest, BatchedTransaction) {
+    SnapshotIsolationManager manager(10);
+    TxServer<SnapshotIsolationManager> server(manager, 10, "127.0.0.1", 0, 1);
+    TxClient client("127.0.0.1", server.start());
+
+    Results write = client.call({
+        { OP_BEGIN, 0, 0, 0 },
+        { OP_WRITE, TX_OF_BATCH, 1, 7 },
+        { OP_WRITE, TX_OF_BATCH, 2, 8 },
+        { OP_COMMIT, TX_OF_BATCH, 0, 0 },
+    });
+    ASSERT_EQ(write.size(), 4u);
+    for (const auto& r : write) {
+        ASSERT_EQ(r.status, ST_OK);
+    }
+
+    Results read = client.call({
+        { OP_BEGIN, 0, 0, 0 },
+        { OP_READ, TX_OF_BATCH, 1, 0 },
+        { OP_READ, TX_OF_BATCH, 2, 0 },
+        { OP_COMMIT, TX_OF_BATCH, 0, 0 },
+    });
+    ASSERT_EQ(read[1].value, 7);
+    ASSERT_EQ(read[2].value, 8);
+    ASSERT_EQ(read[3].status, ST_OK);
+}
+
+// ✅ Test: Many requests sent before any reply come back in order
+TEST(ServerTest, PipelinedRequestsAnsweredInOrder) {
+    SnapshotIsolationManager manager(100);
+    TxServer<SnapshotIsolationManager> server(manager, 100, "127.0.0.1", 0, 1);
+    TxClient client("127.0.0.1", server.start());
+
+    int tx = client.call({ { OP_BEGIN, 0, 0, 0 } })[0].value;
+    const int requests = 1000;
+    for (int i = 0; i < requests; ++i) {
+        ProtoOpRecord op = i % 2 == 0 ? ProtoOpRecord{ OP_WRITE, tx, i % 100, i }
+                                      : ProtoOpRecord{ OP_READ, tx, (i - 1) % 100, 0 };
+        client.send(i, &op, 1);
+    }
+    client.flush();
+    for (int i = 0; i < requests; ++i) {
+        uint32_t tag;
+        Results results;
+        ASSERT_TRUE(client.receive(tag, results));
+        ASSERT_EQ(tag, (uint32_t)i);
+        ASSERT_EQ(results[0].status, ST_OK);
+        if (i % 2 == 1) {
+            ASSERT_EQ(results[0].value, i - 1); // Sees the write just before it
+        }
+    }
+    ASSERT_EQ(client.call({ { OP_COMMIT, tx, 0, 0 } })[0].status, ST_OK);
+}
+
+// ✅ Test: A client that pipelines without reading replies is throttled, then served in full
+TEST(ServerTest, UnreadRepliesPauseReading) {
+    SnapshotIsolationManager manager(10);
+    TxServer<SnapshotIsolationManager> server(manager, 10, "127.0.0.1", 0, 1);
+    int port = server.start();
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int small = 16 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    ASSERT_EQ(connect(fd, (sockaddr*)&addr, sizeof(addr)), 0);
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+
+    // Reads of a transaction that does not exist: every op gets a reply
+    std::vector<ProtoOpRecord> ops(PROTO_MAX_OPS, ProtoOpRecord{ OP_READ, 1, 0, 0 });
+    std::vector<char> request;
+    appendRequest(request, 0, ops);
+
+    // Send until the server has stopped taking requests for a while
+    long long sent = 0;
+    size_t pos = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - lastProgress < std::chrono::milliseconds(300)) {
+        ssize_t w = send(fd, request.data() + pos, request.size() - pos, MSG_NOSIGNAL);
+        if (w > 0) {
+            pos += (size_t)w;
+            if (pos == request.size()) {
+                pos = 0;
+                ++sent;
+            }
+            lastProgress = std::chrono::steady_clock::now();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_LT(sent * request.size(), 256u << 20) << "server never stopped reading";
+    }
+    ASSERT_EQ(server.readPauses(), 1);
+
+    // Read every reply; the server resumes and takes the rest of the
+    // partial request
+    size_t replySize = PROTO_HEADER_SIZE + PROTO_MAX_OPS * PROTO_RESULT_SIZE;
+    std::vector<char> reply(1 << 16);
+    long long expected = sent * (long long)replySize, received = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (pos > 0 || received < expected) {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        if (pos > 0) {
+            ssize_t w = send(fd, request.data() + pos, request.size() - pos, MSG_NOSIGNAL);
+            if (w > 0 && (pos += (size_t)w) == request.size()) {
+                pos = 0;
+                ++sent;
+                expected += replySize;
+            }
+        }
+        ssize_t r = read(fd, reply.data(), reply.size());
+        ASSERT_NE(r, 0);
+        if (r > 0) {
+            received += r;
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ASSERT_EQ(received, expected);
+    ASSERT_EQ(server.requestsServed(), sent);
+    close(fd);
+}
+
+// ✅ Test: Conflicts surface as aborted commits, bad requests are refused
+TEST(ServerTest, ConflictsAndBadRequests) {
+    SnapshotIsolationManager manager(10);
+    TxServer<SnapshotIsolationManager> server(manager, 10, "127.0.0.1", 0, 2);
+    int port = server.start();
+    TxClient a("127.0.0.1", port);
+    TxClient b("127.0.0.1", port);
+
+    int txA = a.call({ { OP_BEGIN, 0, 0, 0 } })[0].value;
+    int txB = b.call({ { OP_BEGIN, 0, 0, 0 } })[0].value;
+    a.call({ { OP_WRITE, txA, 0, 1 } });
+    b.call({ { OP_WRITE, txB, 0, 2 } });
+    ASSERT_EQ(a.call({ { OP_COMMIT, txA, 0, 0 } })[0].status, ST_OK);
+    ASSERT_EQ(b.call({ { OP_COMMIT, txB, 0, 0 } })[0].status, ST_ABORTED);
+
+    int txC = b.call({ { OP_BEGIN, 0, 0, 0 } })[0].value;
+    ASSERT_EQ(b.call({ { OP_READ, txC, 10, 0 } })[0].status, ST_BAD_REQUEST); // Key out of range
+    ASSERT_EQ(a.call({ { OP_READ, txC, 0, 0 } })[0].status, ST_BAD_REQUEST);  // Another connection's
+    ASSERT_EQ(b.call({ { OP_COMMIT, txA, 0, 0 } })[0].status, ST_BAD_REQUEST); // Already finished
+    ASSERT_EQ(b.call({ { 99, txC, 0, 0 } })[0].status, ST_BAD_REQUEST);
+    ASSERT_EQ(b.call({ { OP_ABORT, txC, 0, 0 } })[0].status, ST_OK);
+}
+
+// ✅ Test: Transactions of a dropped connection are aborted, freeing their contexts
+TEST(ServerTest, DisconnectAbortsOpenTransactions) {
+    SnapshotIsolationManager manager(10, 2);
+    TxServer<SnapshotIsolationManager> server(manager, 10, "127.0.0.1", 0, 1);
+    int port = server.start();
+    {
+        TxClient client("127.0.0.1", port);
+        Results opened = client.call({ { OP_BEGIN, 0, 0, 0 }, { OP_BEGIN, 0, 0, 0 }, { OP_BEGIN, 0, 0, 0 } });
+        ASSERT_EQ(opened[0].status, ST_OK);
+        ASSERT_EQ(opened[1].status, ST_OK);
+        ASSERT_EQ(opened[2].status, ST_BUSY); // Pool of two is exhausted
+        client.call({ { OP_WRITE, opened[0].value, 0, 5 } });
+    }
+
+    TxClient other("127.0.0.1", port);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    Results begun;
+    do {
+        begun = other.call({ { OP_BEGIN, 0, 0, 0 }, { OP_READ, TX_OF_BATCH, 0, 0 } });
+    } while (begun[0].status == ST_BUSY && std::chrono::steady_clock::now() < deadline);
+    ASSERT_EQ(begun[0].status, ST_OK);
+    ASSERT_EQ(begun[1].value, 0); // The dropped write was never installed
+}
+
+// ✅ Test: Concurrent pipelined clients keep a counter exact
+TEST(ServerTest, ConcurrentClientsIncrementCounter) {
+    SnapshotIsolationManager manager(4);
+    TxServer<SnapshotIsolationManager> server(manager, 4, "127.0.0.1", 0, 2);
+    int port = server.start();
+    const int clients = 4, increments = 200;
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&] {
+            TxClient client("127.0.0.1", port);
+            for (int done = 0; done < increments;) {
+                Results read = client.call({ { OP_BEGIN, 0, 0, 0 }, { OP_READ, TX_OF_BATCH, 0, 0 } });
+                if (read[0].status != ST_OK) {
+                    continue;
+                }
+                int tx = read[0].value;
+                Results commit = client.call({ { OP_WRITE, tx, 0, read[1].value + 1 }, { OP_COMMIT, tx, 0, 0 } });
+                done += commit[1].status == ST_OK;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    TxClient client("127.0.0.1", port);
+    Results total = client.call({ { OP_BEGIN, 0, 0, 0 }, { OP_READ, TX_OF_BATCH, 0, 0 }, { OP_COMMIT, TX_OF_BATCH, 0, 0 } });
+    ASSERT_EQ(total[1].value, clients * increments);
+}
@@ -0,0 +1,428 @@
+#pragma once
+
+// TCP front-end serving an engine's begin/read/write/commit/abort over the
+// protocol in Protocol.h. One epoll event loop per core, each with its own
+// SO_REUSEPORT listening socket so the kernel spreads connections across
+// loops and a connection stays on the loop that accepted it. Requests are
+// decoded in place from the connection's receive buffer and replies encoded
+// straight into its send buffer, so a wakeup costs one read and one write
+// however many pipelined requests it carries. Engine calls run on the loop
+// thread; transactions left open by a closing connection are aborted.
+// A connection whose client lets more than SERVER_MAX_PENDING_OUTPUT of
+// replies pile up is not read from again until they have all been sent.
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Protocol.h"
+#include "../common/affinity.h"
+#include "../common/traits.h"
+
+constexpr size_t SERVER_READ_CHUNK = 64 * 1024;
+constexpr size_t SERVER_MAX_READ_PER_WAKEUP = 1 << 20; // Then yield to other connections
+constexpr size_t SERVER_MAX_PENDING_OUTPUT = 4 << 20;  // Unsent reply bytes before reading pauses
+constexpr int SERVER_MAX_EVENTS = 256;
+
+template <class Manager>
+class TxServer {
+    static_assert(!IsOneShot<Manager>::value, "one-shot engines have no interactive API to serve");
+    static_assert(HasAbort<Manager>::value, "the server aborts transactions of closed connections");
+    static_assert(!BlocksOnConflict<Manager>::value, "a lock wait would stall every connection of the loop");
+
+    struct Connection {
+        int fd;
+        std::vector<char> in;
+        size_t inLen = 0;
+        std::vector<char> out;
+        size_t outPos = 0;
+        bool wantWrite = false;
+        bool readPaused = false;
+        std::vector<int> openTx; // Transactions begun here and not yet finished
+    };
+
+    struct alignas(64) LoopStats {
+        std::atomic<long long> requests{ 0 };
+        std::atomic<long long> operations{ 0 };
+        std::atomic<long long> readPauses{ 0 };
+    };
+
+    Manager& manager;
+    int m;
+    std::string address;
+    int port;
+    int loopCount;
+    bool pin;
+    std::vector<std::thread> loops;
+    std::vector<int> stopFds;
+    std::unique_ptr<LoopStats[]> stats;
+
+public:
+    // port 0 picks a free port; start() returns the one bound
+    TxServer(Manager& manager, int m, const std::string& address = "127.0.0.1", int port = 0,
+             int loopCount = std::max(1u, std::thread::hardware_concurrency()), bool pin = false)
+        : manager(manager), m(m), address(address), port(port), loopCount(std::max(1, loopCount)), pin(pin),
+          stats(new LoopStats[std::max(1, loopCount)]) {}
+
+    ~TxServer() {
+        stop();
+    }
+
+    TxServer(const TxServer&) = delete;
+    TxServer& operator=(const TxServer&) = delete;
+
+    int start() {
+        std::vector<int> listenFds;
+        for (int i = 0; i < loopCount; ++i) {
+            int fd = listenSocket();
+            listenFds.push_back(fd);
+            if (port == 0) {
+                sockaddr_in bound{};
+                socklen_t len = sizeof(bound);
+                getsockname(fd, (sockaddr*)&bound, &len);
+                port = ntohs(bound.sin_port); // The other loops share it
+            }
+        }
+        std::vector<int> order = compactCpuOrder();
+        for (int i = 0; i < loopCount; ++i) {
+            int stopFd = eventfd(0, EFD_NONBLOCK);
+            if (stopFd < 0) {
+                throw std::runtime_error("eventfd failed");
+            }
+            stopFds.push_back(stopFd);
+            int cpu = pin && !order.empty() ? order[i % order.size()] : -1;
+            loops.emplace_back(&TxServer::loop, this, i, listenFds[i], stopFd, cpu);
+        }
+        return port;
+    }
+
+    void stop() {
+        for (int fd : stopFds) {
+            uint64_t one = 1;
+            if (write(fd, &one, sizeof(one)) < 0) {
+                // The loop is gone already
+            }
+        }
+        for (auto& t : loops) {
+            t.join();
+        }
+        for (int fd : stopFds) {
+            close(fd);
+        }
+        loops.clear();
+        stopFds.clear();
+    }
+
+    long long requestsServed() const {
+        long long total = 0;
+        for (int i = 0; i < loopCount; ++i) {
+            total += stats[i].requests.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    long long operationsServed() const {
+        long long total = 0;
+        for (int i = 0; i < loopCount; ++i) {
+            total += stats[i].operations.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Times a connection stopped being read because its replies backed up
+    long long readPauses() const {
+        long long total = 0;
+        for (int i = 0; i < loopCount; ++i) {
+            total += stats[i].readPauses.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    int listenSocket() {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (fd < 0) {
+            throw std::runtime_error("socket failed");
+        }
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+            close(fd);
+            throw std::runtime_error("bad listen address " + address);
+        }
+        if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            close(fd);
+            throw std::runtime_error("cannot listen on " + address + ":" + std::to_string(port));
+        }
+        return fd;
+    }
+
+    void loop(int index, int listenFd, int stopFd, int cpu) {
+        if (cpu >= 0) {
+            pinCurrentThread(cpu);
+        }
+        int ep = epoll_create1(0);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = listenFd;
+        epoll_ctl(ep, EPOLL_CTL_ADD, listenFd, &ev);
+        ev.data.fd = stopFd;
+        epoll_ctl(ep, EPOLL_CTL_ADD, stopFd, &ev);
+
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;
+        LoopStats& counters = stats[index];
+        epoll_event events[SERVER_MAX_EVENTS];
+        bool running = true;
+        while (running) {
+            int n = epoll_wait(ep, events, SERVER_MAX_EVENTS, -1);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            for (int e = 0; e < n; ++e) {
+                int fd = events[e].data.fd;
+                if (fd == stopFd) {
+                    running = false;
+                    break;
+                }
+                if (fd == listenFd) {
+                    acceptAll(ep, listenFd, connections);
+                    continue;
+                }
+                auto found = connections.find(fd);
+                if (found == connections.end()) {
+                    continue;
+                }
+                Connection& c = *found->second;
+                bool open = true;
+                uint32_t readable = c.readPaused ? EPOLLHUP | EPOLLERR : EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP;
+                if (events[e].events & readable) {
+                    open = receive(c) && serve(c, counters);
+                }
+                if (open) {
+                    open = flush(ep, c, counters);
+                }
+                if (!open) {
+                    closeConnection(ep, c);
+                    connections.erase(found);
+                }
+            }
+        }
+        for (auto& [fd, c] : connections) {
+            closeConnection(ep, *c);
+        }
+        close(listenFd);
+        close(ep);
+    }
+
+    void acceptAll(int ep, int listenFd, std::unordered_map<int, std::unique_ptr<Connection>>& connections) {
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd < 0) {
+                return; // EAGAIN, or a connection that went away before we took it
+            }
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            auto c = std::make_unique<Connection>();
+            c->fd = fd;
+            c->in.resize(SERVER_READ_CHUNK);
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.fd = fd;
+            epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+            connections[fd] = std::move(c);
+        }
+    }
+
+    // Drain the socket into the receive buffer; false once the peer is gone
+    bool receive(Connection& c) {
+        size_t received = 0;
+        while (received < SERVER_MAX_READ_PER_WAKEUP) {
+            if (c.in.size() - c.inLen < SERVER_READ_CHUNK) {
+                c.in.resize(c.inLen + SERVER_READ_CHUNK);
+            }
+            ssize_t r = read(c.fd, c.in.data() + c.inLen, c.in.size() - c.inLen);
+            if (r > 0) {
+                c.inLen += (size_t)r;
+                received += (size_t)r;
+                continue;
+            }
+            if (r == 0) {
+                return false;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        return true;
+    }
+
+    // Execute every complete request in the receive buffer; false on a
+    // malformed request
+    bool serve(Connection& c, LoopStats& counters) {
+        size_t pos = 0;
+        long long requests = 0;
+        long long operations = 0;
+        bool ok = true;
+        while (c.inLen - pos >= PROTO_HEADER_SIZE) {
+            const char* p = c.in.data() + pos;
+            uint32_t length = loadAt<uint32_t>(p);
+            uint16_t count = loadAt<uint16_t>(p + 8);
+            if (count > PROTO_MAX_OPS ||
+                length != PROTO_HEADER_SIZE - PROTO_LENGTH_SIZE + count * PROTO_OP_SIZE) {
+                ok = false;
+                break;
+            }
+            if (c.inLen - pos < PROTO_LENGTH_SIZE + length) {
+                break; // Rest of this request is still in flight
+            }
+            char* results = appendReply(c.out, loadAt<uint32_t>(p + 4), count);
+            const char* op = p + PROTO_HEADER_SIZE;
+            int batchTx = TX_OF_BATCH;
+            for (uint16_t i = 0; i < count; ++i, op += PROTO_OP_SIZE) {
+                storeResult(results + i * PROTO_RESULT_SIZE, execute(c, decodeOp(op), batchTx));
+            }
+            pos += PROTO_LENGTH_SIZE + length;
+            ++requests;
+            operations += count;
+        }
+        if (pos > 0) {
+            std::memmove(c.in.data(), c.in.data() + pos, c.inLen - pos);
+            c.inLen -= pos;
+        }
+        counters.requests.fetch_add(requests, std::memory_order_relaxed);
+        counters.operations.fetch_add(operations, std::memory_order_relaxed);
+        return ok;
+    }
+
+    ProtoResult execute(Connection& c, const ProtoOpRecord& op, int& batchTx) {
+        if (op.code == OP_BEGIN) {
+            int txID;
+            if constexpr (HasTryBegin<Manager>::value) {
+                txID = manager.tryBeginTrans();
+            }
+            else {
+                txID = manager.beginTrans();
+            }
+            batchTx = txID < 0 ? -1 : txID;
+            if (txID < 0) {
+                return { ST_BUSY, 0 };
+            }
+            c.openTx.push_back(txID);
+            return { ST_OK, txID };
+        }
+
+        int txID = op.txID == TX_OF_BATCH ? batchTx : op.txID;
+        if (op.txID == TX_OF_BATCH && txID < 0) {
+            return { ST_BUSY, 0 }; // The batch's BEGIN found no context
+        }
+        auto open = std::find(c.openTx.begin(), c.openTx.end(), txID);
+        if (open == c.openTx.end()) {
+            return { ST_BAD_REQUEST, 0 };
+        }
+
+        switch (op.code) {
+        case OP_READ:
+        case OP_WRITE: {
+            if (op.index < 0 || op.index >= m) {
+                return { ST_BAD_REQUEST, 0 };
+            }
+            int value = op.value;
+            if (op.code == OP_READ) {
+                value = manager.read(txID, op.index);
+            }
+            else {
+                manager.write(txID, op.index, op.value);
+            }
+            if constexpr (HasIsAborted<Manager>::value) {
+                if (manager.isAborted(txID)) {
+                    return { ST_ABORTED, value };
+                }
+            }
+            return { ST_OK, value };
+        }
+        case OP_COMMIT: {
+            c.openTx.erase(open);
+            return { manager.commit(txID) ? ST_OK : ST_ABORTED, 0 };
+        }
+        case OP_ABORT: {
+            c.openTx.erase(open);
+            manager.abort(txID);
+            return { ST_OK, 0 };
+        }
+        default:
+            return { ST_BAD_REQUEST, 0 };
+        }
+    }
+
+    // Send what we can; waits for EPOLLOUT only while a reply is backed up,
+    // and stops reading requests while too many replies are. False if the
+    // peer is gone
+    bool flush(int ep, Connection& c, LoopStats& counters) {
+        while (c.outPos < c.out.size()) {
+            ssize_t w = send(c.fd, c.out.data() + c.outPos, c.out.size() - c.outPos, MSG_NOSIGNAL);
+            if (w > 0) {
+                c.outPos += (size_t)w;
+                continue;
+            }
+            if (w < 0 && errno == EINTR) {
+                continue;
+            }
+            if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                bool pause = c.readPaused || c.out.size() - c.outPos > SERVER_MAX_PENDING_OUTPUT;
+                if (pause && !c.readPaused) {
+                    counters.readPauses.fetch_add(1, std::memory_order_relaxed);
+                }
+                watch(ep, c, true, pause);
+                return true;
+            }
+            return false;
+        }
+        c.out.clear();
+        c.outPos = 0;
+        watch(ep, c, false, false);
+        return true;
+    }
+
+    // Interest in writability and, unless paused, in further requests
+    void watch(int ep, Connection& c, bool writable, bool paused) {
+        if (writable == c.wantWrite && paused == c.readPaused) {
+            return;
+        }
+        epoll_event ev{};
+        ev.events = (paused ? 0u : (uint32_t)(EPOLLIN | EPOLLRDHUP)) | (writable ? (uint32_t)EPOLLOUT : 0u);
+        ev.data.fd = c.fd;
+        epoll_ctl(ep, EPOLL_CTL_MOD, c.fd, &ev);
+        c.wantWrite = writable;
+        c.readPaused = paused;
+    }
+
+    void closeConnection(int ep, Connection& c) {
+        for (int txID : c.openTx) {
+            manager.abort(txID);
+        }
+        c.openTx.clear();
+        epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+        close(c.fd);
+    }
+};
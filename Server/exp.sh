@@ -0,0 +1,74 @@
+#!/bin/bash
+
+# Script to compare network-mode and in-process throughput of the server
+# Experiment 1: Vary connections from 1 to 16 at pipeline depth 8, in every mode
+# Experiment 2: Keep 4 batched connections, vary pipeline depth from 1 to 64
+
+# Compilation (adjust compiler flags as needed, e.g. -DENGINE_OCC to serve OCC)
+echo "Compiling the programs..."
+g++ -std=c++17 -O2 -pthread -o server server.cc
+g++ -std=c++17 -O2 -pthread -o loadgen loadgen.cc
+
+# Constants for experiments
+PORT=7450        # Listen port
+M=1000           # Number of data items
+TXNS=5000        # Transactions per connection
+NUM_ITERS=10     # Operations per transaction
+READ_RATIO=0.7   # Fraction of read-only transactions
+
+./server --port=$PORT --keys=$M > server_log.txt &
+SERVER_PID=$!
+trap 'kill -INT $SERVER_PID 2>/dev/null' EXIT
+sleep 1
+
+# Function to run a single experiment
+run_experiment() {
+    local mode=$1
+    local connections=$2
+    local depth=$3
+    local output_dir=$4
+    local flags="--port=$PORT --keys=$M --txns=$TXNS --iters=$NUM_ITERS --read-ratio=$READ_RATIO"
+    flags="$flags --connections=$connections --depth=$depth"
+
+    echo "Running experiment with mode=$mode, connections=$connections, depth=$depth"
+
+    case $mode in
+        batched)    flags="$flags --batch" ;;
+        in-process) flags="$flags --in-process" ;;
+    esac
+    ./loadgen $flags > "$output_dir/result_${mode}_c${connections}_d${depth}.txt"
+
+    # Extract key metrics for summary
+    local result="$output_dir/result_${mode}_c${connections}_d${depth}.txt"
+    commits_per_sec=$(grep "Commits per second" "$result" | awk '{print $4}')
+    aborts_per_sec=$(grep "Aborts per second" "$result" | awk '{print $4}')
+    latency=$(grep "Average latency" "$result" | awk '{print $4}')
+
+    echo "$mode,$connections,$depth,$commits_per_sec,$aborts_per_sec,$latency" >> "$output_dir/summary.csv"
+}
+
+# Experiment 1: Varying connections
+echo "Starting Experiment 1: Varying connections from 1 to 16"
+exp1_dir="experiment_vary_connections"
+mkdir -p "$exp1_dir"
+echo "mode,connections,depth,commits_per_sec,aborts_per_sec,latency_us" > "$exp1_dir/summary.csv"
+
+for connections in 1 2 4 8 16; do
+    for mode in per-op batched in-process; do
+        run_experiment $mode $connections 8 "$exp1_dir"
+    done
+done
+
+# Experiment 2: Varying pipeline depth
+echo "Starting Experiment 2: Varying pipeline depth from 1 to 64"
+exp2_dir="experiment_vary_depth"
+mkdir -p "$exp2_dir"
+echo "mode,connections,depth,commits_per_sec,aborts_per_sec,latency_us" > "$exp2_dir/summary.csv"
+
+for depth in 1 2 4 8 16 32 64; do
+    run_experiment batched 4 $depth "$exp2_dir"
+done
+
+echo "Experiments completed!"
+echo "Results for connection variation are in: $exp1_dir"
+echo "Results for depth variation are in: $exp2_dir"
@@ -0,0 +1,405 @@
+#include "Engine.h"
+#include "Client.h"
+#include "../common/traits.h"
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Usage: ./loadgen [--host=ADDR] [--port=P] [--connections=C] [--depth=D] [--txns=N] [--keys=M]
+//                  [--iters=K] [--read-ratio=R] [--const-val=V] [--batch] [--in-process]
+//   --connections=C  client connections, one thread each (default 4)
+//   --depth=D        transactions in flight per connection (default 8)
+//   --txns=N         transactions committed per connection (default 10000)
+//   --keys=M         data items the server was started with (default 1000)
+//   --iters=K        reads (read-only) or read-modify-writes per transaction (default 10)
+//   --read-ratio=R   fraction of read-only transactions (default 0.7)
+//   --const-val=V    largest increment a write adds (default 100)
+//   --batch          send a transaction as batched requests: one for a read-only
+//                    transaction, two (begin+reads, writes+commit) otherwise,
+//                    instead of one request per operation
+//   --in-process     run the same workload with C threads directly on the engine
+//                    built into this binary, as the baseline for the network numbers
+
+struct LoadParams {
+    std::string host = "127.0.0.1";
+    int port = 7450;
+    int connections = 4;
+    int depth = 8;
+    int txns = 10000;
+    int m = 1000;
+    int iters = 10;
+    double readRatio = 0.7;
+    int constVal = 100;
+    bool batch = false;
+    bool inProcess = false;
+};
+
+struct LoadTotals {
+    std::atomic<long long> commits{ 0 };
+    std::atomic<long long> aborts{ 0 };
+    std::atomic<long long> operations{ 0 };
+    std::atomic<long long> latencyMicros{ 0 };
+};
+
+// One attempt of a workload transaction, redrawn on every retry like the
+// driver's
+struct WorkTxn {
+    bool readOnly = true;
+    std::vector<int> keys;
+    std::vector<int> deltas;
+
+    void draw(std::mt19937& rng, const LoadParams& p) {
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        std::uniform_int_distribution<int> key(0, p.m - 1);
+        std::uniform_int_distribution<int> delta(1, std::max(1, p.constVal));
+        readOnly = coin(rng) < p.readRatio;
+        keys.resize(p.iters);
+        deltas.resize(p.iters);
+        for (int i = 0; i < p.iters; ++i) {
+            keys[i] = key(rng);
+            deltas[i] = delta(rng);
+        }
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+long long microsSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+// ---------------- network mode ---------------- //
+
+enum Phase { PH_BEGIN, PH_READ, PH_WRITE, PH_WRITE_BATCH, PH_COMMIT, PH_ABORT, PH_DONE };
+
+struct InFlight {
+    WorkTxn txn;
+    Phase phase = PH_DONE;
+    int txID = -1;
+    int step = 0;
+    int lastValue = 0;
+    std::vector<int> values;
+    Clock::time_point start;
+};
+
+// Next request of a transaction, following its phase
+void buildRequest(const InFlight& t, bool batch, std::vector<ProtoOpRecord>& ops) {
+    ops.clear();
+    const auto& keys = t.txn.keys;
+    switch (t.phase) {
+    case PH_BEGIN:
+        ops.push_back({ OP_BEGIN, 0, 0, 0 });
+        if (batch) {
+            for (int key : keys) {
+                ops.push_back({ OP_READ, TX_OF_BATCH, key, 0 });
+            }
+            if (t.txn.readOnly) {
+                ops.push_back({ OP_COMMIT, TX_OF_BATCH, 0, 0 });
+            }
+        }
+        break;
+    case PH_READ:
+        ops.push_back({ OP_READ, t.txID, keys[t.step], 0 });
+        break;
+    case PH_WRITE:
+        ops.push_back({ OP_WRITE, t.txID, keys[t.step], t.lastValue + t.txn.deltas[t.step] });
+        break;
+    case PH_WRITE_BATCH:
+        for (size_t i = 0; i < keys.size(); ++i) {
+            ops.push_back({ OP_WRITE, t.txID, keys[i], t.values[i] + t.txn.deltas[i] });
+        }
+        ops.push_back({ OP_COMMIT, t.txID, 0, 0 });
+        break;
+    case PH_COMMIT:
+        ops.push_back({ OP_COMMIT, t.txID, 0, 0 });
+        break;
+    case PH_ABORT:
+        ops.push_back({ OP_ABORT, t.txID, 0, 0 });
+        break;
+    case PH_DONE:
+        break;
+    }
+}
+
+struct ConnectionCounts {
+    long long commits = 0;
+    long long aborts = 0;
+    long long operations = 0;
+    long long latencyMicros = 0;
+};
+
+// Advance a transaction by the reply to its last request, retrying it from
+// BEGIN after an abort. Returns true once it has committed
+bool advance(InFlight& t, bool batch, const std::vector<ProtoResult>& results, std::mt19937& rng,
+             const LoadParams& p, ConnectionCounts& counts) {
+    counts.operations += (long long)results.size();
+    auto failed = [&] {
+        ++counts.aborts;
+        t.txn.draw(rng, p);
+        t.phase = PH_BEGIN;
+        return false;
+    };
+    auto finish = [&](bool committed) {
+        if (!committed) {
+            return failed();
+        }
+        ++counts.commits;
+        counts.latencyMicros += microsSince(t.start);
+        t.phase = PH_DONE;
+        return true;
+    };
+    auto afterStep = [&] {
+        t.phase = ++t.step < (int)t.txn.keys.size() ? PH_READ : PH_COMMIT;
+        return false;
+    };
+
+    switch (t.phase) {
+    case PH_BEGIN: {
+        if (results[0].status == ST_BUSY) {
+            return false; // Retry the begin
+        }
+        t.txID = results[0].value;
+        t.step = 0;
+        if (!batch) {
+            t.phase = t.txn.keys.empty() ? PH_COMMIT : PH_READ;
+            return false;
+        }
+        if (t.txn.readOnly) {
+            return finish(results.back().status == ST_OK);
+        }
+        t.values.clear();
+        for (size_t i = 1; i < results.size(); ++i) {
+            if (results[i].status != ST_OK) {
+                t.phase = PH_ABORT;
+                return false;
+            }
+            t.values.push_back(results[i].value);
+        }
+        t.phase = PH_WRITE_BATCH;
+        return false;
+    }
+    case PH_READ:
+        if (results[0].status != ST_OK) {
+            t.phase = PH_ABORT;
+            return false;
+        }
+        t.lastValue = results[0].value;
+        if (!t.txn.readOnly) {
+            t.phase = PH_WRITE;
+            return false;
+        }
+        return afterStep();
+    case PH_WRITE:
+        if (results[0].status != ST_OK) {
+            t.phase = PH_ABORT;
+            return false;
+        }
+        return afterStep();
+    case PH_WRITE_BATCH:
+    case PH_COMMIT:
+        return finish(results.back().status == ST_OK);
+    case PH_ABORT:
+        return failed();
+    case PH_DONE:
+        break;
+    }
+    return true;
+}
+
+void networkClient(int id, const LoadParams& p, LoadTotals& totals) {
+    std::mt19937 rng(id + 1);
+    TxClient client(p.host, p.port);
+    std::vector<InFlight> slots(std::max(1, p.depth));
+    std::vector<ProtoOpRecord> ops;
+    std::vector<ProtoResult> results;
+    ConnectionCounts counts;
+    int started = 0;
+    int finished = 0;
+
+    auto launch = [&](uint32_t slot) {
+        InFlight& t = slots[slot];
+        t.txn.draw(rng, p);
+        t.phase = PH_BEGIN;
+        t.start = Clock::now();
+        ++started;
+        buildRequest(t, p.batch, ops);
+        client.send(slot, ops);
+    };
+
+    for (uint32_t s = 0; s < slots.size() && started < p.txns; ++s) {
+        launch(s);
+    }
+    client.flush();
+    while (finished < p.txns) {
+        uint32_t slot;
+        if (!client.receive(slot, results)) {
+            std::cerr << "Error: server closed connection " << id << "\n";
+            break;
+        }
+        InFlight& t = slots[slot];
+        if (advance(t, p.batch, results, rng, p, counts)) {
+            ++finished;
+            if (started < p.txns) {
+                launch(slot);
+            }
+        }
+        else {
+            buildRequest(t, p.batch, ops);
+            client.send(slot, ops);
+        }
+        if (!client.replyReady()) {
+            client.flush(); // Everything the last read brought in has been answered
+        }
+    }
+
+    totals.commits += counts.commits;
+    totals.aborts += counts.aborts;
+    totals.operations += counts.operations;
+    totals.latencyMicros += counts.latencyMicros;
+}
+
+// ---------------- in-process baseline ---------------- //
+
+template <class Manager>
+void inProcessClient(int id, Manager& manager, const LoadParams& p, LoadTotals& totals) {
+    std::mt19937 rng(id + 1);
+    WorkTxn txn;
+    ConnectionCounts counts;
+    for (int done = 0; done < p.txns; ++done) {
+        auto start = Clock::now();
+        while (true) {
+            txn.draw(rng, p);
+            int txID;
+            if constexpr (HasTryBegin<Manager>::value) {
+                while ((txID = manager.tryBeginTrans()) < 0) {
+                    std::this_thread::yield();
+                }
+            }
+            else {
+                txID = manager.beginTrans();
+            }
+            counts.operations += 2 + (long long)p.iters * (txn.readOnly ? 1 : 2);
+            bool doomed = false;
+            for (int i = 0; i < p.iters && !doomed; ++i) {
+                int value = manager.read(txID, txn.keys[i]);
+                if (!txn.readOnly) {
+                    manager.write(txID, txn.keys[i], value + txn.deltas[i]);
+                }
+                if constexpr (HasIsAborted<Manager>::value) {
+                    doomed = manager.isAborted(txID);
+                }
+            }
+            if (doomed) {
+                manager.abort(txID);
+            }
+            else if (manager.commit(txID)) {
+                break;
+            }
+            ++counts.aborts;
+        }
+        ++counts.commits;
+        counts.latencyMicros += microsSince(start);
+    }
+
+    totals.commits += counts.commits;
+    totals.aborts += counts.aborts;
+    totals.operations += counts.operations;
+    totals.latencyMicros += counts.latencyMicros;
+}
+
+int main(int argc, char** argv) {
+    LoadParams p;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.rfind("--host=", 0) == 0) {
+            p.host = arg.substr(7);
+        }
+        else if (arg.rfind("--port=", 0) == 0) {
+            p.port = std::stoi(arg.substr(7));
+        }
+        else if (arg.rfind("--connections=", 0) == 0) {
+            p.connections = std::max(1, std::stoi(arg.substr(14)));
+        }
+        else if (arg.rfind("--depth=", 0) == 0) {
+            p.depth = std::max(1, std::stoi(arg.substr(8)));
+        }
+        else if (arg.rfind("--txns=", 0) == 0) {
+            p.txns = std::max(1, std::stoi(arg.substr(7)));
+        }
+        else if (arg.rfind("--keys=", 0) == 0) {
+            p.m = std::max(1, std::stoi(arg.substr(7)));
+        }
+        else if (arg.rfind("--iters=", 0) == 0) {
+            p.iters = std::max(0, std::stoi(arg.substr(8)));
+        }
+        else if (arg.rfind("--read-ratio=", 0) == 0) {
+            p.readRatio = std::stod(arg.substr(13));
+        }
+        else if (arg.rfind("--const-val=", 0) == 0) {
+            p.constVal = std::stoi(arg.substr(12));
+        }
+        else if (arg == "--batch") {
+            p.batch = true;
+        }
+        else if (arg == "--in-process") {
+            p.inProcess = true;
+        }
+    }
+    if (p.batch && p.iters + 2 > (int)PROTO_MAX_OPS) {
+        std::cerr << "Error: --iters too large for one batched request\n";
+        return 1;
+    }
+
+    LoadTotals totals;
+    std::unique_ptr<ServedManager> manager;
+    if (p.inProcess) {
+        manager = std::make_unique<ServedManager>(p.m);
+    }
+    auto start = Clock::now();
+    std::vector<std::thread> clients;
+    try {
+        for (int c = 0; c < p.connections; ++c) {
+            if (p.inProcess) {
+                clients.emplace_back(inProcessClient<ServedManager>, c, std::ref(*manager), std::cref(p), std::ref(totals));
+            }
+            else {
+                clients.emplace_back([&, c] {
+                    try {
+                        networkClient(c, p, totals);
+                    }
+                    catch (const std::exception& e) {
+                        std::cerr << "Error: " << e.what() << "\n";
+                    }
+                });
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    long long commits = totals.commits.load();
+    std::cout << "Mode:                      "
+        << (p.inProcess ? std::string("in-process ") + SERVED_ENGINE : std::string("network"))
+        << " (" << p.connections << (p.inProcess ? " threads" : " connections");
+    if (!p.inProcess) {
+        std::cout << ", depth " << p.depth << (p.batch ? ", batched" : "");
+    }
+    std::cout << ")\n";
+    std::cout << "Committed transactions:    " << commits << "\n";
+    std::cout << "Execution time (s):        " << seconds << "\n";
+    std::cout << "Commits per second:        " << commits / seconds << "\n";
+    std::cout << "Aborts per second:         " << totals.aborts.load() / seconds << "\n";
+    std::cout << "Operations per second:     " << totals.operations.load() / seconds << "\n";
+    std::cout << "Average latency (us):      " << (commits ? (double)totals.latencyMicros.load() / commits : 0.0)
+        << "\n";
+    return commits == (long long)p.connections * p.txns ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#include "Engine.h"
+#include "Server.h"
+#include <csignal>
+#include <iostream>
+
+// Usage: ./server [--bind=ADDR] [--port=P] [--loops=N] [--pin] [--keys=M]
+//   --bind=ADDR      listen address (default 127.0.0.1)
+//   --port=P         listen port (default 7450)
+//   --loops=N        event loops, one per core by default
+//   --pin            pin loop i to the i-th CPU, filling one NUMA node before the next
+//   --keys=M         data items 0..M-1 (default 1000)
+// Serves until SIGINT or SIGTERM.
+int main(int argc, char** argv) {
+    std::string address = "127.0.0.1";
+    int port = 7450;
+    int loops = std::max(1u, std::thread::hardware_concurrency());
+    bool pin = false;
+    int m = 1000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.rfind("--bind=", 0) == 0) {
+            address = arg.substr(7);
+        }
+        else if (arg.rfind("--port=", 0) == 0) {
+            port = std::stoi(arg.substr(7));
+        }
+        else if (arg.rfind("--loops=", 0) == 0) {
+            loops = std::max(1, std::stoi(arg.substr(8)));
+        }
+        else if (arg == "--pin") {
+            pin = true;
+        }
+        else if (arg.rfind("--keys=", 0) == 0) {
+            m = std::max(1, std::stoi(arg.substr(7)));
+        }
+    }
+
+    // Block the stop signals before any loop starts so only sigwait sees them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    ServedManager manager(m);
+    TxServer<ServedManager> server(manager, m, address, port, loops, pin);
+    try {
+        port = server.start();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Serving " << SERVED_ENGINE << " (m=" << m << ") on " << address << ":" << port
+        << " with " << loops << " event loop(s)" << std::endl;
+
+    int signal = 0;
+    sigwait(&stopSignals, &signal);
+    server.stop();
+    std::cout << "Served " << server.requestsServed() << " requests, "
+        << server.operationsServed() << " operations\n";
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "SharedMemory.h"
+#include "../common/driver.h"
+
+int main(int argc, char** argv) {
+    return runDriver<SharedMemoryManager>(argc, argv, "SharedMemory");
+}
@@ -0,0 +1,6 @@
+#include "SharedMemory.h"
+#include "../common/microbench.h"
+
+ENGINE_BENCHMARKS(SharedMemoryManager);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include "SharedMemory.h"
+
+static const char* TEST_STORE = "/si_shared_store_test";
+
+// ✅ Test: Snapshot reads and first-committer-wins on one attachment
+TEST(SharedMemoryTest, SnapshotIsolationBasics) {
+    SharedMemoryManager::removeSegment(TEST_STORE);
+    SharedMemoryManager manager(2, TEST_STORE);
+
+    int tx1 = manager.beginTrans();
+    int tx2 = manager.beginTrans();
+    manager.write(tx1, 0, 10);
+    ASSERT_EQ(manager.read(tx1, 0), 10);
+    ASSERT_EQ(manager.read(tx2, 0), 0);
+
+    ASSERT_TRUE(manager.commit(tx1));
+    ASSERT_EQ(manager.read(tx2, 0), 0);   // still its snapshot
+    manager.write(tx2, 0, 20);
+    ASSERT_FALSE(manager.commit(tx2));    // write-write conflict
+
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 10);
+    ASSERT_TRUE(manager.commit(check));
+}
+
+// ✅ Test: Two attachments see each other's commits; the last one out removes the store
+TEST(SharedMemoryTest, AttachmentsShareTheStore) {
+    SharedMemoryManager::removeSegment(TEST_STORE);
+    {
+        SharedMemoryManager a(4, TEST_STORE);
+        SharedMemoryManager b(4, TEST_STORE);
+
+        int tx = a.beginTrans();
+        a.write(tx, 3, 42);
+        ASSERT_TRUE(a.commit(tx));
+
+        int seen = b.beginTrans();
+        ASSERT_EQ(b.read(seen, 3), 42);
+        ASSERT_EQ(a.read(seen, 3), -1);   // not a's transaction
+        ASSERT_TRUE(b.commit(seen));
+
+        ASSERT_THROW(SharedMemoryManager(5, TEST_STORE), std::runtime_error);
+    }
+    SharedMemoryManager fresh(4, TEST_STORE);
+    int tx = fresh.beginTrans();
+    ASSERT_EQ(fresh.read(tx, 3), 0);
+}
+
+// ✅ Test: Old versions are recycled once no snapshot needs them
+TEST(SharedMemoryTest, VersionSpaceIsReclaimed) {
+    SharedMemoryManager::removeSegment(TEST_STORE);
+    SharedMemoryManager manager(1, TEST_STORE, 16, 7);
+
+    int old = manager.beginTrans();
+    ASSERT_EQ(manager.read(old, 0), 0);
+    for (int v = 1; v <= 6; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    ASSERT_EQ(manager.read(old, 0), 0);
+    int blocked = manager.beginTrans();
+    manager.write(blocked, 0, 7);
+    ASSERT_FALSE(manager.commit(blocked)); // every record is pinned by the old snapshot
+    manager.abort(old);
+
+    for (int v = 7; v <= 100; ++v) {
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, v);
+        ASSERT_TRUE(manager.commit(tx));
+    }
+    int check = manager.beginTrans();
+    ASSERT_EQ(manager.read(check, 0), 100);
+}
+
+// ✅ Test: Increments from several processes are all applied
+TEST(SharedMemoryTest, ProcessesTransactConcurrently) {
+    SharedMemoryManager::removeSegment(TEST_STORE);
+    SharedMemoryManager parent(1, TEST_STORE);
+    const int children = 4, increments = 200;
+
+    std::vector<pid_t> pids;
+    for (int c = 0; c < children; ++c) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            SharedMemoryManager manager(1, TEST_STORE);
+            for (int i = 0; i < increments; ++i) {
+                while (true) {
+                    int tx = manager.beginTrans();
+                    int v = manager.read(tx, 0);
+                    manager.write(tx, 0, v + 1);
+                    if (manager.commit(tx)) {
+                        break;
+                    }
+                }
+            }
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+    for (pid_t pid : pids) {
+        int status;
+        waitpid(pid, &status, 0);
+        ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    int tx = parent.beginTrans();
+    ASSERT_EQ(parent.read(tx, 0), children * increments);
+}
+
+struct SharedMemoryTestAccess {
+    // Die holding the store mutex with txID's commit staged but not linked
+    [[noreturn]] static void crashMidCommit(SharedMemoryManager& manager, int txID) {
+        SharedTxSlot* slot = manager.lookup(txID);
+        manager.lockStore();
+        manager.stageCommit(*slot, manager.localWrites[txID % manager.poolSize]);
+        _exit(0);
+    }
+};
+
+// ✅ Test: A commit torn by its owner's death is rolled forward before the owner is reaped
+TEST(SharedMemoryTest, TornCommitRecoveredBeforeReaping) {
+    SharedMemoryManager::removeSegment(TEST_STORE);
+    SharedMemoryManager parent(2, TEST_STORE, 4, 8);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        SharedMemoryManager manager(2, TEST_STORE, 4, 8);
+        int tx = manager.beginTrans();
+        manager.write(tx, 0, 7);
+        manager.write(tx, 1, 7);
+        SharedMemoryTestAccess::crashMidCommit(manager, tx);
+    }
+
+    // Wait for the child to exit, but leave it a zombie
+    siginfo_t info;
+    ASSERT_EQ(waitid(P_PID, pid, &info, WEXITED | WNOWAIT), 0);
+
+    int tx = parent.beginTrans();
+    ASSERT_EQ(parent.read(tx, 0), 7);
+    ASSERT_EQ(parent.read(tx, 1), 7);
+    ASSERT_TRUE(parent.commit(tx));
+
+    // Churn through the version space, then reap: nothing is replayed
+    for (int v = 1; v <= 10; ++v) {
+        int w = parent.beginTrans();
+        parent.write(w, 0, v);
+        parent.write(w, 1, v);
+        ASSERT_TRUE(parent.commit(w));
+    }
+    waitpid(pid, nullptr, 0);
+    for (int round = 0; round < 3; ++round) {
+        int r = parent.beginTrans();
+        ASSERT_EQ(parent.read(r, 0), 10);
+        ASSERT_EQ(parent.read(r, 1), 10);
+        parent.write(r, 0, 10);
+        parent.write(r, 1, 10);
+        ASSERT_TRUE(parent.commit(r));
+    }
+}
+
+// ✅ Test: Killing a client mid-transaction neither wedges the store nor tears a commit
+TEST(SharedMemoryTest, KilledClientDoesNotWedgeOthers) {
+    SharedMemoryManager::removeSegment(TEST_STORE);
+    SharedMemoryManager parent(2, TEST_STORE, 4);
+
+    for (int round = 0; round < 20; ++round) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            // Hold every context, then commit pairs forever until killed
+            SharedMemoryManager manager(2, TEST_STORE, 4);
+            manager.beginTrans();
+            manager.beginTrans();
+            for (int v = 1;; ++v) {
+                int tx = manager.beginTrans();
+                manager.write(tx, 0, v);
+                manager.write(tx, 1, v);
+                manager.commit(tx);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5 + round));
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+
+        // Both keys always change together
+        int tx = parent.beginTrans();
+        ASSERT_EQ(parent.read(tx, 0), parent.read(tx, 1));
+        parent.write(tx, 0, 0);
+        parent.write(tx, 1, 0);
+        ASSERT_TRUE(parent.commit(tx));
+    }
+}
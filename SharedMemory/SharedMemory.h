@@ -0,0 +1,599 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <pthread.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Snapshot isolation over a store kept in a POSIX shared-memory segment, so
+// several local processes transact on the same data. Every managed object
+// lives in the segment and refers to others by array index, never by
+// pointer, since each process maps the segment at its own address.
+//
+// Begin, commit and garbage collection hold a robust process-shared mutex;
+// reads walk the version chains without it. When a process dies holding
+// the mutex, the next locker recovers: a commit that was being linked is
+// rolled forward from its redo list, the dead process's transaction
+// contexts are freed and the free version list is rebuilt from the chains.
+// Contexts of a process that died outside the mutex are reclaimed as soon
+// as they are needed. The segment is unlinked when the last attached
+// process detaches; one left behind by crashed processes is discarded by
+// the next one to attach.
+
+constexpr const char* SHARED_SEGMENT_NAME = "/si_shared_store";
+constexpr uint32_t SHARED_MAGIC = 0x53495348;
+constexpr int SHARED_HISTORY_VERSIONS = 1 << 18; // Version records beyond one per key
+constexpr int SHARED_MAX_PROCESSES = 64;
+
+struct SharedVersion {
+    int value;
+    int commit_ts;
+    int key;
+    std::atomic<int> prev;  // Next older version of the key, -1 = none
+    int next;               // Free list link, or the next version of the same commit
+};
+
+enum SharedSlotState : int {
+    SLOT_FREE,
+    SLOT_ACTIVE,
+    SLOT_COMMITTING        // Versions allocated, being linked into the chains
+};
+
+// Transaction context. txID % poolSize selects the slot, the quotient is a
+// generation that changes whenever the slot is reused.
+struct alignas(64) SharedTxSlot {
+    std::atomic<int> state;
+    std::atomic<int> owner;     // pid, to detect that the owner has exited
+    std::atomic<int> attachment; // Which attachment of that process owns it
+    std::atomic<int> txID;
+    int start_ts;
+    int commit_ts;
+    int redoHead;               // First new version of the commit in progress
+};
+
+struct SharedHeader {
+    std::atomic<uint32_t> magic;    // Stored last by the creator
+    int m;
+    int poolSize;
+    int versionCapacity;
+    pthread_mutex_t mutex;          // Robust, process-shared
+    bool retired;                   // Unlinked; attachers must open the name again
+    std::atomic<int> globalTS;
+    int nextAttachment;
+    int freeHead;                   // Free version records
+    int freeCount;
+    int processes[SHARED_MAX_PROCESSES]; // Attached pids, 0 = free entry
+};
+
+// Offsets of the arrays that follow the header
+struct SharedLayout {
+    size_t heads, slots, versions, size;
+
+    SharedLayout(int m, int poolSize, int versionCapacity) {
+        auto align = [](size_t off) { return (off + 63) & ~(size_t)63; };
+        heads = align(sizeof(SharedHeader));
+        slots = align(heads + sizeof(std::atomic<int>) * m);
+        versions = align(slots + sizeof(SharedTxSlot) * poolSize);
+        size = align(versions + sizeof(SharedVersion) * versionCapacity);
+    }
+};
+
+class SharedMemoryManager {
+private:
+    friend struct SharedMemoryTestAccess;
+
+    std::string name;
+    void* base = nullptr;
+    size_t mappedSize = 0;
+    SharedHeader* header = nullptr;
+    std::atomic<int>* heads = nullptr;  // Newest version of each key
+    SharedTxSlot* slots = nullptr;
+    SharedVersion* versions = nullptr;
+    int poolSize = 0;
+    int pid;
+    int attachment = 0;     // Distinguishes several attachments of one process
+
+    // Buffered writes of this process's transactions, per slot
+    std::vector<std::vector<std::pair<int, int>>> localWrites;
+
+    class StoreLock {
+    private:
+        SharedMemoryManager& manager;
+
+    public:
+        explicit StoreLock(SharedMemoryManager& manager) : manager(manager) {
+            manager.lockStore();
+        }
+        ~StoreLock() {
+            pthread_mutex_unlock(&manager.header->mutex);
+        }
+    };
+
+    static bool processDead(int owner) {
+        return owner != 0 && kill(owner, 0) == -1 && errno == ESRCH;
+    }
+
+    void lockStore() {
+        int rc = pthread_mutex_lock(&header->mutex);
+        if (rc == EOWNERDEAD) {
+            recover();
+            pthread_mutex_consistent(&header->mutex);
+        }
+        else if (rc != 0) {
+            throw std::runtime_error("shared store mutex unusable: " + std::string(strerror(rc)));
+        }
+    }
+
+    SharedTxSlot* lookup(int txID) {
+        if (txID < 0) {
+            return nullptr;
+        }
+        SharedTxSlot& slot = slots[txID % poolSize];
+        if (slot.txID.load(std::memory_order_relaxed) != txID || slot.owner.load(std::memory_order_relaxed) != pid ||
+            slot.attachment.load(std::memory_order_relaxed) != attachment ||
+            slot.state.load(std::memory_order_acquire) == SLOT_FREE) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    void release(SharedTxSlot& slot, int slotIndex) {
+        localWrites[slotIndex].clear();
+        slot.state.store(SLOT_FREE, std::memory_order_release);
+    }
+
+    // Link a commit's versions at the heads of their chains. Idempotent, so
+    // recovery can finish a commit its owner died in the middle of.
+    void linkCommit(SharedTxSlot& slot) {
+        for (int v = slot.redoHead; v >= 0; v = versions[v].next) {
+            int head = heads[versions[v].key].load(std::memory_order_relaxed);
+            if (head != v) {
+                versions[v].prev.store(head, std::memory_order_relaxed);
+                heads[versions[v].key].store(v, std::memory_order_release);
+            }
+        }
+    }
+
+    // Mutex held. Free contexts whose owner has exited, finishing any commit
+    // it was linking.
+    bool reclaimDeadSlots() {
+        bool reclaimed = false;
+        for (int i = 0; i < poolSize; ++i) {
+            SharedTxSlot& slot = slots[i];
+            int state = slot.state.load(std::memory_order_acquire);
+            if (state != SLOT_FREE && processDead(slot.owner.load(std::memory_order_relaxed))) {
+                if (state == SLOT_COMMITTING) {
+                    linkCommit(slot);
+                }
+                slot.state.store(SLOT_FREE, std::memory_order_release);
+                reclaimed = true;
+            }
+        }
+        for (int& p : header->processes) {
+            if (processDead(p)) {
+                p = 0;
+            }
+        }
+        return reclaimed;
+    }
+
+    // Mutex held. Cut every chain below the newest version visible to the
+    // oldest active snapshot and rebuild the free list from whatever is no
+    // longer reachable, which includes records leaked by a crashed commit.
+    void collectGarbage() {
+        int oldest = header->globalTS.load();
+        for (int i = 0; i < poolSize; ++i) {
+            if (slots[i].state.load(std::memory_order_acquire) != SLOT_FREE) {
+                oldest = std::min(oldest, slots[i].start_ts);
+            }
+        }
+
+        std::vector<char> live(header->versionCapacity, 0);
+        for (int key = 0; key < header->m; ++key) {
+            for (int v = heads[key].load(std::memory_order_relaxed); v >= 0;
+                v = versions[v].prev.load(std::memory_order_relaxed)) {
+                live[v] = 1;
+                if (versions[v].commit_ts <= oldest) {
+                    versions[v].prev.store(-1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+
+        header->freeHead = -1;
+        header->freeCount = 0;
+        for (int v = header->versionCapacity - 1; v >= 0; --v) {
+            if (!live[v]) {
+                versions[v].next = header->freeHead;
+                header->freeHead = v;
+                ++header->freeCount;
+            }
+        }
+    }
+
+    // The previous holder died with the mutex held. Commits are only
+    // linked under the mutex, so a committing context can only be the dead
+    // holder's: finish it now, even if that process is not reaped yet and
+    // still looks alive to kill(), before collection reuses its records.
+    void recover() {
+        for (int i = 0; i < poolSize; ++i) {
+            SharedTxSlot& slot = slots[i];
+            if (slot.state.load(std::memory_order_acquire) == SLOT_COMMITTING) {
+                linkCommit(slot);
+                slot.state.store(SLOT_FREE, std::memory_order_release);
+            }
+        }
+        reclaimDeadSlots();
+        collectGarbage();
+    }
+
+    // Mutex held. Fill the new versions of a commit, then publish them as
+    // a redo list before linking any, so recovery can finish the commit
+    void stageCommit(SharedTxSlot& slot, const std::vector<std::pair<int, int>>& writes) {
+        int commit_ts = header->globalTS.fetch_add(1);
+        int redo = -1;
+        for (auto it = writes.rbegin(); it != writes.rend(); ++it) {
+            int v = header->freeHead;
+            header->freeHead = versions[v].next;
+            --header->freeCount;
+            versions[v].value = it->second;
+            versions[v].commit_ts = commit_ts;
+            versions[v].key = it->first;
+            versions[v].next = redo;
+            redo = v;
+        }
+        slot.redoHead = redo;
+        slot.commit_ts = commit_ts;
+        slot.state.store(SLOT_COMMITTING, std::memory_order_release);
+    }
+
+    void initialize(int m, int maxActiveTx, int versionCapacity) {
+        header->m = m;
+        header->poolSize = maxActiveTx;
+        header->versionCapacity = versionCapacity;
+        header->retired = false;
+        header->globalTS.store(1);
+        header->nextAttachment = 1;
+
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&header->mutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+
+        // Version k is key k's initial value 0; the rest start out free
+        for (int k = 0; k < m; ++k) {
+            versions[k].value = 0;
+            versions[k].commit_ts = 0;
+            versions[k].key = k;
+            versions[k].prev.store(-1);
+            heads[k].store(k);
+        }
+        header->freeHead = -1;
+        header->freeCount = 0;
+        for (int v = versionCapacity - 1; v >= m; --v) {
+            versions[v].next = header->freeHead;
+            header->freeHead = v;
+            ++header->freeCount;
+        }
+        for (int i = 0; i < maxActiveTx; ++i) {
+            slots[i].state.store(SLOT_FREE);
+            slots[i].owner.store(0);
+            slots[i].attachment.store(0);
+            slots[i].txID.store(i); // generation 0, never handed out
+        }
+        for (int& p : header->processes) {
+            p = 0;
+        }
+        header->processes[0] = pid;
+        attachment = header->nextAttachment++;
+    }
+
+    void mapSegment(int fd, size_t size) {
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            throw std::runtime_error("mmap of shared store failed: " + std::string(strerror(errno)));
+        }
+        mappedSize = size;
+        header = static_cast<SharedHeader*>(base);
+    }
+
+    void locateArrays(int m, int maxActiveTx, int versionCapacity) {
+        SharedLayout layout(m, maxActiveTx, versionCapacity);
+        char* bytes = static_cast<char*>(base);
+        heads = reinterpret_cast<std::atomic<int>*>(bytes + layout.heads);
+        slots = reinterpret_cast<SharedTxSlot*>(bytes + layout.slots);
+        versions = reinterpret_cast<SharedVersion*>(bytes + layout.versions);
+        poolSize = maxActiveTx;
+    }
+
+    void unmap() {
+        if (base) {
+            munmap(base, mappedSize);
+            base = nullptr;
+        }
+    }
+
+    // Wait for a creator to finish; false if it seems to have died first
+    static bool awaitReady(int fd) {
+        for (int i = 0; i < 2000; ++i) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(SharedHeader)) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+public:
+    // Attach to the store called name, creating it if no live process has
+    // it. Attaching with a different m or pool size throws.
+    SharedMemoryManager(int m, const std::string& name = SHARED_SEGMENT_NAME, int maxActiveTx = 1024,
+        int versionCapacity = -1)
+        : name(name), pid((int)getpid()) {
+        if (versionCapacity < 0) {
+            versionCapacity = m + SHARED_HISTORY_VERSIONS;
+        }
+        versionCapacity = std::max(versionCapacity, m + 1);
+
+        while (true) {
+            int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd >= 0) {
+                SharedLayout layout(m, maxActiveTx, versionCapacity);
+                if (ftruncate(fd, (off_t)layout.size) != 0) {
+                    close(fd);
+                    shm_unlink(name.c_str());
+                    throw std::runtime_error("cannot size shared store: " + std::string(strerror(errno)));
+                }
+                mapSegment(fd, layout.size);
+                close(fd);
+                locateArrays(m, maxActiveTx, versionCapacity);
+                initialize(m, maxActiveTx, versionCapacity);
+                header->magic.store(SHARED_MAGIC, std::memory_order_release);
+                break;
+            }
+            if (errno != EEXIST) {
+                throw std::runtime_error("shm_open failed: " + std::string(strerror(errno)));
+            }
+
+            fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) {
+                continue;   // Unlinked in the meantime
+            }
+            if (!awaitReady(fd)) {
+                close(fd);
+                shm_unlink(name.c_str()); // Creator died before sizing it
+                continue;
+            }
+            struct stat st;
+            fstat(fd, &st);
+            mapSegment(fd, (size_t)st.st_size);
+            close(fd);
+            for (int i = 0; i < 2000 && header->magic.load(std::memory_order_acquire) != SHARED_MAGIC; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (header->magic.load(std::memory_order_acquire) != SHARED_MAGIC) {
+                unmap();
+                shm_unlink(name.c_str());
+                continue;
+            }
+            locateArrays(header->m, header->poolSize, header->versionCapacity);
+
+            lockStore();
+            if (header->retired) {
+                pthread_mutex_unlock(&header->mutex);
+                unmap();
+                continue;
+            }
+            reclaimDeadSlots();
+            bool attached = false;
+            for (int p : header->processes) {
+                attached |= (p != 0);
+            }
+            if (!attached) {
+                // Left behind by processes that crashed: start over
+                header->retired = true;
+                pthread_mutex_unlock(&header->mutex);
+                shm_unlink(name.c_str());
+                unmap();
+                continue;
+            }
+            if (header->m != m || header->poolSize != maxActiveTx) {
+                pthread_mutex_unlock(&header->mutex);
+                unmap();
+                throw std::runtime_error("shared store " + name + " has different parameters");
+            }
+            bool registered = false;
+            for (int& p : header->processes) {
+                if (p == 0) {
+                    p = pid;
+                    registered = true;
+                    break;
+                }
+            }
+            attachment = header->nextAttachment++;
+            pthread_mutex_unlock(&header->mutex);
+            if (!registered) {
+                unmap();
+                throw std::runtime_error("too many processes attached to " + name);
+            }
+            break;
+        }
+        localWrites.resize(poolSize);
+    }
+
+    // Attach to the default segment with room for maxActiveTx transactions
+    static SharedMemoryManager withContextPool(int m, int maxActiveTx) {
+        return SharedMemoryManager(m, SHARED_SEGMENT_NAME, maxActiveTx);
+    }
+
+    int contextPoolSize() const {
+        return poolSize;
+    }
+
+    // Detach; the last process to leave removes the segment
+    ~SharedMemoryManager() {
+        if (!base) {
+            return;
+        }
+        bool last;
+        {
+            StoreLock lk(*this);
+            for (int i = 0; i < poolSize; ++i) {
+                if (slots[i].owner.load(std::memory_order_relaxed) == pid &&
+                    slots[i].attachment.load(std::memory_order_relaxed) == attachment) {
+                    slots[i].state.store(SLOT_FREE, std::memory_order_release);
+                }
+            }
+            for (int& p : header->processes) {
+                if (p == pid) {
+                    p = 0;
+                    break;
+                }
+            }
+            last = true;
+            for (int p : header->processes) {
+                last &= (p == 0);
+            }
+            header->retired = last;
+        }
+        if (last) {
+            shm_unlink(name.c_str());
+        }
+        unmap();
+    }
+
+    SharedMemoryManager(const SharedMemoryManager&) = delete;
+    SharedMemoryManager& operator=(const SharedMemoryManager&) = delete;
+
+    // Remove a store left behind, e.g. before a benchmark run
+    static void removeSegment(const std::string& name = SHARED_SEGMENT_NAME) {
+        shm_unlink(name.c_str());
+    }
+
+    int beginTrans() {
+        int txID;
+        while ((txID = tryBeginTrans()) < 0) {
+            std::this_thread::yield();
+        }
+        return txID;
+    }
+
+    // Non-blocking begin: -1 if every transaction context is in use
+    int tryBeginTrans() {
+        static thread_local int cursor = 0;
+        StoreLock lk(*this);
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            for (int i = 0; i < poolSize; ++i) {
+                int index = (cursor + i) % poolSize;
+                SharedTxSlot& slot = slots[index];
+                if (slot.state.load(std::memory_order_acquire) == SLOT_FREE) {
+                    cursor = index;
+                    int txID = slot.txID.load(std::memory_order_relaxed) + poolSize; // next generation
+                    slot.txID.store(txID, std::memory_order_relaxed);
+                    slot.owner.store(pid, std::memory_order_relaxed);
+                    slot.attachment.store(attachment, std::memory_order_relaxed);
+                    slot.start_ts = header->globalTS.fetch_add(1);
+                    slot.state.store(SLOT_ACTIVE, std::memory_order_release);
+                    localWrites[index].clear();
+                    return txID;
+                }
+            }
+            if (!reclaimDeadSlots()) {
+                break;
+            }
+        }
+        return -1;
+    }
+
+    // Lock-free: versions reachable from a snapshot are never collected
+    // while it is active
+    int read(int txID, int index) {
+        SharedTxSlot* slot = lookup(txID);
+        if (!slot) {
+            return -1;
+        }
+        for (const auto& [key, value] : localWrites[txID % poolSize]) {
+            if (key == index) {
+                return value;
+            }
+        }
+        int v = heads[index].load(std::memory_order_acquire);
+        while (v >= 0 && versions[v].commit_ts > slot->start_ts) {
+            v = versions[v].prev.load(std::memory_order_acquire);
+        }
+        return v >= 0 ? versions[v].value : 0;
+    }
+
+    void write(int txID, int index, int val) {
+        if (!lookup(txID)) {
+            return;
+        }
+        auto& writes = localWrites[txID % poolSize];
+        for (auto& w : writes) {
+            if (w.first == index) {
+                w.second = val;
+                return;
+            }
+        }
+        writes.emplace_back(index, val);
+    }
+
+    bool commit(int txID) {
+        SharedTxSlot* slot = lookup(txID);
+        if (!slot) {
+            return false;
+        }
+        int slotIndex = txID % poolSize;
+        const auto& writes = localWrites[slotIndex];
+
+        StoreLock lk(*this);
+        for (const auto& [key, _] : writes) {
+            if (versions[heads[key].load(std::memory_order_relaxed)].commit_ts > slot->start_ts) {
+                release(*slot, slotIndex);
+                return false; // write-write conflict
+            }
+        }
+        if (writes.empty()) {
+            release(*slot, slotIndex);
+            return true;
+        }
+        if (header->freeCount < (int)writes.size()) {
+            reclaimDeadSlots();     // Their snapshots would pin old versions
+            collectGarbage();
+            if (header->freeCount < (int)writes.size()) {
+                release(*slot, slotIndex);
+                return false; // Out of version space
+            }
+        }
+
+        stageCommit(*slot, writes);
+        linkCommit(*slot);
+        release(*slot, slotIndex);
+        return true;
+    }
+
+    void abort(int txID) {
+        SharedTxSlot* slot = lookup(txID);
+        if (slot) {
+            release(*slot, txID % poolSize);
+        }
+    }
+};
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../SI/SI.h"
+#include "../common/driver.h"
+#include "TraceText.h"
+
+static std::vector<TraceEntry> entries(const TraceStream& stream) {
+    std::vector<TraceEntry> out;
+    TraceCursor cursor(stream);
+    TraceEntry e;
+    while (cursor.next(e)) {
+        out.push_back(e);
+    }
+    return out;
+}
+
+// ✅ Test: Entries decode to what was encoded, negative values and large keys included
+TEST(TraceTest, EntriesRoundTrip) {
+    TraceStream stream;
+    std::vector<TraceEntry> written = {
+        { TRACE_BEGIN }, { TRACE_READ, 3, 0, 1500 }, { TRACE_WRITE, 1 << 30, -7, 0 },
+        { TRACE_RMW, 0, -2147483647 - 1, 7 }, { TRACE_ADD, 127, 2147483647, 128 }, { TRACE_COMMIT },
+    };
+    for (const auto& e : written) {
+        appendTraceEntry(stream.bytes, e);
+    }
+    auto read = entries(stream);
+    ASSERT_EQ(read.size(), written.size());
+    for (size_t i = 0; i < read.size(); ++i) {
+        ASSERT_EQ(read[i].op, written[i].op);
+        ASSERT_EQ(read[i].key, written[i].key);
+        ASSERT_EQ(read[i].value, written[i].value);
+        ASSERT_EQ(read[i].thinkMicros, written[i].thinkMicros);
+    }
+}
+
+// ✅ Test: The recorder keeps committed attempts only, with their think times
+TEST(TraceTest, RecorderDropsAbortedAttempts) {
+    TraceStream stream;
+    TraceRecorder recorder(&stream);
+    recorder.begin(false);
+    recorder.op(TRACE_RMW, 1, 5);
+    recorder.commit(false);
+    recorder.begin(true);
+    recorder.op(TRACE_READ, 2);
+    recorder.think(2000);
+    recorder.op(TRACE_READ, 3);
+    recorder.commit(true);
+
+    ASSERT_EQ(stream.transactions, 1);
+    TraceCursor cursor(stream);
+    bool readOnly = false;
+    std::vector<TraceEntry> ops;
+    ASSERT_TRUE(cursor.nextTransaction(readOnly, ops));
+    ASSERT_TRUE(readOnly);
+    ASSERT_EQ(ops.size(), 2u);
+    ASSERT_EQ(ops[0].key, 2);
+    ASSERT_EQ(ops[0].thinkMicros, 2000);
+    ASSERT_EQ(ops[1].thinkMicros, 0);
+    ASSERT_FALSE(cursor.nextTransaction(readOnly, ops));
+}
+
+// ✅ Test: Text import, binary save/load and text dump agree
+TEST(TraceTest, TextAndFileRoundTrip) {
+    std::string text =
+        "# two clients\n"
+        "m 10\n"
+        "stream\n"
+        "begin\n"
+        "rmw 1 5 100\n"
+        "write 2 -3\n"
+        "commit\n"
+        "stream\n"
+        "begin-read-only\n"
+        "read 9\n"
+        "commit\n";
+    std::istringstream in(text);
+    Trace trace;
+    std::string error;
+    ASSERT_TRUE(parseTraceText(in, trace, error)) << error;
+    ASSERT_EQ(trace.m, 10);
+    ASSERT_EQ(trace.streams.size(), 2u);
+
+    std::string path = testing::TempDir() + "trace-test.bin";
+    ASSERT_TRUE(saveTrace(trace, path));
+    Trace loaded;
+    ASSERT_TRUE(loadTrace(path, loaded, error)) << error;
+    std::remove(path.c_str());
+
+    std::ostringstream dumped;
+    formatTrace(loaded, dumped);
+    ASSERT_EQ(dumped.str(),
+        "m 10\nstream\nbegin\nrmw 1 5 100\nwrite 2 -3\ncommit\nstream\nbegin-read-only\nread 9\ncommit\n");
+}
+
+// ✅ Test: Malformed text and files are rejected
+TEST(TraceTest, RejectsMalformedInput) {
+    Trace trace;
+    std::string error;
+    for (std::string text : { "begin\ncommit\n", "stream\nread 1\n", "stream\nbegin\nread 1\n",
+                              "m 2\nstream\nbegin\nread 5\ncommit\n", "stream\nbegin\nfetch 1\ncommit\n" }) {
+        std::istringstream in(text);
+        ASSERT_FALSE(parseTraceText(in, trace, error)) << text;
+    }
+    std::string path = testing::TempDir() + "not-a-trace.bin";
+    {
+        std::ofstream out(path);
+        out << "hello";
+    }
+    ASSERT_FALSE(loadTrace(path, trace, error));
+    std::remove(path.c_str());
+}
+
+// ✅ Test: Replaying a trace twice from one thread ends in the same state
+TEST(TraceTest, ReplayIsDeterministic) {
+    std::istringstream in(
+        "stream\nbegin\nrmw 0 5\nrmw 1 2\ncommit\nbegin\nadd 0 10\ncommit\n"
+        "stream\nbegin\nwrite 1 40\nrmw 0 1\ncommit\nbegin-read-only\nread 0\nread 1\ncommit\n");
+    Trace trace;
+    std::string error;
+    ASSERT_TRUE(parseTraceText(in, trace, error)) << error;
+
+    std::vector<int> finals[2];
+    for (auto& state : finals) {
+        totalCommitted = 0;
+        SnapshotIsolationManager manager(2);
+        replayWorkerThread<SnapshotIsolationManager>(1, 1, -1, &manager, &trace, false);
+        ASSERT_EQ(totalCommitted.load(), 4);
+        int ts = manager.currentTimestamp();
+        state = { manager.readAsOf(0, ts), manager.readAsOf(1, ts) };
+    }
+    ASSERT_EQ(finals[0], finals[1]);
+    ASSERT_EQ(finals[0], (std::vector<int>{ 16, 40 }));
+}
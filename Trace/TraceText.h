@@ -0,0 +1,135 @@
+#pragma once
+
+// Human-readable form of a trace (common/trace.h), for inspecting recorded
+// traces and for importing ones captured elsewhere. One entry per line:
+//   m <M>                         keys are 0..M-1 (optional, else inferred)
+//   stream                        starts the next stream
+//   begin | begin-read-only
+//   read <key> [think_us]
+//   write <key> <value> [think_us]
+//   rmw <key> <delta> [think_us]  write the value just read plus delta
+//   add <key> <delta> [think_us]  blind increment
+//   commit
+// Blank lines and lines starting with '#' are ignored.
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include "../common/trace.h"
+
+inline const char* traceOpName(TraceOp op) {
+    switch (op) {
+    case TRACE_BEGIN: return "begin";
+    case TRACE_BEGIN_READ_ONLY: return "begin-read-only";
+    case TRACE_READ: return "read";
+    case TRACE_WRITE: return "write";
+    case TRACE_RMW: return "rmw";
+    case TRACE_ADD: return "add";
+    case TRACE_COMMIT: return "commit";
+    }
+    return "?";
+}
+
+inline void formatTrace(const Trace& trace, std::ostream& out) {
+    out << "m " << trace.m << "\n";
+    for (const auto& stream : trace.streams) {
+        out << "stream\n";
+        TraceCursor cursor(stream);
+        TraceEntry e;
+        while (cursor.next(e)) {
+            out << traceOpName(e.op);
+            if (traceOpHasKey(e.op)) {
+                out << " " << e.key;
+            }
+            if (traceOpHasValue(e.op)) {
+                out << " " << e.value;
+            }
+            if (e.thinkMicros > 0) {
+                out << " " << e.thinkMicros;
+            }
+            out << "\n";
+        }
+    }
+}
+
+// False with a message naming the line on malformed input
+inline bool parseTraceText(std::istream& in, Trace& trace, std::string& error) {
+    trace = Trace{};
+    int declaredM = -1, maxKey = -1;
+    bool inTransaction = false;
+    std::string line;
+    for (int lineNo = 1; std::getline(in, line); ++lineNo) {
+        std::istringstream fields(line);
+        std::string word;
+        if (!(fields >> word) || word[0] == '#') {
+            continue;
+        }
+        auto fail = [&](const std::string& what) {
+            error = "line " + std::to_string(lineNo) + ": " + what;
+            return false;
+        };
+
+        if (word == "m") {
+            if (!(fields >> declaredM) || declaredM < 1) {
+                return fail("bad key count");
+            }
+            continue;
+        }
+        if (word == "stream") {
+            if (inTransaction) {
+                return fail("stream starts inside a transaction");
+            }
+            trace.streams.emplace_back();
+            continue;
+        }
+        if (trace.streams.empty()) {
+            return fail("entry before the first stream");
+        }
+        TraceStream& stream = trace.streams.back();
+
+        TraceEntry e{ TRACE_COMMIT };
+        bool found = false;
+        for (int op = TRACE_BEGIN; op <= TRACE_COMMIT; ++op) {
+            if (word == traceOpName((TraceOp)op)) {
+                e.op = (TraceOp)op;
+                found = true;
+            }
+        }
+        if (!found) {
+            return fail("unknown entry '" + word + "'");
+        }
+        bool begins = e.op == TRACE_BEGIN || e.op == TRACE_BEGIN_READ_ONLY;
+        if (begins == inTransaction) {
+            return fail(begins ? "begin inside a transaction" : "entry outside a transaction");
+        }
+        if (traceOpHasKey(e.op)) {
+            if (!(fields >> e.key) || e.key < 0) {
+                return fail("bad key");
+            }
+            if (traceOpHasValue(e.op) && !(fields >> e.value)) {
+                return fail("missing value");
+            }
+            if (!(fields >> e.thinkMicros)) {
+                e.thinkMicros = 0;
+            }
+            maxKey = std::max(maxKey, e.key);
+        }
+        appendTraceEntry(stream.bytes, e);
+        inTransaction = e.op != TRACE_COMMIT;
+        if (e.op == TRACE_COMMIT) {
+            ++stream.transactions;
+        }
+    }
+    if (inTransaction) {
+        error = "trace ends inside a transaction";
+        return false;
+    }
+    if (declaredM >= 0 && maxKey >= declaredM) {
+        error = "key " + std::to_string(maxKey) + " is outside m " + std::to_string(declaredM);
+        return false;
+    }
+    trace.m = declaredM >= 0 ? declaredM : maxKey + 1;
+    return true;
+}
@@ -0,0 +1,76 @@
+#!/bin/bash
+
+# Script to replay one recorded workload against every interactive engine
+# Experiment 1: Record a run on SI, then replay its committed transactions at
+#               full speed on each engine and compare throughput on identical work
+# Experiment 2: Replay the same trace on SI with 1 to 8 threads
+
+# Compilation (adjust compiler flags as needed)
+echo "Compiling the programs..."
+g++ -std=c++17 -O2 -pthread -o trace-tool trace-tool.cc
+g++ -std=c++17 -O2 -pthread -o si.out ../SI/SI-run.cc
+g++ -std=c++17 -O2 -pthread -o ssn.out ../SI-SSN/SI-run.cc
+g++ -std=c++17 -O2 -pthread -o occ.out ../OCC/SI-run.cc
+g++ -std=c++17 -O2 -pthread -o ssi.out ../SSI/SI-run.cc
+g++ -std=c++17 -O2 -pthread -o mv2pl.out ../MV2PL/SI-run.cc
+
+# Constants for experiments
+THREADS=8        # Recording clients, one trace stream each
+M=1000           # Number of data items
+NUM_TRANS=500    # Transactions per thread
+CONST_VAL=100    # Maximum value for writes
+NUM_ITERS=10     # Operations per transaction
+LAMBDA=1         # Mean delay between operations (ms) while recording
+READ_RATIO=0.7
+SKEW=0.8
+TRACE=workload.trace
+
+# Record once
+echo "$THREADS $M $NUM_TRANS $CONST_VAL $NUM_ITERS $LAMBDA $READ_RATIO" > inp-params.txt
+./si.out --skew=$SKEW --record=$TRACE
+./trace-tool info $TRACE
+
+# Function to replay the trace on one engine
+run_replay() {
+    local binary=$1
+    local threads=$2
+    local output_dir=$3
+    local tag=$4
+
+    echo "Replaying on $binary with threads=$threads"
+    mkdir -p "$output_dir"
+
+    # Only n and m matter on replay, the trace supplies the transactions
+    echo "$threads $M $NUM_TRANS $CONST_VAL $NUM_ITERS $LAMBDA $READ_RATIO" > inp-params.txt
+    ./$binary --replay=$TRACE
+
+    cp si_result.txt "$output_dir/result_${tag}.txt"
+    cp si_log.txt "$output_dir/log_${tag}.txt"
+
+    commits_per_sec=$(grep "Commits per second" si_result.txt | awk '{print $4}')
+    aborts_per_sec=$(grep "Aborts per second" si_result.txt | awk '{print $4}')
+}
+
+# Experiment 1: Same trace, every engine
+exp1_dir="experiment_replay_engines"
+mkdir -p "$exp1_dir"
+echo "engine,commits_per_sec,aborts_per_sec" > "$exp1_dir/summary.csv"
+
+for engine in si ssn occ ssi mv2pl; do
+    run_replay $engine.out $THREADS "$exp1_dir" "$engine"
+    echo "$engine,$commits_per_sec,$aborts_per_sec" >> "$exp1_dir/summary.csv"
+done
+
+# Experiment 2: Same trace, varying threads
+exp2_dir="experiment_replay_threads"
+mkdir -p "$exp2_dir"
+echo "threads,commits_per_sec,aborts_per_sec" > "$exp2_dir/summary.csv"
+
+for threads in 1 2 4 8; do
+    run_replay si.out $threads "$exp2_dir" "t${threads}"
+    echo "$threads,$commits_per_sec,$aborts_per_sec" >> "$exp2_dir/summary.csv"
+done
+
+echo "Experiments completed!"
+echo "Results for engine comparison are in: $exp1_dir"
+echo "Results for thread variation are in: $exp2_dir"
@@ -0,0 +1,66 @@
+#include <fstream>
+#include <iostream>
+#include "TraceText.h"
+
+// Usage: ./trace-tool info FILE             streams, transactions and operation mix
+//        ./trace-tool dump FILE             the trace as text (see TraceText.h)
+//        ./trace-tool import TEXT FILE      write a text trace as a binary trace
+// Exit status is 0 on success, 1 on bad usage or an unreadable input.
+int main(int argc, char** argv) {
+    std::string command = argc > 1 ? argv[1] : "";
+    if (!((command == "info" || command == "dump") && argc == 3) && !(command == "import" && argc == 4)) {
+        std::cerr << "Usage: " << argv[0] << " info FILE | dump FILE | import TEXT FILE\n";
+        return 1;
+    }
+
+    Trace trace;
+    std::string error;
+    if (command == "import") {
+        std::ifstream in(argv[2]);
+        if (!in.is_open()) {
+            std::cerr << "Error: Could not open " << argv[2] << "\n";
+            return 1;
+        }
+        if (!parseTraceText(in, trace, error)) {
+            std::cerr << "Error: " << argv[2] << ", " << error << "\n";
+            return 1;
+        }
+        if (!saveTrace(trace, argv[3])) {
+            std::cerr << "Error: Could not write " << argv[3] << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!loadTrace(argv[2], trace, error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    if (command == "dump") {
+        formatTrace(trace, std::cout);
+        return 0;
+    }
+
+    long long transactions = 0, bytes = 0, think = 0;
+    long long ops[TRACE_COMMIT + 1] = {};
+    for (const auto& stream : trace.streams) {
+        transactions += stream.transactions;
+        bytes += stream.bytes.size();
+        TraceCursor cursor(stream);
+        TraceEntry e;
+        while (cursor.next(e)) {
+            ++ops[e.op];
+            think += e.thinkMicros;
+        }
+    }
+    long long operations = ops[TRACE_READ] + ops[TRACE_WRITE] + ops[TRACE_RMW] + ops[TRACE_ADD];
+    std::cout << "Keys (m):                  " << trace.m << "\n";
+    std::cout << "Streams:                   " << trace.streams.size() << "\n";
+    std::cout << "Transactions:              " << transactions << " (" << ops[TRACE_BEGIN_READ_ONLY] << " read-only)\n";
+    std::cout << "Operations:                " << operations << "\n";
+    std::cout << "read / write / rmw / add:  " << ops[TRACE_READ] << " / " << ops[TRACE_WRITE] << " / "
+        << ops[TRACE_RMW] << " / " << ops[TRACE_ADD] << "\n";
+    std::cout << "Recorded think time (s):   " << think / 1e6 << "\n";
+    std::cout << "Bytes per operation:       " << (operations ? (double)bytes / operations : 0.0) << "\n";
+    return 0;
+}
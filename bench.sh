@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Build and run the per-operation microbenchmarks (<Engine>/<Engine>-bench.cc,
+# needs Google Benchmark) and optionally compare against an earlier run.
+#
+# Usage: bash bench.sh [OUT_DIR] [BASELINE_DIR]
+#   OUT_DIR       where <Engine>.json results go (default: bench_results)
+#   BASELINE_DIR  earlier OUT_DIR; benchmarks more than $THRESHOLD (default
+#                 10%) slower are reported and the script exits with status 3
+# ENGINES="SI OCC" limits the run, BENCH_ARGS is passed to every binary
+# (e.g. BENCH_ARGS="--benchmark_filter=Commit --benchmark_repetitions=5").
+
+root=$(dirname "$(realpath "$0")")
+out=$(realpath -m "${1:-bench_results}")
+baseline=${2:+$(realpath "$2")}
+engines=${ENGINES:-"SI SI-SSN OCC SSI Partitioned Calvin SharedMemory MV2PL"}
+threshold=${THRESHOLD:-0.10}
+
+mkdir -p "$out"
+for engine in $engines; do
+    echo "Benchmarking $engine"
+    cd "$root/$engine" || exit 1
+    g++ -std=c++17 -O2 -pthread -o bench "$engine-bench.cc" -lbenchmark -lrt || exit 1
+    ./bench --benchmark_out="$out/$engine.json" --benchmark_out_format=json $BENCH_ARGS || exit 1
+    rm -f bench
+done
+echo "Results are in: $out"
+
+if [ -n "$baseline" ]; then
+    python3 - "$out" "$baseline" "$threshold" $engines <<'PY'
+import json, os, sys
+
+out, baseline, threshold, engines = sys.argv[1], sys.argv[2], float(sys.argv[3]), sys.argv[4:]
+
+def times(path):
+    # real_time for UseRealTime benchmarks, CPU time otherwise; means only
+    # when repetitions were requested
+    result = {}
+    for b in json.load(open(path))["benchmarks"]:
+        if b.get("run_type") == "aggregate" and b.get("aggregate_name") != "mean":
+            continue
+        name = b.get("run_name", b["name"])
+        result[name] = b["real_time"] if "real_time" in name else b["cpu_time"]
+    return result
+
+regressions = 0
+for engine in engines:
+    old_path = os.path.join(baseline, engine + ".json")
+    if not os.path.exists(old_path):
+        continue
+    old, new = times(old_path), times(os.path.join(out, engine + ".json"))
+    for name, t in new.items():
+        if name in old and t > old[name] * (1 + threshold):
+            regressions += 1
+            print("REGRESSION %s: %.1f -> %.1f ns (+%.0f%%)" % (name, old[name], t, 100 * (t / old[name] - 1)))
+print("%d microbenchmark regression(s) against %s" % (regressions, baseline))
+sys.exit(3 if regressions else 0)
+PY
+fi
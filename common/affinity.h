@@ -0,0 +1,152 @@
+#pragma once
+
+// CPU pinning and NUMA placement helpers shared by the engines and drivers.
+// NUMA support is optional: build with -DUSE_NUMA -lnuma to enable it,
+// otherwise every helper behaves as if the machine had a single node.
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <sched.h>
+#include <pthread.h>
+
+#ifdef USE_NUMA
+#include <numa.h>
+#endif
+
+inline bool numaEnabled() {
+#ifdef USE_NUMA
+    static const bool enabled = numa_available() >= 0 && numa_max_node() > 0;
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+inline int numaNodeCount() {
+#ifdef USE_NUMA
+    if (numaEnabled()) {
+        return numa_max_node() + 1;
+    }
+#endif
+    return 1;
+}
+
+inline int nodeOfCpu(int cpu) {
+#ifdef USE_NUMA
+    if (numaEnabled()) {
+        int node = numa_node_of_cpu(cpu);
+        return node < 0 ? 0 : node;
+    }
+#endif
+    (void)cpu;
+    return 0;
+}
+
+// Node of the CPU the calling thread is running on right now
+inline int currentNode() {
+    int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : nodeOfCpu(cpu);
+}
+
+// CPUs this process may run on, grouped node by node so that consecutive
+// workers fill one socket before spilling onto the next
+inline std::vector<int> compactCpuOrder() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::vector<int> cpus;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::stable_sort(cpus.begin(), cpus.end(), [](int a, int b) {
+        return nodeOfCpu(a) < nodeOfCpu(b);
+    });
+    return cpus;
+}
+
+inline bool pinCurrentThread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Placement hint: keys 0..m-1 are split into contiguous ranges, one per node
+inline int keyHomeNode(int index, int m, int nodes) {
+    return (int)((long long)index * nodes / m);
+}
+
+inline void* allocOnNode(size_t bytes, int node) {
+#ifdef USE_NUMA
+    if (numaEnabled()) {
+        return numa_alloc_onnode(bytes, node);
+    }
+#endif
+    (void)node;
+    return std::malloc(bytes);
+}
+
+inline void freeOnNode(void* p, size_t bytes) {
+#ifdef USE_NUMA
+    if (numaEnabled()) {
+        numa_free(p, bytes);
+        return;
+    }
+#endif
+    (void)bytes;
+    std::free(p);
+}
+
+// Bump allocator over chunks placed on one node. Not thread-safe: callers
+// allocate under their own lock. Memory is returned only on destruction.
+class NodeArena {
+private:
+    int node;
+    size_t chunkBytes;
+    std::vector<std::pair<char*, size_t>> chunks;
+    size_t used = 0;
+
+public:
+    explicit NodeArena(int node, size_t chunkBytes = 1 << 20)
+        : node(node), chunkBytes(chunkBytes) {}
+
+    NodeArena(NodeArena&& other) noexcept
+        : node(other.node), chunkBytes(other.chunkBytes),
+          chunks(std::move(other.chunks)), used(other.used) {
+        other.chunks.clear();
+    }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ~NodeArena() {
+        for (auto& [p, bytes] : chunks) {
+            freeOnNode(p, bytes);
+        }
+    }
+
+    void* allocate(size_t bytes, size_t align) {
+        size_t offset = chunks.empty() ? 0 : alignedOffset(chunks.back().first, used, align);
+        if (chunks.empty() || offset + bytes > chunks.back().second) {
+            size_t size = std::max(chunkBytes, bytes + align);
+            chunks.emplace_back(static_cast<char*>(allocOnNode(size, node)), size);
+            offset = alignedOffset(chunks.back().first, 0, align);
+        }
+        used = offset + bytes;
+        return chunks.back().first + offset;
+    }
+
+private:
+    static size_t alignedOffset(char* base, size_t offset, size_t align) {
+        uintptr_t addr = reinterpret_cast<uintptr_t>(base) + offset;
+        return offset + ((align - addr % align) % align);
+    }
+};
@@ -0,0 +1,255 @@
+#pragma once
+
+// Compact storage for the superseded versions of one key. Once a version
+// is no longer the latest, only its commit stamp and value are ever read
+// again (by snapshots older than its successor), so the full version
+// struct is replaced by a (stamp, value) pair.
+//
+// Pairs arrive oldest first. The newest few wait unpacked in a tail; each
+// full tail of BLOCK pairs is sealed into a bit-packed block:
+//   stamps  first stamp in the header, then the gap to the previous stamp
+//           in stampBits bits per entry
+//   values  value - valueBase (the block minimum) in valueBits bits
+// A lookup binary-searches the block headers, adds up at most BLOCK gaps
+// and reads the value directly; collection drops whole blocks and repacks
+// at most one partly collected block.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "memory.h"
+
+class ColdChain {
+public:
+    static constexpr int BLOCK = 64;
+
+    struct Entry {
+        int stamp;
+        int value;
+    };
+
+private:
+    struct Block {
+        int firstStamp;
+        int lastStamp;
+        int valueBase;
+        uint32_t firstWord;     // Entries start at bit 0 of words[firstWord]
+        uint8_t count;
+        uint8_t stampBits;
+        uint8_t valueBits;
+    };
+
+    std::vector<uint64_t> words;
+    std::vector<Block> blocks;
+    std::vector<Entry> tail;
+    size_t sealed = 0;          // Entries in blocks
+
+    static int bitsFor(uint64_t v) {
+        int bits = 0;
+        while (v) {
+            ++bits;
+            v >>= 1;
+        }
+        return bits;
+    }
+
+    static void putBits(std::vector<uint64_t>& out, uint64_t pos, uint64_t v, int width) {
+        if (width == 0) {
+            return;
+        }
+        size_t word = pos / 64;
+        int shift = pos % 64;
+        out[word] |= v << shift;
+        if (shift + width > 64) {
+            out[word + 1] |= v >> (64 - shift);
+        }
+    }
+
+    uint64_t getBits(uint64_t pos, int width) const {
+        if (width == 0) {
+            return 0;
+        }
+        size_t word = pos / 64;
+        int shift = pos % 64;
+        uint64_t v = words[word] >> shift;
+        if (shift + width > 64) {
+            v |= words[word + 1] << (64 - shift);
+        }
+        return v & ((1ull << width) - 1);
+    }
+
+    // Pack entries[0..n) onto the end of out
+    static Block encode(const Entry* entries, int n, std::vector<uint64_t>& out) {
+        Block b{ entries[0].stamp, entries[n - 1].stamp, entries[0].value, (uint32_t)out.size(), (uint8_t)n, 0, 0 };
+        uint64_t maxGap = 0;
+        for (int i = 0; i < n; ++i) {
+            b.valueBase = std::min(b.valueBase, entries[i].value);
+            if (i > 0) {
+                maxGap = std::max(maxGap, (uint64_t)((int64_t)entries[i].stamp - entries[i - 1].stamp));
+            }
+        }
+        uint64_t maxOffset = 0;
+        for (int i = 0; i < n; ++i) {
+            maxOffset = std::max(maxOffset, (uint64_t)((int64_t)entries[i].value - b.valueBase));
+        }
+        b.stampBits = (uint8_t)bitsFor(maxGap);
+        b.valueBits = (uint8_t)bitsFor(maxOffset);
+        int width = b.stampBits + b.valueBits;
+        out.resize(out.size() + ((uint64_t)n * width + 63) / 64, 0);
+        uint64_t pos = (uint64_t)b.firstWord * 64;
+        for (int i = 0; i < n; ++i, pos += width) {
+            putBits(out, pos, i > 0 ? (uint64_t)((int64_t)entries[i].stamp - entries[i - 1].stamp) : 0, b.stampBits);
+            putBits(out, pos + b.stampBits, (uint64_t)((int64_t)entries[i].value - b.valueBase), b.valueBits);
+        }
+        return b;
+    }
+
+    int valueAt(const Block& b, int i) const {
+        uint64_t pos = (uint64_t)b.firstWord * 64 + (uint64_t)i * (b.stampBits + b.valueBits) + b.stampBits;
+        return (int)((int64_t)b.valueBase + (int64_t)getBits(pos, b.valueBits));
+    }
+
+    // Position in b of the newest entry with stamp <= ts, given that
+    // b.firstStamp <= ts; its stamp is left in stamp
+    int positionAt(const Block& b, int ts, int& stamp) const {
+        int width = b.stampBits + b.valueBits;
+        uint64_t pos = (uint64_t)b.firstWord * 64 + width;
+        stamp = b.firstStamp;
+        int i = 1;
+        for (; i < b.count; ++i, pos += width) {
+            int next = stamp + (int)getBits(pos, b.stampBits);
+            if (next > ts) {
+                break;
+            }
+            stamp = next;
+        }
+        return i - 1;
+    }
+
+    void decode(const Block& b, std::vector<Entry>& out) const {
+        int width = b.stampBits + b.valueBits;
+        uint64_t pos = (uint64_t)b.firstWord * 64;
+        int stamp = b.firstStamp;
+        for (int i = 0; i < b.count; ++i, pos += width) {
+            stamp += (int)getBits(pos, b.stampBits);
+            out.push_back({ stamp, valueAt(b, i) });
+        }
+    }
+
+    // Last block whose first stamp is <= ts, or blocks.end()
+    std::vector<Block>::const_iterator blockAt(int ts) const {
+        auto it = std::upper_bound(blocks.begin(), blocks.end(), ts,
+            [](int t, const Block& b) { return t < b.firstStamp; });
+        return it == blocks.begin() ? blocks.end() : std::prev(it);
+    }
+
+public:
+    size_t size() const {
+        return sealed + tail.size();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Append a version superseded after every version already here
+    void push(int stamp, int value) {
+        tail.push_back({ stamp, value });
+        if (tail.size() == BLOCK) {
+            blocks.push_back(encode(tail.data(), BLOCK, words));
+            sealed += BLOCK;
+            tail.clear();
+        }
+    }
+
+    // Newest entry with stamp <= ts; false if every entry is newer
+    bool find(int ts, Entry& e) const {
+        if (!tail.empty() && tail.front().stamp <= ts) {
+            auto it = std::upper_bound(tail.begin(), tail.end(), ts,
+                [](int t, const Entry& x) { return t < x.stamp; });
+            e = *std::prev(it);
+            return true;
+        }
+        auto b = blockAt(ts);
+        if (b == blocks.end()) {
+            return false;
+        }
+        if (b->lastStamp <= ts) {
+            e = { b->lastStamp, valueAt(*b, b->count - 1) };
+        }
+        else {
+            int i = positionAt(*b, ts, e.stamp);
+            e.value = valueAt(*b, i);
+        }
+        return true;
+    }
+
+    // Number of entries with stamp <= ts
+    size_t countUpTo(int ts) const {
+        if (!tail.empty() && tail.front().stamp <= ts) {
+            return sealed + (std::upper_bound(tail.begin(), tail.end(), ts,
+                [](int t, const Entry& x) { return t < x.stamp; }) - tail.begin());
+        }
+        auto b = blockAt(ts);
+        if (b == blocks.end()) {
+            return 0;
+        }
+        size_t count = 0;
+        for (auto it = blocks.begin(); it != b; ++it) {
+            count += it->count;
+        }
+        int stamp;
+        return count + positionAt(*b, ts, stamp) + 1;
+    }
+
+    // Drop the n oldest entries
+    void dropOldest(size_t n) {
+        n = std::min(n, size());
+        size_t whole = 0, dropped = 0;
+        while (whole < blocks.size() && dropped + blocks[whole].count <= n) {
+            dropped += blocks[whole].count;
+            ++whole;
+        }
+
+        if (whole < blocks.size() && dropped < n) {
+            // Repack the survivors of the partly collected block, then
+            // move the later blocks down behind it
+            std::vector<Entry> rest;
+            decode(blocks[whole], rest);
+            rest.erase(rest.begin(), rest.begin() + (n - dropped));
+            std::vector<uint64_t> packed;
+            std::vector<Block> kept;
+            kept.push_back(encode(rest.data(), (int)rest.size(), packed));
+            for (size_t i = whole + 1; i < blocks.size(); ++i) {
+                Block b = blocks[i];
+                size_t end = i + 1 < blocks.size() ? blocks[i + 1].firstWord : words.size();
+                b.firstWord = (uint32_t)packed.size();
+                packed.insert(packed.end(), words.begin() + blocks[i].firstWord, words.begin() + end);
+                kept.push_back(b);
+            }
+            words.swap(packed);
+            blocks.swap(kept);
+            sealed -= n;
+            dropped = n;
+        }
+        else if (whole > 0) {
+            size_t firstKept = whole < blocks.size() ? blocks[whole].firstWord : words.size();
+            words.erase(words.begin(), words.begin() + firstKept);
+            blocks.erase(blocks.begin(), blocks.begin() + whole);
+            for (auto& b : blocks) {
+                b.firstWord -= (uint32_t)firstKept;
+            }
+            sealed -= dropped;
+        }
+
+        tail.erase(tail.begin(), tail.begin() + (n - dropped));
+        if (words.capacity() > 2 * words.size() + 8) {
+            words.shrink_to_fit();
+            blocks.shrink_to_fit();
+        }
+    }
+
+    long long bytes() const {
+        return containerBytes(words) + containerBytes(blocks) + containerBytes(tail);
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+// Replication stream of an engine: the write set of every committed
+// transaction, appended in commit-timestamp order. Engines append while
+// holding the lock that orders their commits, so once an engine's
+// currentTimestamp() returns T every commit up to T is in the log.
+// Records are kept for the life of the log (like the engines' version
+// chains), so a follower can start from any timestamp.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Microseconds on the host-wide monotonic clock, comparable across processes
+inline long long monotonicMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct CommitRecord {
+    int ts;                               // Commit timestamp
+    long long committedMicros;            // monotonicMicros() at commit
+    std::vector<std::pair<int, int>> writes; // (index, value) installed at ts
+};
+
+class CommitLog {
+    std::mutex logMutex;
+    std::condition_variable appended;
+    std::vector<CommitRecord> records;
+
+public:
+    void append(int ts, std::vector<std::pair<int, int>> writes) {
+        {
+            std::lock_guard<std::mutex> lk(logMutex);
+            records.push_back({ ts, monotonicMicros(), std::move(writes) });
+        }
+        appended.notify_all();
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lk(logMutex);
+        return records.size();
+    }
+
+    // Position of the first record committed after ts
+    size_t positionAfter(int ts) {
+        std::lock_guard<std::mutex> lk(logMutex);
+        return std::upper_bound(records.begin(), records.end(), ts,
+            [](int t, const CommitRecord& r) { return t < r.ts; }) - records.begin();
+    }
+
+    // Copy up to limit records from pos on into out, waiting up to wait for
+    // the first one; returns the position after the last record copied
+    size_t readFrom(size_t pos, std::vector<CommitRecord>& out, std::chrono::milliseconds wait, size_t limit) {
+        out.clear();
+        std::unique_lock<std::mutex> lk(logMutex);
+        appended.wait_for(lk, wait, [&] { return records.size() > pos; });
+        size_t end = std::min(records.size(), pos + limit);
+        if (end > pos) {
+            out.insert(out.end(), records.begin() + pos, records.begin() + end);
+        }
+        return std::max(pos, end);
+    }
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+// C++20 coroutine scheduling for the driver: one Scheduler per OS thread
+// multiplexes many client coroutines. Think time and engine waits suspend
+// the coroutine instead of blocking the thread; sleeping coroutines sit in
+// a hashed timer wheel until their tick comes up.
+
+#include <coroutine>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+// Fire-and-forget coroutine owned by a Scheduler. It starts suspended and
+// the scheduler destroys its frame once it runs to completion.
+struct ClientTask {
+    struct promise_type {
+        ClientTask get_return_object() {
+            return ClientTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Hashed timer wheel with 1 ms ticks. A timer further out than one turn of
+// the wheel waits in its slot for the remaining number of rounds.
+class TimerWheel {
+private:
+    struct Timer {
+        std::coroutine_handle<> handle;
+        long long rounds;
+    };
+
+    std::vector<std::vector<Timer>> slots;
+    long long currentTick = 0;
+    size_t pending = 0;
+
+public:
+    explicit TimerWheel(size_t slotCount = 1024) : slots(slotCount) {}
+
+    void add(std::coroutine_handle<> h, long long delayTicks) {
+        long long expiry = currentTick + std::max(1LL, delayTicks);
+        long long n = (long long)slots.size();
+        slots[expiry % n].push_back({ h, (expiry - currentTick - 1) / n });
+        ++pending;
+    }
+
+    // Advance to tick `now`, handing every expired coroutine to `ready`
+    template <class Ready>
+    void advance(long long now, Ready&& ready) {
+        while (currentTick < now && pending > 0) {
+            ++currentTick;
+            auto& slot = slots[currentTick % slots.size()];
+            for (size_t i = 0; i < slot.size();) {
+                if (slot[i].rounds == 0) {
+                    ready(slot[i].handle);
+                    slot[i] = slot.back();
+                    slot.pop_back();
+                    --pending;
+                }
+                else {
+                    --slot[i].rounds;
+                    ++i;
+                }
+            }
+        }
+        currentTick = std::max(currentTick, now);
+    }
+
+    bool empty() const {
+        return pending == 0;
+    }
+};
+
+class Scheduler {
+private:
+    std::deque<std::coroutine_handle<>> ready;
+    size_t live = 0;
+    TimerWheel wheel;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    long long nowTick() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+    }
+
+public:
+    static Scheduler*& current() {
+        static thread_local Scheduler* scheduler = nullptr;
+        return scheduler;
+    }
+
+    void spawn(ClientTask task) {
+        ++live;
+        ready.push_back(task.handle);
+    }
+
+    void makeReady(std::coroutine_handle<> h) {
+        ready.push_back(h);
+    }
+
+    void sleep(std::coroutine_handle<> h, long long ms) {
+        wheel.add(h, ms);
+    }
+
+    // Run until every spawned coroutine has finished. Client coroutines do
+    // not nest, so every resumed handle is a task frame we own.
+    void run() {
+        current() = this;
+        while (live > 0) {
+            // One pass over what is ready now: coroutines that yield go to
+            // the back and wait for the next pass, after the timers fire
+            for (size_t n = ready.size(); n > 0; --n) {
+                auto h = ready.front();
+                ready.pop_front();
+                h.resume();
+                if (h.done()) {
+                    h.destroy();
+                    --live;
+                }
+            }
+
+            wheel.advance(nowTick(), [this](std::coroutine_handle<> h) { ready.push_back(h); });
+            if (ready.empty() && live > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+        current() = nullptr;
+    }
+};
+
+// co_await thinkTime(ms): suspend for ms milliseconds of think time
+struct ThinkTime {
+    long long ms;
+    bool await_ready() const noexcept { return ms <= 0; }
+    void await_suspend(std::coroutine_handle<> h) const { Scheduler::current()->sleep(h, ms); }
+    void await_resume() const noexcept {}
+};
+
+inline ThinkTime thinkTime(long long ms) {
+    return ThinkTime{ ms };
+}
+
+// co_await yieldNow(): let the other coroutines on this thread run first
+struct YieldNow {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const { Scheduler::current()->makeReady(h); }
+    void await_resume() const noexcept {}
+};
+
+inline YieldNow yieldNow() {
+    return YieldNow{};
+}
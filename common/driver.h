@@ -0,0 +1,998 @@
+#pragma once
+
+// Benchmark workload shared by every engine directory. Each engine's
+// SI-run.cc includes its header and calls runDriver<Manager>(argc, argv, name).
+
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <cmath>
+#include "affinity.h"
+#include "perf.h"
+#include "sweep.h"
+#include "traits.h"
+#include "memory.h"
+#include "trace.h"
+#include "metrics.h"
+
+// Coroutine mode (--clients-per-thread) needs a C++20 build
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+#include "coro.h"
+#define DRIVER_HAS_COROUTINES 1
+#endif
+
+inline std::mutex logMutex;
+inline std::ofstream logFile;
+
+inline std::atomic<long long> totalCommitTime{ 0 };
+inline std::atomic<long long> totalCommitted{ 0 };
+inline std::atomic<long long> totalAborts{ 0 };
+
+inline double readRatio = 0.7; // Default value; will overwrite from input if available
+inline int keyRanges = 1;      // Each transaction draws its keys from one of this many ranges
+inline bool deltaWrites = false; // Write transactions increment blindly with add()
+inline double keySkew = 0.0;     // Zipf exponent of key choice inside a range, 0 = uniform
+
+// First key of range r when 0..m-1 is split into contiguous ranges
+// (the same split PartitionedManager uses for its partitions)
+inline int keyRangeStart(int r, int m, int ranges) {
+    return (int)(((long long)r * m + ranges - 1) / ranges);
+}
+
+// Zipf-distributed ranks 0..n-1 for 0 < theta < 1, rank 0 the hottest
+// (Gray et al., "Quickly Generating Billion-Record Synthetic Databases",
+// the generator YCSB uses). Construction is O(n), drawing is O(1).
+class ZipfGenerator {
+private:
+    int n;
+    double theta, alpha, zetan, eta, half;
+
+public:
+    ZipfGenerator(int n, double theta) : n(std::max(1, n)), theta(theta) {
+        zetan = 0.0;
+        for (int i = 1; i <= this->n; ++i) {
+            zetan += 1.0 / std::pow((double)i, theta);
+        }
+        double zeta2 = 1.0 + std::pow(0.5, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - std::pow(2.0 / this->n, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+        half = std::pow(0.5, theta);
+    }
+
+    template <class Rng>
+    int operator()(Rng& rng) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        double uz = u * zetan;
+        if (uz < 1.0 || n == 1) {
+            return 0;
+        }
+        if (uz < 1.0 + half) {
+            return 1;
+        }
+        return std::min(n - 1, (int)(n * std::pow(eta * u - eta + 1.0, alpha)));
+    }
+};
+
+// One generator per key range, built before the workers start when keySkew > 0
+inline std::vector<ZipfGenerator> rangeZipf;
+
+inline void prepareKeyChoice(int m) {
+    rangeZipf.clear();
+    if (keySkew > 0.0) {
+        for (int r = 0; r < keyRanges; ++r) {
+            rangeZipf.emplace_back(keyRangeStart(r + 1, m, keyRanges) - keyRangeStart(r, m, keyRanges), keySkew);
+        }
+    }
+}
+
+// Key of the next operation of a transaction confined to range r
+template <class Rng>
+int drawKey(Rng& rng, int range, int m) {
+    int first = keyRangeStart(range, m, keyRanges);
+    if (keySkew > 0.0) {
+        return first + rangeZipf[range](rng);
+    }
+    return std::uniform_int_distribution<int>(first, keyRangeStart(range + 1, m, keyRanges) - 1)(rng);
+}
+
+// runDriver only sets deltaWrites for engines with add()
+template <class Manager>
+void addDelta(Manager* manager, int txID, int index, int delta) {
+    if constexpr (HasAdd<Manager>::value) {
+        PERF_START(writeSample);
+        manager->add(txID, index, delta);
+        PERF_STOP(writeSample, PERF_WRITE_OP);
+    }
+}
+
+// Passes the read-only hint to engines that plan for it at begin
+template <class Manager>
+int beginTx(Manager* manager, bool readOnly) {
+    if constexpr (HasReadOnlyBegin<Manager>::value) {
+        return manager->beginTrans(readOnly);
+    }
+    else {
+        return manager->beginTrans();
+    }
+}
+
+// ---------------- worker thread ---------------- //
+// Committed transactions are appended to record when it is given
+template <class Manager>
+void workerThread(int threadID, int cpu, Manager* manager, int m, int numTrans, int numIters, int constVal, double lambda,
+    TraceStream* record = nullptr) {
+    if (cpu >= 0) {
+        pinCurrentThread(cpu);
+    }
+    TraceRecorder trace(record);
+
+    static thread_local std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> distRange(0, keyRanges - 1);
+    std::uniform_int_distribution<int> distVal(0, constVal);
+    std::exponential_distribution<double> distExp(1.0 / lambda);
+    std::uniform_real_distribution<double> distProb(0.0, 1.0);
+
+    for (int t = 0; t < numTrans; ++t) {
+        int aborts = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        while (true) {
+            bool readOnly = (distProb(rng) < readRatio);
+            PERF_START(beginSample);
+            int txID = beginTx(manager, readOnly);
+            PERF_STOP(beginSample, PERF_BEGIN_OP);
+            liveCounters.add(LIVE_BEGINS);
+            trace.begin(readOnly);
+            int range = distRange(rng);
+
+            std::stringstream buffer;
+
+            for (int i = 0; i < numIters; ++i) {
+                int randInd = drawKey(rng, range, m);
+                if (!readOnly && deltaWrites) {
+                    int randVal = distVal(rng);
+                    addDelta(manager, txID, randInd, randVal);
+                    trace.op(TRACE_ADD, randInd, randVal);
+
+                    buffer << "Thread " << threadID << " Tx " << txID
+                        << " adds idx " << randInd << " delta " << randVal
+                        << " at time " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count() << "\n";
+                }
+                else {
+                    PERF_START(readSample);
+                    int localVal = manager->read(txID, randInd);
+                    PERF_STOP(readSample, PERF_READ_OP);
+
+                    buffer << "Thread " << threadID << " Tx " << txID
+                        << " reads idx " << randInd << " val " << localVal
+                        << " at time " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count() << "\n";
+
+                    if (readOnly) {
+                        trace.op(TRACE_READ, randInd);
+                    }
+                    else {
+                        int randVal = distVal(rng);
+                        trace.op(TRACE_RMW, randInd, randVal);
+                        localVal += randVal;
+                        PERF_START(writeSample);
+                        manager->write(txID, randInd, localVal);
+                        PERF_STOP(writeSample, PERF_WRITE_OP);
+
+                        buffer << "Thread " << threadID << " Tx " << txID
+                            << " writes idx " << randInd << " val " << localVal
+                            << " at time " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch()).count() << "\n";
+                    }
+                }
+
+                // Doomed transaction: skip the remaining operations and think time
+                if constexpr (HasIsAborted<Manager>::value) {
+                    if (manager->isAborted(txID)) {
+                        break;
+                    }
+                }
+
+                int thinkMs = (int)distExp(rng);
+                trace.think(thinkMs * 1000);
+                std::this_thread::sleep_for(std::chrono::milliseconds(thinkMs));
+            }
+
+            PERF_START(commitSample);
+            bool ok = manager->commit(txID);
+            PERF_STOP(commitSample, ok ? PERF_COMMIT_OP : PERF_ABORT_OP);
+            liveCounters.add(ok ? LIVE_COMMITS : LIVE_ABORTS);
+            trace.commit(ok);
+            buffer << "Tx " << txID << " tryCommits => " << (ok ? "COMMIT" : "ABORT") << " at time "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count() << "\n";
+
+            if (ok) {
+                auto end = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard<std::mutex> lk(logMutex);
+                    logFile << buffer.str();
+                }
+                long long commitDelay = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+                totalCommitTime.fetch_add(commitDelay);
+                totalCommitted.fetch_add(1);
+                totalAborts.fetch_add(aborts);
+                break;
+            }
+            else {
+                ++aborts;
+            }
+        }
+    }
+}
+
+// ---------------- trace replay thread ---------------- //
+// Runs streams threadID-1, threadID-1+threads, ... of the trace one after
+// the other, retrying each transaction as recorded until it commits. Paced
+// replay sleeps the recorded think times, otherwise operations go back to
+// back. Increments fall back to read-then-write on engines without add().
+template <class Manager>
+void replayWorkerThread(int threadID, int threads, int cpu, Manager* manager, const Trace* trace, bool paced) {
+    if (cpu >= 0) {
+        pinCurrentThread(cpu);
+    }
+
+    bool readOnly;
+    std::vector<TraceEntry> ops;
+    for (size_t s = threadID - 1; s < trace->streams.size(); s += threads) {
+        TraceCursor cursor(trace->streams[s]);
+        while (cursor.nextTransaction(readOnly, ops)) {
+            int aborts = 0;
+            auto start = std::chrono::steady_clock::now();
+
+            while (true) {
+                PERF_START(beginSample);
+                int txID = beginTx(manager, readOnly);
+                PERF_STOP(beginSample, PERF_BEGIN_OP);
+                liveCounters.add(LIVE_BEGINS);
+
+                std::stringstream buffer;
+
+                for (const TraceEntry& e : ops) {
+                    if (e.op == TRACE_ADD && HasAdd<Manager>::value) {
+                        addDelta(manager, txID, e.key, e.value);
+                        buffer << "Thread " << threadID << " Tx " << txID
+                            << " adds idx " << e.key << " delta " << e.value << "\n";
+                    }
+                    else if (e.op == TRACE_WRITE) {
+                        PERF_START(writeSample);
+                        manager->write(txID, e.key, e.value);
+                        PERF_STOP(writeSample, PERF_WRITE_OP);
+                        buffer << "Thread " << threadID << " Tx " << txID
+                            << " writes idx " << e.key << " val " << e.value << "\n";
+                    }
+                    else {
+                        PERF_START(readSample);
+                        int localVal = manager->read(txID, e.key);
+                        PERF_STOP(readSample, PERF_READ_OP);
+                        buffer << "Thread " << threadID << " Tx " << txID
+                            << " reads idx " << e.key << " val " << localVal << "\n";
+
+                        if (e.op != TRACE_READ) {
+                            localVal += e.value;
+                            PERF_START(writeSample);
+                            manager->write(txID, e.key, localVal);
+                            PERF_STOP(writeSample, PERF_WRITE_OP);
+                            buffer << "Thread " << threadID << " Tx " << txID
+                                << " writes idx " << e.key << " val " << localVal << "\n";
+                        }
+                    }
+
+                    if constexpr (HasIsAborted<Manager>::value) {
+                        if (manager->isAborted(txID)) {
+                            break;
+                        }
+                    }
+
+                    if (paced && e.thinkMicros > 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(e.thinkMicros));
+                    }
+                }
+
+                PERF_START(commitSample);
+                bool ok = manager->commit(txID);
+                PERF_STOP(commitSample, ok ? PERF_COMMIT_OP : PERF_ABORT_OP);
+                liveCounters.add(ok ? LIVE_COMMITS : LIVE_ABORTS);
+                buffer << "Tx " << txID << " tryCommits => " << (ok ? "COMMIT" : "ABORT") << "\n";
+
+                if (ok) {
+                    auto end = std::chrono::steady_clock::now();
+                    {
+                        std::lock_guard<std::mutex> lk(logMutex);
+                        logFile << buffer.str();
+                    }
+                    long long commitDelay = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+                    totalCommitTime.fetch_add(commitDelay);
+                    totalCommitted.fetch_add(1);
+                    totalAborts.fetch_add(aborts);
+                    break;
+                }
+                else {
+                    ++aborts;
+                }
+            }
+        }
+    }
+}
+
+// ---------------- one-shot worker thread ---------------- //
+// Same keys, values and think time as workerThread, but drawn up front: the
+// think time is spent composing the request, and the transaction is then
+// handed to the engine in one piece. Nothing is ever retried.
+struct OneShotRequest {
+    std::vector<int> keys;
+    std::vector<int> deltas;    // One per key; empty for a read-only transaction
+};
+
+template <class Rng>
+OneShotRequest drawOneShot(Rng& rng, int m, int numIters, int constVal) {
+    std::uniform_int_distribution<int> distRange(0, keyRanges - 1);
+    std::uniform_int_distribution<int> distVal(0, constVal);
+    std::uniform_real_distribution<double> distProb(0.0, 1.0);
+
+    OneShotRequest req;
+    bool readOnly = (distProb(rng) < readRatio);
+    int range = distRange(rng);
+    for (int i = 0; i < numIters; ++i) {
+        req.keys.push_back(drawKey(rng, range, m));
+        if (!readOnly) {
+            req.deltas.push_back(distVal(rng));
+        }
+    }
+    return req;
+}
+
+// The read-then-write loop of workerThread as a procedure; it runs on an
+// engine thread and logs into the caller's buffer
+template <class Manager>
+typename Manager::Procedure oneShotProcedure(const char* who, int id, const OneShotRequest& req, std::stringstream& buffer) {
+    return [who, id, &req, &buffer](auto& ctx) {
+        for (size_t i = 0; i < req.keys.size(); ++i) {
+            int localVal = ctx.read(req.keys[i]);
+            buffer << who << " " << id << " Tx " << ctx.txID()
+                << " reads idx " << req.keys[i] << " val " << localVal
+                << " at time " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count() << "\n";
+
+            if (!req.deltas.empty()) {
+                localVal += req.deltas[i];
+                ctx.write(req.keys[i], localVal);
+                buffer << who << " " << id << " Tx " << ctx.txID()
+                    << " writes idx " << req.keys[i] << " val " << localVal
+                    << " at time " << std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count() << "\n";
+            }
+        }
+    };
+}
+
+inline void recordOneShotCommit(int txID, std::stringstream& buffer, std::chrono::steady_clock::time_point start) {
+    auto end = std::chrono::steady_clock::now();
+    buffer << "Tx " << txID << " tryCommits => COMMIT at time "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(end.time_since_epoch()).count() << "\n";
+    {
+        std::lock_guard<std::mutex> lk(logMutex);
+        logFile << buffer.str();
+    }
+    totalCommitTime.fetch_add(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    totalCommitted.fetch_add(1);
+    liveCounters.add(LIVE_COMMITS);
+}
+
+template <class Manager>
+void oneShotWorkerThread(int threadID, int cpu, Manager* manager, int m, int numTrans, int numIters, int constVal, double lambda) {
+    if (cpu >= 0) {
+        pinCurrentThread(cpu);
+    }
+
+    static thread_local std::mt19937 rng(std::random_device{}());
+    std::exponential_distribution<double> distExp(1.0 / lambda);
+
+    for (int t = 0; t < numTrans; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        OneShotRequest req = drawOneShot(rng, m, numIters, constVal);
+        for (int i = 0; i < numIters; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds((int)distExp(rng)));
+        }
+
+        std::stringstream buffer;
+        liveCounters.add(LIVE_BEGINS);
+        PERF_START(commitSample);
+        auto writes = req.deltas.empty() ? std::vector<int>{} : req.keys;
+        int txID = manager->execute(req.keys, writes, oneShotProcedure<Manager>("Thread", threadID, req, buffer));
+        PERF_STOP(commitSample, PERF_COMMIT_OP);
+        recordOneShotCommit(txID, buffer, start);
+    }
+}
+
+#ifdef DRIVER_HAS_COROUTINES
+// ---------------- coroutine client ---------------- //
+// Same transaction mix as workerThread, but think time and waits for a free
+// transaction context suspend the coroutine instead of the OS thread.
+template <class Manager>
+ClientTask clientCoroutine(int clientID, Manager* manager, int m, int numTrans, int numIters, int constVal, double lambda) {
+    static thread_local std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> distRange(0, keyRanges - 1);
+    std::uniform_int_distribution<int> distVal(0, constVal);
+    std::exponential_distribution<double> distExp(1.0 / lambda);
+    std::uniform_real_distribution<double> distProb(0.0, 1.0);
+
+    for (int t = 0; t < numTrans; ++t) {
+        int aborts = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        while (true) {
+            bool readOnly = (distProb(rng) < readRatio);
+            int txID;
+            if constexpr (HasTryBegin<Manager>::value && HasReadOnlyBegin<Manager>::value) {
+                while ((txID = manager->tryBeginTrans(readOnly)) < 0) {
+                    co_await yieldNow();
+                }
+            }
+            else if constexpr (HasTryBegin<Manager>::value) {
+                while ((txID = manager->tryBeginTrans()) < 0) {
+                    co_await yieldNow();
+                }
+            }
+            else {
+                txID = beginTx(manager, readOnly);
+            }
+            liveCounters.add(LIVE_BEGINS);
+            int range = distRange(rng);
+
+            std::stringstream buffer;
+
+            for (int i = 0; i < numIters; ++i) {
+                int randInd = drawKey(rng, range, m);
+                if (!readOnly && deltaWrites) {
+                    int randVal = distVal(rng);
+                    addDelta(manager, txID, randInd, randVal);
+                    buffer << "Client " << clientID << " Tx " << txID
+                        << " adds idx " << randInd << " delta " << randVal << "\n";
+                }
+                else {
+                    int localVal = manager->read(txID, randInd);
+                    buffer << "Client " << clientID << " Tx " << txID
+                        << " reads idx " << randInd << " val " << localVal << "\n";
+
+                    if (!readOnly) {
+                        localVal += distVal(rng);
+                        manager->write(txID, randInd, localVal);
+                        buffer << "Client " << clientID << " Tx " << txID
+                            << " writes idx " << randInd << " val " << localVal << "\n";
+                    }
+                }
+
+                if constexpr (HasIsAborted<Manager>::value) {
+                    if (manager->isAborted(txID)) {
+                        break;
+                    }
+                }
+
+                co_await thinkTime((long long)distExp(rng));
+            }
+
+            bool ok = manager->commit(txID);
+            liveCounters.add(ok ? LIVE_COMMITS : LIVE_ABORTS);
+            buffer << "Tx " << txID << " tryCommits => " << (ok ? "COMMIT" : "ABORT") << "\n";
+
+            if (ok) {
+                auto end = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard<std::mutex> lk(logMutex);
+                    logFile << buffer.str();
+                }
+                totalCommitTime.fetch_add(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+                totalCommitted.fetch_add(1);
+                totalAborts.fetch_add(aborts);
+                break;
+            }
+            ++aborts;
+        }
+    }
+}
+
+// One-shot client: think, submit, and stay suspended until the engine has run it
+template <class Manager>
+ClientTask oneShotClientCoroutine(int clientID, Manager* manager, int m, int numTrans, int numIters, int constVal, double lambda) {
+    static thread_local std::mt19937 rng(std::random_device{}());
+    std::exponential_distribution<double> distExp(1.0 / lambda);
+
+    for (int t = 0; t < numTrans; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        OneShotRequest req = drawOneShot(rng, m, numIters, constVal);
+        for (int i = 0; i < numIters; ++i) {
+            co_await thinkTime((long long)distExp(rng));
+        }
+
+        std::stringstream buffer;
+        auto writes = req.deltas.empty() ? std::vector<int>{} : req.keys;
+        liveCounters.add(LIVE_BEGINS);
+        auto ticket = manager->submit(req.keys, writes, oneShotProcedure<Manager>("Client", clientID, req, buffer));
+        while (!manager->finished(ticket)) {
+            co_await yieldNow();
+        }
+        recordOneShotCommit(ticket->txID, buffer, start);
+    }
+}
+
+// One OS thread running clientsPerThread client coroutines to completion
+template <class Manager>
+void coroutineWorkerThread(int threadID, int cpu, int clientsPerThread, Manager* manager, int m, int numTrans, int numIters, int constVal, double lambda) {
+    if (cpu >= 0) {
+        pinCurrentThread(cpu);
+    }
+    Scheduler scheduler;
+    for (int c = 0; c < clientsPerThread; ++c) {
+        int clientID = (threadID - 1) * clientsPerThread + c + 1;
+        if constexpr (IsOneShot<Manager>::value) {
+            scheduler.spawn(oneShotClientCoroutine(clientID, manager, m, numTrans, numIters, constVal, lambda));
+        }
+        else {
+            scheduler.spawn(clientCoroutine(clientID, manager, m, numTrans, numIters, constVal, lambda));
+        }
+    }
+    scheduler.run();
+}
+#endif
+
+// ---------------- one benchmark run ---------------- //
+// Rejects parameter combinations the engine or the build cannot run
+template <class Manager>
+bool checkParams(const DriverParams& p) {
+    if (p.deltaWrites && !HasAdd<Manager>::value) {
+        std::cerr << "Error: --delta-writes needs an engine with add()\n";
+        return false;
+    }
+#ifndef DRIVER_HAS_COROUTINES
+    if (p.clientsPerThread > 0) {
+        std::cerr << "Error: --clients-per-thread needs a build with -std=c++20\n";
+        return false;
+    }
+#endif
+    if (p.memoryBudgetMB > 0 && !HasMemoryStats<Manager>::value) {
+        std::cerr << "Error: --memory-budget needs an engine with memory accounting\n";
+        return false;
+    }
+    if (p.clientsPerThread > 0 && BlocksOnConflict<Manager>::value) {
+        std::cerr << "Error: --clients-per-thread cannot multiplex clients over an engine with lock waits\n";
+        return false;
+    }
+    if (p.skew < 0.0 || p.skew >= 1.0) {
+        std::cerr << "Error: skew must be in [0, 1)\n";
+        return false;
+    }
+    if (p.n < 1 || p.m < 1) {
+        std::cerr << "Error: need at least one thread and one data item\n";
+        return false;
+    }
+    return true;
+}
+
+// Engine counters and gauges for a live metrics sample
+template <class Manager>
+void probeEngine(Manager& manager, LiveSample& s) {
+    if constexpr (HasSerializationAborts<Manager>::value) {
+        s.serializationAborts = manager.serializationAborts();
+    }
+    if constexpr (HasDeadlockAborts<Manager>::value) {
+        s.deadlockAborts = manager.deadlockAborts();
+    }
+    if constexpr (HasMemoryStats<Manager>::value) {
+        MemoryStats mem = manager.memoryStats();
+        s.budgetAborts = mem.budgetAborts;
+        s.memoryMB = mem.total / (1024.0 * 1024.0);
+    }
+    if constexpr (HasVersionStats<Manager>::value) {
+        VersionStats v = manager.versionStats();
+        s.versions = v.versions;
+        s.longestChain = v.longestChain;
+        s.gcBacklog = v.gcBacklog;
+    }
+}
+
+// A fresh engine for p. Pooled engines get a context for every client, so
+// coroutine clients are not capped by the default pool size.
+template <class Manager>
+Manager makeEngine(const DriverParams& p) {
+    if constexpr (HasContextPool<Manager>::value) {
+        if (p.clientsPerThread > 0) {
+            return Manager::withContextPool(p.m, p.n * p.clientsPerThread);
+        }
+    }
+    return Manager(p.m);
+}
+
+// Runs the workload once on a fresh engine. Committed transactions go to
+// logFile when it is open. With replay, the trace's transactions replace
+// the generated ones; with record, the generated ones are also traced.
+// With live metrics, a sampler reports on the run while it is in progress.
+template <class Manager>
+RunMetrics runPoint(const DriverParams& p, const Trace* replay = nullptr, bool paced = false, Trace* record = nullptr,
+    const LiveMetricsOptions& live = {}) {
+    readRatio = p.readRatio;
+    keyRanges = std::max(1, std::min(p.keyRanges, p.m));
+    deltaWrites = p.deltaWrites;
+    keySkew = p.skew;
+    totalCommitTime = 0;
+    totalCommitted = 0;
+    totalAborts = 0;
+    prepareKeyChoice(p.m);
+
+    std::vector<int> cpus;
+    if (p.pin) {
+        cpus = compactCpuOrder();
+    }
+
+    // Add program start time measurement
+    auto programStartTime = std::chrono::steady_clock::now();
+
+    Manager manager = makeEngine<Manager>(p);
+    if constexpr (HasMemoryStats<Manager>::value) {
+        if (p.memoryBudgetMB > 0) {
+            MemoryBudget budget;
+            budget.limitBytes = (long long)(p.memoryBudgetMB * 1024 * 1024);
+            manager.setMemoryBudget(budget);
+        }
+    }
+    if (record) {
+        record->m = p.m;
+        record->streams.assign(p.n, {});
+    }
+    LiveMetricsSampler sampler(live, [&manager](LiveSample& s) { probeEngine(manager, s); });
+    if (live.enabled()) {
+        std::string error;
+        if (!sampler.start(error)) {
+            std::cerr << "Warning: no live metrics, " << error << "\n";
+        }
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(p.n);
+
+    for (int i = 0; i < p.n; ++i) {
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+#ifdef DRIVER_HAS_COROUTINES
+        if (p.clientsPerThread > 0) {
+            threads.emplace_back(coroutineWorkerThread<Manager>, i + 1, cpu, p.clientsPerThread, &manager, p.m, p.numTrans, p.numIters, p.constVal, p.lambda);
+            continue;
+        }
+#endif
+        if constexpr (IsOneShot<Manager>::value) {
+            threads.emplace_back(oneShotWorkerThread<Manager>, i + 1, cpu, &manager, p.m, p.numTrans, p.numIters, p.constVal, p.lambda);
+        }
+        else if (replay) {
+            threads.emplace_back(replayWorkerThread<Manager>, i + 1, p.n, cpu, &manager, replay, paced);
+        }
+        else {
+            TraceStream* stream = record ? &record->streams[i] : nullptr;
+            threads.emplace_back(workerThread<Manager>, i + 1, cpu, &manager, p.m, p.numTrans, p.numIters, p.constVal, p.lambda, stream);
+        }
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    sampler.stop();
+
+    // Add program end time measurement
+    auto programEndTime = std::chrono::steady_clock::now();
+
+    RunMetrics r;
+    r.seconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+        programEndTime - programStartTime).count() / 1000.0;
+    r.concurrency = p.n * std::max(1, p.clientsPerThread);
+    if constexpr (HasContextPool<Manager>::value) {
+        r.concurrency = std::min(r.concurrency, manager.contextPoolSize());
+    }
+
+    long long committedCount = totalCommitted.load();
+    long long abortedCount = totalAborts.load();
+    if (committedCount > 0) {
+        r.avgDelay = (double)totalCommitTime.load() / committedCount;
+        r.avgAborts = (double)abortedCount / committedCount;
+        r.commitsPerSecond = committedCount / r.seconds;
+        r.abortsPerSecond = abortedCount / r.seconds;
+        if constexpr (HasSerializationAborts<Manager>::value) {
+            r.serialAbortsPerSecond = manager.serializationAborts() / r.seconds;
+        }
+    }
+    if constexpr (HasMemoryStats<Manager>::value) {
+        MemoryStats mem = manager.memoryStats();
+        r.peakMemoryMB = mem.peak / (1024.0 * 1024.0);
+        r.budgetAbortsPerSecond = r.seconds > 0 ? mem.budgetAborts / r.seconds : 0.0;
+        if (logFile.is_open()) {
+            logFile << "Memory by component (bytes):";
+            for (int c = 0; c < MEM_COMPONENTS; ++c) {
+                logFile << " " << memoryComponentName(c) << "=" << mem.bytes[c];
+            }
+            logFile << "\nGC runs: " << mem.gcRuns << ", versions reclaimed: " << mem.versionsReclaimed
+                << ", throttled begins: " << mem.throttledBegins << "\n";
+        }
+    }
+    return r;
+}
+
+// ---------------- parameter sweep ---------------- //
+// Every point of the specification, trials times each, in one process;
+// results go to <outPrefix>.csv and <outPrefix>.json. Returns 3 if a
+// baseline was given and some point's throughput regressed.
+template <class Manager>
+int runSweep(const DriverParams& base, const std::string& specPath, const std::string& outPrefix,
+    const std::string& baselinePath, double tolerance) {
+    std::ifstream specFile(specPath);
+    if (!specFile.is_open()) {
+        std::cerr << "Error: Could not open " << specPath << "\n";
+        return 1;
+    }
+    SweepSpec spec;
+    if (!parseSweepSpec(specFile, spec)) {
+        return 1;
+    }
+
+    std::vector<SweepPoint> points;
+    for (const auto& p : expandSweep(spec, base)) {
+        if (p.engine != base.engine) {
+            continue;   // Another engine's binary runs these
+        }
+        if (!checkParams<Manager>(p)) {
+            return 1;
+        }
+        points.push_back({ p, {} });
+    }
+    if (points.empty()) {
+        std::cerr << "No sweep points for engine " << base.engine << "\n";
+        return 1;
+    }
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (int t = 0; t < spec.trials; ++t) {
+            RunMetrics r = runPoint<Manager>(points[i].params);
+            points[i].trials.push_back(r);
+            std::cout << "[" << i + 1 << "/" << points.size() << "] " << sweepKey(points[i].params)
+                << " trial " << t + 1 << ": " << r.commitsPerSecond << " commits/s, "
+                << r.abortsPerSecond << " aborts/s\n";
+        }
+    }
+
+    std::ofstream csv(outPrefix + ".csv");
+    std::ofstream json(outPrefix + ".json");
+    if (!csv.is_open() || !json.is_open()) {
+        std::cerr << "Error: Could not write " << outPrefix << ".csv/.json\n";
+        return 1;
+    }
+    writeSweepCsv(csv, points);
+    writeSweepJson(json, points);
+    std::cout << "Sweep results written to " << outPrefix << ".csv and " << outPrefix << ".json\n";
+
+    if (!baselinePath.empty()) {
+        int regressions = compareWithBaseline(baselinePath, points, tolerance);
+        if (regressions < 0) {
+            return 1;
+        }
+        std::cout << regressions << " throughput regression(s) against " << baselinePath << "\n";
+        if (regressions > 0) {
+            return 3;
+        }
+    }
+    return 0;
+}
+
+// ---------------- driver entry point ---------------- //
+// Usage: ./a.out [--pin] [--key-ranges=N] [--clients-per-thread=K] [--delta-writes] [--skew=S] [--memory-budget=MB]
+//                [--record=FILE | --replay=FILE [--paced]] [--metrics=FILE] [--metrics-page=FILE] [--metrics-interval=MS]
+//                [--sweep=FILE [--sweep-out=PREFIX] [--baseline=CSV] [--regression-threshold=F]]
+//   --pin                   pin worker i to the i-th CPU, filling one NUMA node before the next
+//   --key-ranges=N          keep every transaction inside one of N contiguous key ranges
+//                           (a partitionable workload when N matches the partition count)
+//   --clients-per-thread=K  run K client coroutines on each of the n threads (C++20 build),
+//                           each executing numTrans transactions
+//   --delta-writes          write transactions add their random value with add() instead of
+//                           read-then-write, so they never conflict with each other
+//   --skew=S                Zipf-distributed keys with exponent S in [0, 1) (0 = uniform)
+//   --record=FILE           also write the committed transactions to a binary trace (trace.h)
+//   --replay=FILE           run a recorded trace instead of generated transactions; n threads
+//                           share its streams, m must cover its keys
+//   --paced                 replay with the recorded think times instead of at full speed
+//   --metrics=FILE          while the run is in progress, append a CSV row of live metrics
+//                           (throughput, aborts by cause, in-flight transactions, chain lengths,
+//                           GC backlog, lock waits; see metrics.h) every interval
+//   --metrics-page=FILE     publish the latest row in a memory-mapped page for Metrics/metrics-watch
+//   --metrics-interval=MS   sampling interval (default 100)
+//   --memory-budget=MB      bound the engine's versions and transaction state to MB megabytes,
+//                           collecting old versions, aborting the oldest snapshot and holding
+//                           back new transactions as needed (engines with memoryStats())
+//   --sweep=FILE            run every point of a sweep specification (see sweep.h) instead of
+//                           the single run described by inp-params.txt
+//   --sweep-out=PREFIX      sweep results file prefix (default "sweep")
+//   --baseline=CSV          flag points whose throughput fell against an earlier sweep CSV
+//   --regression-threshold=F  relative drop that counts as a regression (default 0.05)
+template <class Manager>
+int runDriver(int argc, char** argv, const char* engine) {
+    DriverParams params;
+    params.engine = engine;
+    std::string sweepPath, sweepOut = "sweep", baselinePath, recordPath, replayPath;
+    bool paced = false;
+    LiveMetricsOptions live;
+    double tolerance = 0.05;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--pin") {
+            params.pin = true;
+        }
+        else if (arg.rfind("--key-ranges=", 0) == 0) {
+            params.keyRanges = std::max(1, std::stoi(arg.substr(13)));
+        }
+        else if (arg.rfind("--clients-per-thread=", 0) == 0) {
+            params.clientsPerThread = std::max(1, std::stoi(arg.substr(21)));
+        }
+        else if (arg == "--delta-writes") {
+            params.deltaWrites = true;
+        }
+        else if (arg.rfind("--skew=", 0) == 0) {
+            params.skew = std::stod(arg.substr(7));
+        }
+        else if (arg.rfind("--memory-budget=", 0) == 0) {
+            params.memoryBudgetMB = std::stod(arg.substr(16));
+        }
+        else if (arg.rfind("--record=", 0) == 0) {
+            recordPath = arg.substr(9);
+        }
+        else if (arg.rfind("--replay=", 0) == 0) {
+            replayPath = arg.substr(9);
+        }
+        else if (arg == "--paced") {
+            paced = true;
+        }
+        else if (arg.rfind("--metrics=", 0) == 0) {
+            live.csvPath = arg.substr(10);
+        }
+        else if (arg.rfind("--metrics-page=", 0) == 0) {
+            live.pagePath = arg.substr(15);
+        }
+        else if (arg.rfind("--metrics-interval=", 0) == 0) {
+            live.intervalMs = std::max(1, std::stoi(arg.substr(19)));
+        }
+        else if (arg.rfind("--sweep=", 0) == 0) {
+            sweepPath = arg.substr(8);
+        }
+        else if (arg.rfind("--sweep-out=", 0) == 0) {
+            sweepOut = arg.substr(12);
+        }
+        else if (arg.rfind("--baseline=", 0) == 0) {
+            baselinePath = arg.substr(11);
+        }
+        else if (arg.rfind("--regression-threshold=", 0) == 0) {
+            tolerance = std::stod(arg.substr(23));
+        }
+    }
+
+    // A sweep may set every parameter itself, so the file is optional there
+    std::ifstream fin("inp-params.txt");
+    if (fin.is_open()) {
+        fin >> params.n >> params.m >> params.numTrans >> params.constVal >> params.numIters
+            >> params.lambda >> params.readRatio;
+        fin.close();
+    }
+    else if (sweepPath.empty()) {
+        std::cerr << "Error: Could not open inp-params.txt\n";
+        return 1;
+    }
+
+    bool tracing = !recordPath.empty() || !replayPath.empty();
+    if (tracing && (!sweepPath.empty() || params.clientsPerThread > 0 || IsOneShot<Manager>::value)) {
+        std::cerr << "Error: --record and --replay need a single run of an interactive engine, one client per thread\n";
+        return 1;
+    }
+    if (!recordPath.empty() && !replayPath.empty()) {
+        std::cerr << "Error: --record and --replay are exclusive\n";
+        return 1;
+    }
+
+    if (live.enabled() && !sweepPath.empty()) {
+        std::cerr << "Error: --metrics and --metrics-page need a single run\n";
+        return 1;
+    }
+
+    if (!sweepPath.empty()) {
+        return runSweep<Manager>(params, sweepPath, sweepOut, baselinePath, tolerance);
+    }
+    if (!checkParams<Manager>(params)) {
+        return 1;
+    }
+
+    Trace replay, record;
+    if (!replayPath.empty()) {
+        std::string error;
+        if (!loadTrace(replayPath, replay, error)) {
+            std::cerr << "Error: " << error << "\n";
+            return 1;
+        }
+        if (replay.m > params.m) {
+            std::cerr << "Error: the trace uses keys up to " << replay.m - 1 << ", m is " << params.m << "\n";
+            return 1;
+        }
+        long long transactions = 0;
+        for (const auto& stream : replay.streams) {
+            transactions += stream.transactions;
+        }
+        std::cout << "Replaying " << transactions << " transactions from " << replay.streams.size()
+            << " streams on " << params.n << " threads" << (paced ? ", paced" : "") << "\n";
+    }
+
+    std::cout << "n=" << params.n
+        << " m=" << params.m
+        << " numTrans=" << params.numTrans
+        << " constVal=" << params.constVal
+        << " numIters=" << params.numIters
+        << " lambda=" << params.lambda
+        << " readRatio=" << params.readRatio << "\n";
+
+    logFile.open("si_log.txt");
+    if (!logFile.is_open()) {
+        std::cerr << "Error: Could not open si_log.txt\n";
+        return 1;
+    }
+
+    if (params.pin) {
+        std::cout << "Pinning " << params.n << " workers over " << compactCpuOrder().size()
+            << " CPUs on " << numaNodeCount() << " NUMA node(s)\n";
+    }
+
+    RunMetrics r = runPoint<Manager>(params, replayPath.empty() ? nullptr : &replay, paced,
+        recordPath.empty() ? nullptr : &record, live);
+    if (params.clientsPerThread > 0) {
+        std::cout << "Ran " << params.n * params.clientsPerThread << " clients on " << params.n
+            << " threads, up to " << r.concurrency << " transactions in flight\n";
+    }
+    if (!recordPath.empty()) {
+        if (!saveTrace(record, recordPath)) {
+            std::cerr << "Error: Could not write " << recordPath << "\n";
+            return 1;
+        }
+        std::cout << "Recorded " << record.streams.size() << " streams to " << recordPath << "\n";
+    }
+
+    logFile << "-----------------------------\n";
+    logFile << "Average commit delay (ms): " << r.avgDelay << "\n";
+    logFile << "Average abort count:       " << r.avgAborts << "\n";
+    logFile << "Execution time (s):        " << r.seconds << "\n";
+    logFile << "Commits per second:        " << r.commitsPerSecond << "\n";
+    logFile << "Aborts per second:         " << r.abortsPerSecond << "\n";
+    logFile << "Serial. aborts per second: " << r.serialAbortsPerSecond << "\n";
+    logFile.close();
+
+    std::ofstream fout("si_result.txt");
+    if (fout.is_open()) {
+        fout << "Average commit delay (ms): " << r.avgDelay << "\n";
+        fout << "Average abort count:       " << r.avgAborts << "\n";
+        fout << "Execution time (s):        " << r.seconds << "\n";
+        fout << "Commits per second:        " << r.commitsPerSecond << "\n";
+        fout << "Aborts per second:         " << r.abortsPerSecond << "\n";
+        fout << "Serial. aborts per second: " << r.serialAbortsPerSecond << "\n";
+        if constexpr (HasMemoryStats<Manager>::value) {
+            fout << "Peak memory (MB):          " << r.peakMemoryMB << "\n";
+            fout << "Budget aborts per second:  " << r.budgetAbortsPerSecond << "\n";
+        }
+        fout.close();
+    }
+
+    // Per-thread, per-operation counters (only with -DENABLE_PERF_COUNTERS)
+    PERF_REPORT("perf_result.txt");
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+// Memory accounting and budget enforcement for the multiversion engines.
+//
+// An engine charges every allocation it makes to one of a few components
+// and asks a MemoryGovernor, after each begin and commit, what to do about
+// the total. With no budget nothing is ever reclaimed, as before. With one,
+// pressure is relieved in escalating steps:
+//   1. above gcFraction of the limit, collect versions no snapshot can see
+//   2. still above the limit, abort the oldest snapshot holding back
+//      collection (at most one per begin or commit) and collect again
+//   3. still above the limit, new transactions wait at begin until
+//      finishing ones bring usage back under it
+
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+enum MemoryComponent {
+    MEM_VERSIONS,   // Committed versions, current and historical
+    MEM_READERS,    // Reader tracking attached to versions
+    MEM_TX_STATE,   // Transaction contexts and buffered writes
+    MEM_INDEX,      // Per-key chain headers and lookup arrays
+    MEM_COMPONENTS
+};
+
+inline const char* memoryComponentName(int component) {
+    static const char* names[MEM_COMPONENTS] = { "versions", "readers", "tx_state", "index" };
+    return names[component];
+}
+
+// Node-based containers as libstdc++ lays them out: one heap node per entry
+// (next pointer plus the value) and an array of bucket pointers
+template <class Key, class Value>
+long long containerBytes(const std::unordered_map<Key, Value>& c) {
+    return (long long)(c.size() * (sizeof(void*) + sizeof(std::pair<const Key, Value>)) + c.bucket_count() * sizeof(void*));
+}
+
+template <class Key>
+long long containerBytes(const std::unordered_set<Key>& c) {
+    return (long long)(c.size() * (sizeof(void*) + sizeof(Key)) + c.bucket_count() * sizeof(void*));
+}
+
+template <class T>
+long long containerBytes(const std::vector<T>& c) {
+    return (long long)(c.capacity() * sizeof(T));
+}
+
+// Shape of the version store, sampled while a run is in progress
+struct VersionStats {
+    long long keys = 0;
+    long long versions = 0;         // Latest versions included
+    long long longestChain = 0;
+    long long gcBacklog = 0;        // Versions no running snapshot can see, not yet collected
+};
+
+// Versions per key, kept as a count of keys at each chain length so that
+// the total and the longest chain are known without a scan. The engine
+// reports every change of a chain's length under the lock that guards it.
+class ChainLengths {
+    std::vector<long long> keysAt;  // keysAt[n] = keys whose chain holds n versions
+    long long total = 0;
+    long long longest = 0;
+
+public:
+    void resized(size_t from, size_t to) {
+        if (from == to) {
+            return;
+        }
+        if (keysAt.size() <= std::max(from, to)) {
+            keysAt.resize(std::max(from, to) + 1, 0);
+        }
+        --keysAt[from];
+        ++keysAt[to];
+        total += (long long)to - (long long)from;
+        longest = std::max(longest, (long long)to);
+        while (longest > 0 && keysAt[longest] == 0) {
+            --longest;
+        }
+    }
+
+    void added(size_t length) {
+        if (keysAt.size() <= length) {
+            keysAt.resize(length + 1, 0);
+        }
+        ++keysAt[length];
+        total += (long long)length;
+        longest = std::max(longest, (long long)length);
+    }
+
+    long long versions() const {
+        return total;
+    }
+
+    long long longestChain() const {
+        return longest;
+    }
+};
+
+// The GC backlog depends on the horizon at the moment it is asked for, so
+// it is estimated from at most VERSION_STATS_SAMPLE evenly spaced keys:
+// perKey(k) summed over the sample and scaled to all keys. Exact when
+// there are no more keys than that. Successive calls advance offset so
+// that the sample rotates through every key.
+constexpr long long VERSION_STATS_SAMPLE = 256;
+
+template <class PerKey>
+long long sampledTotal(long long keys, long long& offset, PerKey perKey) {
+    if (keys <= 0) {
+        return 0;
+    }
+    long long stride = std::max(1LL, keys / VERSION_STATS_SAMPLE);
+    offset = (offset + 1) % stride;
+    long long sum = 0, sampled = 0;
+    for (long long k = offset; k < keys; k += stride) {
+        sum += perKey(k);
+        ++sampled;
+    }
+    return sampled == keys ? sum : sum * keys / sampled;
+}
+
+struct MemoryBudget {
+    long long limitBytes = 0;   // 0 = unbounded, nothing is reclaimed
+    double gcFraction = 0.75;   // Collect once usage passes this share of the limit
+    bool abortOldest = true;    // Step 2: abort the snapshot pinning old versions
+    bool throttle = true;       // Step 3: hold new transactions at begin
+};
+
+struct MemoryStats {
+    long long bytes[MEM_COMPONENTS] = {};
+    long long total = 0;
+    long long peak = 0;
+    long long gcRuns = 0;
+    long long versionsReclaimed = 0;
+    long long budgetAborts = 0;     // Snapshots aborted to let collection proceed
+    long long throttledBegins = 0;  // Begins that had to wait for memory
+};
+
+// Byte counts per component. Written under the engine's lock, read by
+// anyone at any time.
+class MemoryAccount {
+private:
+    std::atomic<long long> bytes[MEM_COMPONENTS] = {};
+    std::atomic<long long> total{ 0 };
+    std::atomic<long long> peak{ 0 };
+
+public:
+    void charge(MemoryComponent component, long long delta) {
+        if (delta == 0) {
+            return;
+        }
+        bytes[component].fetch_add(delta, std::memory_order_relaxed);
+        long long now = total.fetch_add(delta, std::memory_order_relaxed) + delta;
+        if (now > peak.load(std::memory_order_relaxed)) {
+            peak.store(now, std::memory_order_relaxed);
+        }
+    }
+
+    // Charge the change of a footprint from before to after
+    void recharge(MemoryComponent component, long long before, long long after) {
+        charge(component, after - before);
+    }
+
+    long long used() const {
+        return total.load(std::memory_order_relaxed);
+    }
+
+    void fill(MemoryStats& stats) const {
+        for (int c = 0; c < MEM_COMPONENTS; ++c) {
+            stats.bytes[c] = bytes[c].load(std::memory_order_relaxed);
+        }
+        stats.total = used();
+        stats.peak = peak.load(std::memory_order_relaxed);
+    }
+};
+
+// Decides when to collect, shed or throttle; the engine does the work and
+// reports back. Used under the engine's lock.
+class MemoryGovernor {
+private:
+    MemoryBudget budget;
+    long long nextCollectAt = 0;    // Usage that triggers the next collection
+    long long pinnedVersions = 0;   // Old versions the last collection had to keep
+    int collectedHorizon = 0;       // Oldest snapshot at the last collection
+
+public:
+    MemoryAccount account;
+    std::atomic<long long> gcRuns{ 0 };
+    std::atomic<long long> versionsReclaimed{ 0 };
+    std::atomic<long long> budgetAborts{ 0 };
+    std::atomic<long long> throttledBegins{ 0 };
+
+    void setBudget(const MemoryBudget& b) {
+        budget = b;
+        nextCollectAt = (long long)(budget.limitBytes * budget.gcFraction);
+    }
+
+    bool bounded() const {
+        return budget.limitBytes > 0;
+    }
+
+    bool overLimit() const {
+        return bounded() && account.used() > budget.limitBytes;
+    }
+
+    // Usage that survives a collection cannot be reclaimed until snapshots
+    // move on; wait for a sixteenth of the limit of new garbage before
+    // scanning again, so a full store does not rescan on every commit.
+    // Over the limit, also rescan as soon as the oldest snapshot (computed
+    // by horizon() only then) has moved on past versions it pinned.
+    template <class Horizon>
+    bool wantsCollection(Horizon horizon) const {
+        if (!bounded()) {
+            return false;
+        }
+        return account.used() > nextCollectAt
+            || (overLimit() && pinnedVersions > 0 && horizon() > collectedHorizon);
+    }
+
+    void collected(long long reclaimed, long long pinned, int horizon) {
+        gcRuns.fetch_add(1, std::memory_order_relaxed);
+        versionsReclaimed.fetch_add(reclaimed, std::memory_order_relaxed);
+        pinnedVersions = pinned;
+        collectedHorizon = horizon;
+        nextCollectAt = std::max((long long)(budget.limitBytes * budget.gcFraction),
+            account.used() + budget.limitBytes / 16);
+    }
+
+    // Aborting a snapshot only helps if it pins old versions; when the live
+    // data alone exceeds the limit it would just throw work away
+    bool shouldShed() const {
+        return budget.abortOldest && overLimit() && pinnedVersions > 0;
+    }
+
+    bool shouldThrottle() const {
+        return budget.throttle && overLimit();
+    }
+
+    MemoryStats stats() const {
+        MemoryStats s;
+        account.fill(s);
+        s.gcRuns = gcRuns.load(std::memory_order_relaxed);
+        s.versionsReclaimed = versionsReclaimed.load(std::memory_order_relaxed);
+        s.budgetAborts = budgetAborts.load(std::memory_order_relaxed);
+        s.throttledBegins = throttledBegins.load(std::memory_order_relaxed);
+        return s;
+    }
+};
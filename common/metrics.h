@@ -0,0 +1,387 @@
+#pragma once
+
+// Live metrics while a run is in progress. Workers and engines bump
+// per-thread counters in a lock-free registry; a sampler thread sums them
+// at a fixed interval, asks the engine for its own counters and gauges,
+// and publishes each snapshot as a CSV line (--metrics=FILE) and/or into
+// a memory-mapped page (--metrics-page=FILE) that another process reads
+// with Metrics/metrics-watch.
+//
+// The page is a seqlock: the sampler makes the sequence odd, copies the
+// sample in and makes it even again; a reader retries until it sees the
+// same even sequence before and after its copy.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum LiveCounter {
+    LIVE_BEGINS,        // Transaction attempts started
+    LIVE_COMMITS,
+    LIVE_ABORTS,        // Attempts that failed to commit, whatever the cause
+    LIVE_LOCK_WAITS,    // Lock requests that had to wait
+    LIVE_LOCK_WAIT_NS,  // Time spent in those waits
+    LIVE_COUNTERS
+};
+
+// Counters per thread, summed on demand. A thread claims a slot on its
+// first update and gives it back when it exits; the counts stay in the
+// slot for its next owner, so sums never go backwards. Threads beyond
+// SLOTS share one overflow slot.
+class LiveCounters {
+public:
+    static constexpr int SLOTS = 256;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<bool> owned{ false };
+        std::atomic<long long> values[LIVE_COUNTERS] = {};
+    };
+
+    Slot slots[SLOTS];
+    Slot overflow;  // Updated with read-modify-writes
+
+    struct Claim {
+        LiveCounters* registry = nullptr;
+        Slot* slot = nullptr;
+
+        void release() {
+            if (slot && slot != &registry->overflow) {
+                slot->owned.store(false, std::memory_order_release);
+            }
+        }
+
+        ~Claim() {
+            release();
+        }
+    };
+
+    Slot* claimSlot() {
+        for (auto& s : slots) {
+            bool expected = false;
+            if (!s.owned.load(std::memory_order_relaxed)
+                && s.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return &s;
+            }
+        }
+        return &overflow;
+    }
+
+    Slot* mySlot() {
+        static thread_local Claim claim;
+        if (claim.registry != this) {
+            claim.release();
+            claim.registry = this;
+            claim.slot = claimSlot();
+        }
+        return claim.slot;
+    }
+
+public:
+    LiveCounters() = default;
+    LiveCounters(const LiveCounters&) = delete;
+    LiveCounters& operator=(const LiveCounters&) = delete;
+
+    void add(LiveCounter counter, long long delta = 1) {
+        Slot* s = mySlot();
+        auto& value = s->values[counter];
+        if (s == &overflow) {
+            value.fetch_add(delta, std::memory_order_relaxed);
+        }
+        else {
+            value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+    }
+
+    long long total(LiveCounter counter) const {
+        long long sum = overflow.values[counter].load(std::memory_order_relaxed);
+        for (const auto& s : slots) {
+            sum += s.values[counter].load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+};
+
+// The registry the driver and the engines report to
+inline LiveCounters liveCounters;
+
+// One snapshot. Counts are cumulative since the sampler started, rates
+// cover the last interval, engine fields stay zero where an engine has
+// nothing to report.
+struct LiveSample {
+    double seconds = 0;
+    long long commits = 0;
+    long long aborts = 0;
+    long long inFlight = 0;
+    double commitsPerSecond = 0;
+    double abortsPerSecond = 0;
+    long long serializationAborts = 0;  // Certifier aborts (SSI, SSN)
+    long long deadlockAborts = 0;       // Wound-wait or wait-die aborts (MV2PL)
+    long long budgetAborts = 0;         // Snapshots shed to free memory
+    long long lockWaits = 0;
+    double lockWaitMs = 0;
+    long long versions = 0;
+    long long longestChain = 0;
+    long long gcBacklog = 0;
+    double memoryMB = 0;
+};
+
+static_assert(std::is_trivially_copyable<LiveSample>::value, "LiveSample is copied into shared memory");
+
+inline void writeLiveCsvHeader(std::ostream& out) {
+    out << "seconds,commits,aborts,in_flight,commits_per_sec,aborts_per_sec,serialization_aborts,"
+        << "deadlock_aborts,budget_aborts,lock_waits,lock_wait_ms,versions,longest_chain,gc_backlog,memory_mb\n";
+}
+
+inline void writeLiveCsvRow(std::ostream& out, const LiveSample& s) {
+    out << s.seconds << "," << s.commits << "," << s.aborts << "," << s.inFlight << ","
+        << s.commitsPerSecond << "," << s.abortsPerSecond << "," << s.serializationAborts << ","
+        << s.deadlockAborts << "," << s.budgetAborts << "," << s.lockWaits << "," << s.lockWaitMs << ","
+        << s.versions << "," << s.longestChain << "," << s.gcBacklog << "," << s.memoryMB << "\n";
+}
+
+constexpr char LIVE_PAGE_MAGIC[8] = { 'T', 'X', 'L', 'I', 'V', 'E', '1', '\0' };
+
+struct LiveMetricsPage {
+    char magic[8];
+    uint32_t intervalMs;
+    std::atomic<uint32_t> finished;     // Set after the last sample of the run
+    std::atomic<uint64_t> sequence;     // Twice the samples published, odd while writing
+    LiveSample sample;
+};
+
+// Create path afresh and map it for publishing; nullptr on failure. An
+// old page is unlinked rather than truncated, so a reader still mapping it
+// keeps its last sample instead of faulting.
+inline LiveMetricsPage* createLiveMetricsPage(const std::string& path, int intervalMs, std::string& error) {
+    ::unlink(path.c_str());
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0 || ::ftruncate(fd, sizeof(LiveMetricsPage)) != 0) {
+        error = "cannot create " + path;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return nullptr;
+    }
+    void* mem = ::mmap(nullptr, sizeof(LiveMetricsPage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) {
+        error = "cannot map " + path;
+        return nullptr;
+    }
+    auto* page = new (mem) LiveMetricsPage{};
+    page->intervalMs = (uint32_t)intervalMs;
+    std::memcpy(page->magic, LIVE_PAGE_MAGIC, sizeof(LIVE_PAGE_MAGIC));
+    return page;
+}
+
+// Map a page another process publishes to; nullptr if it is not one
+inline const LiveMetricsPage* openLiveMetricsPage(const std::string& path, std::string& error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return nullptr;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(LiveMetricsPage)) {
+        ::close(fd);
+        error = path + " is not a metrics page";
+        return nullptr;
+    }
+    void* mem = ::mmap(nullptr, sizeof(LiveMetricsPage), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) {
+        error = "cannot map " + path;
+        return nullptr;
+    }
+    auto* page = static_cast<const LiveMetricsPage*>(mem);
+    if (std::memcmp(page->magic, LIVE_PAGE_MAGIC, sizeof(LIVE_PAGE_MAGIC)) != 0) {
+        ::munmap(mem, sizeof(LiveMetricsPage));
+        error = path + " is not a metrics page";
+        return nullptr;
+    }
+    return page;
+}
+
+inline void unmapLiveMetricsPage(const LiveMetricsPage* page) {
+    ::munmap(const_cast<LiveMetricsPage*>(page), sizeof(LiveMetricsPage));
+}
+
+inline void publishLiveSample(LiveMetricsPage* page, const LiveSample& s) {
+    uint64_t seq = page->sequence.load(std::memory_order_relaxed);
+    page->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&page->sample), &s, sizeof(s));
+    page->sequence.store(seq + 2, std::memory_order_release);
+}
+
+// Latest sample and its sequence number; 0 if nothing is published yet
+inline uint64_t readLiveSample(const LiveMetricsPage* page, LiveSample& s) {
+    while (true) {
+        uint64_t before = page->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(&s, static_cast<const void*>(&page->sample), sizeof(s));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page->sequence.load(std::memory_order_relaxed) == before) {
+            return before / 2;
+        }
+    }
+}
+
+struct LiveMetricsOptions {
+    std::string csvPath;        // Time series, one row per sample
+    std::string pagePath;       // Memory-mapped page with the latest sample
+    int intervalMs = 100;
+
+    bool enabled() const {
+        return !csvPath.empty() || !pagePath.empty();
+    }
+};
+
+// Samples the registry, plus whatever probe adds from the engine, every
+// intervalMs until stopped; stop() takes a last sample at the end.
+class LiveMetricsSampler {
+public:
+    using Probe = std::function<void(LiveSample&)>;
+
+private:
+    LiveMetricsOptions options;
+    Probe probe;
+    LiveCounters& counters;
+    std::ofstream csv;
+    LiveMetricsPage* page = nullptr;
+    long long base[LIVE_COUNTERS] = {};
+    std::chrono::steady_clock::time_point started;
+    LiveSample last;
+    long long samples = 0;
+
+    std::thread sampler;
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+    bool stopping = false;
+
+    LiveSample take() {
+        LiveSample s;
+        auto now = std::chrono::steady_clock::now();
+        s.seconds = std::chrono::duration<double>(now - started).count();
+        long long count[LIVE_COUNTERS];
+        for (int c = 0; c < LIVE_COUNTERS; ++c) {
+            count[c] = counters.total((LiveCounter)c) - base[c];
+        }
+        s.commits = count[LIVE_COMMITS];
+        s.aborts = count[LIVE_ABORTS];
+        s.inFlight = std::max(0LL, count[LIVE_BEGINS] - s.commits - s.aborts);
+        s.lockWaits = count[LIVE_LOCK_WAITS];
+        s.lockWaitMs = count[LIVE_LOCK_WAIT_NS] / 1e6;
+        double interval = s.seconds - last.seconds;
+        if (interval > 0) {
+            s.commitsPerSecond = (s.commits - last.commits) / interval;
+            s.abortsPerSecond = (s.aborts - last.aborts) / interval;
+        }
+        if (probe) {
+            probe(s);
+        }
+        return s;
+    }
+
+    void emit(const LiveSample& s) {
+        if (csv.is_open()) {
+            writeLiveCsvRow(csv, s);
+            csv.flush();
+        }
+        if (page) {
+            publishLiveSample(page, s);
+        }
+        last = s;
+        ++samples;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lk(stopMutex);
+        auto next = started;
+        while (true) {
+            next += std::chrono::milliseconds(options.intervalMs);
+            if (stopSignal.wait_until(lk, next, [this] { return stopping; })) {
+                return;
+            }
+            emit(take());
+        }
+    }
+
+public:
+    LiveMetricsSampler(const LiveMetricsOptions& options, Probe probe, LiveCounters& counters = liveCounters)
+        : options(options), probe(std::move(probe)), counters(counters) {}
+
+    LiveMetricsSampler(const LiveMetricsSampler&) = delete;
+    LiveMetricsSampler& operator=(const LiveMetricsSampler&) = delete;
+
+    ~LiveMetricsSampler() {
+        stop();
+        if (page) {
+            unmapLiveMetricsPage(page);
+        }
+    }
+
+    // Open the outputs and start sampling; false (with error set) if an
+    // output cannot be opened
+    bool start(std::string& error) {
+        if (!options.csvPath.empty()) {
+            csv.open(options.csvPath);
+            if (!csv.is_open()) {
+                error = "cannot open " + options.csvPath;
+                return false;
+            }
+            writeLiveCsvHeader(csv);
+        }
+        if (!options.pagePath.empty()) {
+            page = createLiveMetricsPage(options.pagePath, options.intervalMs, error);
+            if (!page) {
+                return false;
+            }
+        }
+        for (int c = 0; c < LIVE_COUNTERS; ++c) {
+            base[c] = counters.total((LiveCounter)c);
+        }
+        started = std::chrono::steady_clock::now();
+        sampler = std::thread(&LiveMetricsSampler::run, this);
+        return true;
+    }
+
+    void stop() {
+        if (!sampler.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(stopMutex);
+            stopping = true;
+        }
+        stopSignal.notify_one();
+        sampler.join();
+        emit(take());
+        if (page) {
+            page->finished.store(1, std::memory_order_release);
+        }
+    }
+
+    long long sampleCount() const {
+        return samples;
+    }
+};
@@ -0,0 +1,275 @@
+#pragma once
+
+// Per-operation microbenchmarks shared by every engine directory, on
+// Google Benchmark. Each engine's <Engine>-bench.cc includes its header and
+// this file, then registers the suite that matches its interface:
+//
+//   ENGINE_BENCHMARKS(Manager)            beginTrans/read/write/commit engines
+//   ONE_SHOT_ENGINE_BENCHMARKS(Manager)   engines taking whole transactions
+//
+// Build and run from an engine directory, e.g.
+//   g++ -std=c++17 -O2 -pthread -o bench SI-bench.cc -lbenchmark && ./bench
+// (bench.sh at the top level does this for every engine).
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include <random>
+#include "traits.h"
+
+constexpr int BENCH_KEYS = 4096;          // Data items in single-threaded benchmarks
+constexpr int BENCH_BATCH = 64;           // Timed operations between untimed clean-ups
+constexpr int BENCH_READERS = 16;         // Old-snapshot readers per read-benchmark setup
+constexpr int BENCH_READS_PER_READER = 256;
+constexpr int BENCH_OPS_PER_TXN = 4;      // Read-modify-writes per contended transaction
+constexpr int BENCH_ONE_SHOT_BATCH = 4096;
+
+// End a transaction outside the timed region. Engines without abort()
+// commit instead, which installs whatever the transaction wrote.
+template <class Manager>
+void finishTrans(Manager& manager, int txID) {
+    if constexpr (HasAbort<Manager>::value) {
+        manager.abort(txID);
+    }
+    else {
+        manager.commit(txID);
+    }
+}
+
+// Begin a transaction that will only read, telling engines that care
+template <class Manager>
+int beginReader(Manager& manager) {
+    if constexpr (HasReadOnlyBegin<Manager>::value) {
+        return manager.beginTrans(true);
+    }
+    else {
+        return manager.beginTrans();
+    }
+}
+
+// Engine shared by the threads of one multi-threaded run, created and
+// destroyed by the benchmark's Setup/Teardown callbacks
+template <class Manager>
+inline std::unique_ptr<Manager> sharedBenchManager;
+
+template <class Manager>
+void setUpSharedManager(const benchmark::State&) {
+    sharedBenchManager<Manager> = std::make_unique<Manager>(BENCH_KEYS);
+}
+
+template <class Manager>
+void tearDownSharedManager(const benchmark::State&) {
+    sharedBenchManager<Manager>.reset();
+}
+
+// ---------------- interactive engines ---------------- //
+
+template <class Manager>
+void BM_Begin(benchmark::State& state) {
+    Manager manager(BENCH_KEYS);
+    std::vector<int> open;
+    open.reserve(BENCH_BATCH);
+    for (auto _ : state) {
+        open.push_back(manager.beginTrans());
+        if ((int)open.size() == BENCH_BATCH) {
+            state.PauseTiming();
+            for (int txID : open) {
+                finishTrans(manager, txID);
+            }
+            open.clear();
+            state.ResumeTiming();
+        }
+    }
+    for (int txID : open) {
+        finishTrans(manager, txID);
+    }
+}
+
+// Reads of one key by transactions whose snapshot predates range(0)
+// committed versions of it, so a multiversion engine walks the whole chain.
+// Single-version engines read the current value regardless.
+template <class Manager>
+void BM_Read(benchmark::State& state) {
+    const int chain = (int)state.range(0);
+    std::unique_ptr<Manager> manager;
+    std::vector<int> readers;
+    size_t current = 0;
+    int reads = 0;
+    long long failed = 0;
+
+    auto setUp = [&] {
+        if (manager) {
+            for (int txID : readers) {
+                finishTrans(*manager, txID);
+            }
+        }
+        manager = std::make_unique<Manager>(BENCH_KEYS);
+        readers.clear();
+        for (int r = 0; r < BENCH_READERS; ++r) {
+            readers.push_back(beginReader(*manager));
+        }
+        for (int v = 0; v < chain; ++v) {
+            int writer = manager->beginTrans();
+            manager->write(writer, 0, v + 1);
+            manager->commit(writer);
+        }
+        current = 0;
+        reads = 0;
+    };
+    setUp();
+
+    for (auto _ : state) {
+        int value = manager->read(readers[current], 0);
+        benchmark::DoNotOptimize(value);
+        failed += (value < 0);
+        if (++reads == BENCH_READS_PER_READER) {
+            reads = 0;
+            if (++current == readers.size()) {
+                state.PauseTiming();
+                setUp();
+                state.ResumeTiming();
+            }
+        }
+    }
+    state.counters["failed_reads"] = benchmark::Counter((double)failed, benchmark::Counter::kAvgIterations);
+    for (int txID : readers) {
+        finishTrans(*manager, txID);
+    }
+}
+
+// Buffered writes to distinct keys, BENCH_BATCH per transaction
+template <class Manager>
+void BM_Write(benchmark::State& state) {
+    Manager manager(BENCH_KEYS);
+    int txID = manager.beginTrans();
+    int writes = 0;
+    int key = 0;
+    for (auto _ : state) {
+        manager.write(txID, key, writes);
+        key = (key + 1) % BENCH_KEYS;
+        if (++writes == BENCH_BATCH) {
+            state.PauseTiming();
+            finishTrans(manager, txID);
+            txID = manager.beginTrans();
+            writes = 0;
+            state.ResumeTiming();
+        }
+    }
+    finishTrans(manager, txID);
+}
+
+// Commit of a transaction that wrote range(0) keys no one else touches
+template <class Manager>
+void BM_Commit(benchmark::State& state) {
+    const int writeSet = (int)state.range(0);
+    Manager manager(BENCH_KEYS);
+    int nextKey = 0;
+    long long aborts = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        int txID = manager.beginTrans();
+        for (int i = 0; i < writeSet; ++i) {
+            manager.write(txID, nextKey, i);
+            nextKey = (nextKey + 1) % BENCH_KEYS;
+        }
+        state.ResumeTiming();
+        aborts += !manager.commit(txID);
+    }
+    state.counters["aborts"] = benchmark::Counter((double)aborts, benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * writeSet);
+}
+
+// Whole read-modify-write transactions from several threads on the first
+// range(0) keys, retried until they commit; time is per committed transaction
+template <class Manager>
+void BM_ContendedTxn(benchmark::State& state) {
+    Manager& manager = *sharedBenchManager<Manager>;
+    std::mt19937 rng(state.thread_index() + 1);
+    std::uniform_int_distribution<int> distKey(0, (int)state.range(0) - 1);
+    long long aborts = 0;
+    for (auto _ : state) {
+        while (true) {
+            int txID = manager.beginTrans();
+            for (int i = 0; i < BENCH_OPS_PER_TXN; ++i) {
+                int key = distKey(rng);
+                int value = manager.read(txID, key);
+                manager.write(txID, key, value + 1);
+            }
+            if (manager.commit(txID)) {
+                break;
+            }
+            ++aborts;
+        }
+    }
+    state.counters["aborts"] = benchmark::Counter((double)aborts, benchmark::Counter::kAvgIterations);
+}
+
+#define ENGINE_BENCHMARKS(Manager)                                                              \
+    BENCHMARK_TEMPLATE(BM_Begin, Manager);                                                      \
+    BENCHMARK_TEMPLATE(BM_Read, Manager)->Arg(1)->Arg(8)->Arg(64)->Arg(512);                    \
+    BENCHMARK_TEMPLATE(BM_Write, Manager);                                                      \
+    BENCHMARK_TEMPLATE(BM_Commit, Manager)->Arg(1)->Arg(4)->Arg(16)->Arg(64);                   \
+    BENCHMARK_TEMPLATE(BM_ContendedTxn, Manager)->Arg(16)->Arg(BENCH_KEYS)                      \
+        ->Setup(setUpSharedManager<Manager>)->Teardown(tearDownSharedManager<Manager>)          \
+        ->ThreadRange(1, 8)->UseRealTime()
+
+// ---------------- one-shot engines ---------------- //
+
+// Cost per transaction of range(0) read-modify-writes on distinct keys,
+// submitted BENCH_ONE_SHOT_BATCH at a time and awaited together (includes
+// any batching delay of the engine)
+template <class Manager>
+void BM_OneShot(benchmark::State& state) {
+    const int keysPerTxn = (int)state.range(0);
+    Manager manager(BENCH_KEYS);
+    std::vector<typename Manager::Ticket> tickets;
+    tickets.reserve(BENCH_ONE_SHOT_BATCH);
+    int nextKey = 0;
+    for (auto _ : state) {
+        std::vector<int> keys;
+        for (int i = 0; i < keysPerTxn; ++i) {
+            keys.push_back(nextKey);
+            nextKey = (nextKey + 1) % BENCH_KEYS;
+        }
+        tickets.push_back(manager.submit(keys, keys, [keys](auto& ctx) {
+            for (int key : keys) {
+                ctx.write(key, ctx.read(key) + 1);
+            }
+        }));
+        if ((int)tickets.size() == BENCH_ONE_SHOT_BATCH) {
+            for (const auto& ticket : tickets) {
+                manager.wait(ticket);
+            }
+            tickets.clear();
+        }
+    }
+    for (const auto& ticket : tickets) {
+        manager.wait(ticket);
+    }
+}
+
+// execute() from several threads on the first range(0) keys
+template <class Manager>
+void BM_ContendedOneShot(benchmark::State& state) {
+    Manager& manager = *sharedBenchManager<Manager>;
+    std::mt19937 rng(state.thread_index() + 1);
+    std::uniform_int_distribution<int> distKey(0, (int)state.range(0) - 1);
+    for (auto _ : state) {
+        std::vector<int> keys;
+        for (int i = 0; i < BENCH_OPS_PER_TXN; ++i) {
+            keys.push_back(distKey(rng));
+        }
+        int txID = manager.execute(keys, keys, [keys](auto& ctx) {
+            for (int key : keys) {
+                ctx.write(key, ctx.read(key) + 1);
+            }
+        });
+        benchmark::DoNotOptimize(txID);
+    }
+}
+
+#define ONE_SHOT_ENGINE_BENCHMARKS(Manager)                                                     \
+    BENCHMARK_TEMPLATE(BM_OneShot, Manager)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();            \
+    BENCHMARK_TEMPLATE(BM_ContendedOneShot, Manager)->Arg(16)->Arg(BENCH_KEYS)                  \
+        ->Setup(setUpSharedManager<Manager>)->Teardown(tearDownSharedManager<Manager>)          \
+        ->ThreadRange(1, 8)->UseRealTime()
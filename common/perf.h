@@ -0,0 +1,262 @@
+#pragma once
+
+// Optional hardware counter instrumentation. Build with
+// -DENABLE_PERF_COUNTERS to sample cycles, instructions, LLC misses and
+// branch misses around every engine operation (via perf_event_open) and to
+// time waits on engine mutexes. Without the flag every macro below expands
+// to nothing and PerfLockGuard is a plain std::lock_guard.
+
+#include <mutex>
+
+enum PerfOp {
+    PERF_BEGIN_OP,
+    PERF_READ_OP,
+    PERF_WRITE_OP,
+    PERF_COMMIT_OP,
+    PERF_ABORT_OP,   // commit attempts that failed
+    NUM_PERF_OPS
+};
+
+#ifdef ENABLE_PERF_COUNTERS
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    NUM_PERF_EVENTS
+};
+
+struct PerfSample {
+    uint64_t events[NUM_PERF_EVENTS] = {};
+    std::chrono::steady_clock::time_point at;
+};
+
+struct PerfOpTotals {
+    uint64_t calls = 0;
+    uint64_t ns = 0;
+    uint64_t events[NUM_PERF_EVENTS] = {};
+};
+
+struct PerfThreadTotals {
+    int thread = 0;
+    bool hwCounters = false;
+    PerfOpTotals ops[NUM_PERF_OPS];
+    uint64_t lockAcquires = 0;
+    uint64_t lockContended = 0;
+    uint64_t lockWaitNs = 0;
+};
+
+// Totals of threads that have exited, collected for the final report
+class PerfRegistry {
+private:
+    std::mutex mtx;
+    std::vector<PerfThreadTotals> threads;
+    int nextThread = 0;
+
+public:
+    static PerfRegistry& instance() {
+        static PerfRegistry registry;
+        return registry;
+    }
+
+    int registerThread() {
+        std::lock_guard<std::mutex> lk(mtx);
+        return ++nextThread;
+    }
+
+    void publish(const PerfThreadTotals& totals) {
+        std::lock_guard<std::mutex> lk(mtx);
+        threads.push_back(totals);
+    }
+
+    void report(const std::string& path) {
+        static const char* opNames[NUM_PERF_OPS] = { "begin", "read", "write", "commit", "abort" };
+        std::lock_guard<std::mutex> lk(mtx);
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            return;
+        }
+
+        PerfThreadTotals all;
+        out << "thread,op,calls,avg_ns,avg_cycles,avg_instructions,llc_misses_per_op,branch_misses_per_op\n";
+        for (const auto& t : threads) {
+            all.hwCounters = all.hwCounters || t.hwCounters;
+            for (int op = 0; op < NUM_PERF_OPS; ++op) {
+                writeRow(out, std::to_string(t.thread), opNames[op], t.ops[op], t.hwCounters);
+                all.ops[op].calls += t.ops[op].calls;
+                all.ops[op].ns += t.ops[op].ns;
+                for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+                    all.ops[op].events[e] += t.ops[op].events[e];
+                }
+            }
+            all.lockAcquires += t.lockAcquires;
+            all.lockContended += t.lockContended;
+            all.lockWaitNs += t.lockWaitNs;
+        }
+        for (int op = 0; op < NUM_PERF_OPS; ++op) {
+            writeRow(out, "all", opNames[op], all.ops[op], all.hwCounters);
+        }
+
+        out << "\nthread,lock_acquires,lock_contended,lock_wait_ns\n";
+        for (const auto& t : threads) {
+            out << t.thread << "," << t.lockAcquires << "," << t.lockContended << "," << t.lockWaitNs << "\n";
+        }
+        out << "all," << all.lockAcquires << "," << all.lockContended << "," << all.lockWaitNs << "\n";
+    }
+
+private:
+    static void writeRow(std::ofstream& out, const std::string& thread, const char* op,
+        const PerfOpTotals& t, bool hw) {
+        if (t.calls == 0) {
+            return;
+        }
+        double calls = (double)t.calls;
+        out << thread << "," << op << "," << t.calls << "," << std::fixed << std::setprecision(1)
+            << t.ns / calls;
+        for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+            out << ",";
+            if (hw) {
+                out << std::setprecision(e < PERF_LLC_MISSES ? 1 : 3) << t.events[e] / calls;
+            }
+        }
+        out << std::defaultfloat << "\n";
+    }
+};
+
+// Per-thread counter group. Falls back to wall time only if the kernel
+// refuses perf_event_open (e.g. perf_event_paranoid or no PMU in a VM).
+class PerfThread {
+private:
+    int fds[NUM_PERF_EVENTS];
+    PerfThreadTotals totals;
+
+    static int openEvent(uint32_t type, uint64_t config, int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = groupFd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+    }
+
+public:
+    PerfThread() {
+        totals.thread = PerfRegistry::instance().registerThread();
+        fds[PERF_CYCLES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+        int leader = fds[PERF_CYCLES];
+        fds[PERF_INSTRUCTIONS] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, leader);
+        fds[PERF_LLC_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, leader);
+        fds[PERF_BRANCH_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, leader);
+
+        totals.hwCounters = true;
+        for (int fd : fds) {
+            totals.hwCounters = totals.hwCounters && fd >= 0;
+        }
+        if (totals.hwCounters) {
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    ~PerfThread() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        PerfRegistry::instance().publish(totals);
+    }
+
+    PerfSample sample() {
+        PerfSample s;
+        if (totals.hwCounters) {
+            uint64_t buf[1 + NUM_PERF_EVENTS];
+            if (::read(fds[PERF_CYCLES], buf, sizeof(buf)) == (ssize_t)sizeof(buf)) {
+                for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+                    s.events[e] = buf[1 + e];
+                }
+            }
+        }
+        s.at = std::chrono::steady_clock::now();
+        return s;
+    }
+
+    void record(PerfOp op, const PerfSample& start) {
+        PerfSample end = sample();
+        PerfOpTotals& t = totals.ops[op];
+        ++t.calls;
+        t.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end.at - start.at).count();
+        for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+            t.events[e] += end.events[e] - start.events[e];
+        }
+    }
+
+    void recordLock(bool contended, uint64_t waitNs) {
+        ++totals.lockAcquires;
+        if (contended) {
+            ++totals.lockContended;
+            totals.lockWaitNs += waitNs;
+        }
+    }
+
+    static PerfThread& current() {
+        static thread_local PerfThread perf;
+        return perf;
+    }
+};
+
+// lock_guard that also accounts how long the caller waited for the mutex
+class PerfLockGuard {
+private:
+    std::mutex& mtx;
+
+public:
+    explicit PerfLockGuard(std::mutex& m) : mtx(m) {
+        if (mtx.try_lock()) {
+            PerfThread::current().recordLock(false, 0);
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        mtx.lock();
+        auto waited = std::chrono::steady_clock::now() - start;
+        PerfThread::current().recordLock(true,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+    }
+
+    ~PerfLockGuard() {
+        mtx.unlock();
+    }
+
+    PerfLockGuard(const PerfLockGuard&) = delete;
+    PerfLockGuard& operator=(const PerfLockGuard&) = delete;
+};
+
+#define PERF_START(name) PerfSample name = PerfThread::current().sample()
+#define PERF_STOP(name, op) PerfThread::current().record(op, name)
+#define PERF_REPORT(path) PerfRegistry::instance().report(path)
+
+#else
+
+using PerfLockGuard = std::lock_guard<std::mutex>;
+
+#define PERF_START(name) ((void)0)
+#define PERF_STOP(name, op) ((void)0)
+#define PERF_REPORT(path) ((void)0)
+
+#endif
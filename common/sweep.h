@@ -0,0 +1,359 @@
+#pragma once
+
+// Parameter sweeps for the benchmark driver: one process runs every point
+// of a sweep specification several times and reports mean, standard
+// deviation and a 95% confidence interval per point.
+//
+// Specification file, one axis per line; unlisted parameters keep the
+// value from inp-params.txt and the driver flags:
+//
+//   # comment
+//   threads    = 2, 4, 8, 16
+//   read_ratio = 0.5, 0.7, 0.9
+//   m          = 1000
+//   skew       = 0, 0.9          (Zipf exponent of key choice, 0 = uniform)
+//   engine     = SI, OCC         (points for other engines are skipped)
+//   trials     = 5
+//
+// Other axes: num_trans, const_val, num_iters, lambda, key_ranges,
+// clients_per_thread.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+
+struct DriverParams {
+    std::string engine;
+    int n = 1;                  // Threads
+    int m = 1000;               // Data items
+    int numTrans = 100;         // Transactions per thread (or per client)
+    int constVal = 100;
+    int numIters = 10;          // Operations per transaction
+    double lambda = 10;         // Mean think time (ms)
+    double readRatio = 0.7;
+    double skew = 0.0;          // Zipf exponent of key choice, 0 = uniform
+    int keyRanges = 1;
+    int clientsPerThread = 0;   // 0 = one client per OS thread
+    bool pin = false;
+    bool deltaWrites = false;
+    double memoryBudgetMB = 0;  // 0 = unbounded
+};
+
+struct RunMetrics {
+    double avgDelay = 0.0;
+    double avgAborts = 0.0;
+    double seconds = 0.0;
+    double commitsPerSecond = 0.0;
+    double abortsPerSecond = 0.0;
+    double serialAbortsPerSecond = 0.0;
+    double peakMemoryMB = 0.0;          // Engines with memory accounting only
+    double budgetAbortsPerSecond = 0.0;
+    int concurrency = 0;                // Transactions open at once at most: clients, capped by the context pool
+};
+
+struct SampleStats {
+    double mean = 0.0;
+    double sd = 0.0;        // Sample standard deviation
+    double ci95 = 0.0;      // Half-width of the 95% confidence interval of the mean
+};
+
+// Two-sided 95% Student t quantile for df degrees of freedom
+inline double tQuantile95(int df) {
+    static const double table[] = { 0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    if (df < 1) {
+        return 0.0;
+    }
+    return df <= 30 ? table[df] : 1.96;
+}
+
+inline SampleStats summarize(const std::vector<double>& samples) {
+    SampleStats s;
+    if (samples.empty()) {
+        return s;
+    }
+    for (double x : samples) {
+        s.mean += x;
+    }
+    s.mean /= samples.size();
+    if (samples.size() > 1) {
+        double sq = 0.0;
+        for (double x : samples) {
+            sq += (x - s.mean) * (x - s.mean);
+        }
+        s.sd = std::sqrt(sq / (samples.size() - 1));
+        s.ci95 = tQuantile95((int)samples.size() - 1) * s.sd / std::sqrt((double)samples.size());
+    }
+    return s;
+}
+
+struct SweepSpec {
+    std::vector<std::pair<std::string, std::vector<std::string>>> axes;  // In file order
+    int trials = 3;
+};
+
+inline std::string trimmed(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    size_t e = s.find_last_not_of(" \t\r");
+    return b == std::string::npos ? "" : s.substr(b, e - b + 1);
+}
+
+inline bool isSweepAxis(const std::string& key) {
+    static const char* axes[] = { "engine", "threads", "m", "num_trans", "const_val", "num_iters",
+        "lambda", "read_ratio", "skew", "key_ranges", "clients_per_thread" };
+    return std::find_if(std::begin(axes), std::end(axes), [&](const char* a) { return key == a; }) != std::end(axes);
+}
+
+// Returns false (with a message on stderr) on a malformed specification
+inline bool parseSweepSpec(std::istream& in, SweepSpec& spec) {
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        line = trimmed(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << "Error: sweep line " << lineNo << ": expected key = values\n";
+            return false;
+        }
+        std::string key = trimmed(line.substr(0, eq));
+        std::vector<std::string> values;
+        std::stringstream ss(line.substr(eq + 1));
+        std::string value;
+        while (std::getline(ss, value, ',')) {
+            value = trimmed(value);
+            if (!value.empty()) {
+                values.push_back(value);
+            }
+        }
+        if (values.empty()) {
+            std::cerr << "Error: sweep line " << lineNo << ": no values for " << key << "\n";
+            return false;
+        }
+        if (key == "trials") {
+            spec.trials = std::max(1, std::stoi(values[0]));
+        }
+        else if (isSweepAxis(key)) {
+            spec.axes.emplace_back(key, values);
+        }
+        else {
+            std::cerr << "Error: sweep line " << lineNo << ": unknown parameter " << key << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void applySweepValue(DriverParams& p, const std::string& key, const std::string& value) {
+    if (key == "engine") p.engine = value;
+    else if (key == "threads") p.n = std::stoi(value);
+    else if (key == "m") p.m = std::stoi(value);
+    else if (key == "num_trans") p.numTrans = std::stoi(value);
+    else if (key == "const_val") p.constVal = std::stoi(value);
+    else if (key == "num_iters") p.numIters = std::stoi(value);
+    else if (key == "lambda") p.lambda = std::stod(value);
+    else if (key == "read_ratio") p.readRatio = std::stod(value);
+    else if (key == "skew") p.skew = std::stod(value);
+    else if (key == "key_ranges") p.keyRanges = std::stoi(value);
+    else if (key == "clients_per_thread") p.clientsPerThread = std::stoi(value);
+}
+
+// Cartesian product of the axes, the last axis varying fastest
+inline std::vector<DriverParams> expandSweep(const SweepSpec& spec, const DriverParams& base) {
+    std::vector<DriverParams> points{ base };
+    for (const auto& [key, values] : spec.axes) {
+        std::vector<DriverParams> next;
+        for (const auto& p : points) {
+            for (const auto& v : values) {
+                DriverParams q = p;
+                applySweepValue(q, key, v);
+                next.push_back(q);
+            }
+        }
+        points.swap(next);
+    }
+    return points;
+}
+
+struct SweepPoint {
+    DriverParams params;
+    std::vector<RunMetrics> trials;
+};
+
+// Columns identifying a point; a baseline row matches on all of them
+inline const char* SWEEP_KEY_HEADER =
+    "engine,threads,m,read_ratio,skew,key_ranges,clients_per_thread,num_trans,num_iters,lambda,const_val";
+
+inline std::string sweepKey(const DriverParams& p) {
+    std::ostringstream os;
+    os << p.engine << "," << p.n << "," << p.m << "," << p.readRatio << "," << p.skew << ","
+        << p.keyRanges << "," << p.clientsPerThread << "," << p.numTrans << "," << p.numIters << ","
+        << p.lambda << "," << p.constVal;
+    return os.str();
+}
+
+// Numbers re-printed one way, so "0.70" in a hand-edited baseline matches "0.7"
+inline std::string canonicalKey(const std::string& key) {
+    std::stringstream ss(key);
+    std::ostringstream out;
+    out << std::setprecision(12);
+    std::string col;
+    for (int c = 0; std::getline(ss, col, ','); ++c) {
+        out << (c ? "," : "");
+        if (c == 0) {
+            out << col;     // Engine name
+        }
+        else {
+            out << std::stod(col);
+        }
+    }
+    return out.str();
+}
+
+struct SweepMetric {
+    const char* name;
+    double RunMetrics::* field;
+};
+
+inline const SweepMetric SWEEP_METRICS[] = {
+    { "commits_per_sec", &RunMetrics::commitsPerSecond },
+    { "aborts_per_sec", &RunMetrics::abortsPerSecond },
+    { "ser_aborts_per_sec", &RunMetrics::serialAbortsPerSecond },
+    { "commit_delay_ms", &RunMetrics::avgDelay },
+    { "abort_count", &RunMetrics::avgAborts },
+};
+
+inline SampleStats metricStats(const SweepPoint& point, const SweepMetric& metric) {
+    std::vector<double> samples;
+    for (const auto& t : point.trials) {
+        samples.push_back(t.*metric.field);
+    }
+    return summarize(samples);
+}
+
+// One row per point: the key columns, trials, then mean/sd/ci95 per metric
+inline void writeSweepCsv(std::ostream& out, const std::vector<SweepPoint>& points) {
+    out << SWEEP_KEY_HEADER << ",trials";
+    for (const auto& metric : SWEEP_METRICS) {
+        out << "," << metric.name << "_mean," << metric.name << "_sd," << metric.name << "_ci95";
+    }
+    out << "\n";
+    for (const auto& point : points) {
+        out << sweepKey(point.params) << "," << point.trials.size();
+        for (const auto& metric : SWEEP_METRICS) {
+            SampleStats s = metricStats(point, metric);
+            out << "," << s.mean << "," << s.sd << "," << s.ci95;
+        }
+        out << "\n";
+    }
+}
+
+// Same content as the CSV plus the individual trial values
+inline void writeSweepJson(std::ostream& out, const std::vector<SweepPoint>& points) {
+    out << "[\n";
+    for (size_t i = 0; i < points.size(); ++i) {
+        const DriverParams& p = points[i].params;
+        out << "  {\"engine\": \"" << p.engine << "\", \"threads\": " << p.n << ", \"m\": " << p.m
+            << ", \"read_ratio\": " << p.readRatio << ", \"skew\": " << p.skew
+            << ", \"key_ranges\": " << p.keyRanges << ", \"clients_per_thread\": " << p.clientsPerThread
+            << ", \"num_trans\": " << p.numTrans << ", \"num_iters\": " << p.numIters
+            << ", \"lambda\": " << p.lambda << ", \"const_val\": " << p.constVal
+            << ", \"trials\": " << points[i].trials.size();
+        for (const auto& metric : SWEEP_METRICS) {
+            SampleStats s = metricStats(points[i], metric);
+            out << ",\n    \"" << metric.name << "\": {\"mean\": " << s.mean << ", \"sd\": " << s.sd
+                << ", \"ci95\": " << s.ci95 << ", \"samples\": [";
+            for (size_t t = 0; t < points[i].trials.size(); ++t) {
+                out << (t ? ", " : "") << points[i].trials[t].*metric.field;
+            }
+            out << "]}";
+        }
+        out << "}" << (i + 1 < points.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+// Throughput of every point present in a baseline CSV (written by
+// writeSweepCsv); a point regresses when its mean drops by more than
+// tolerance and the two 95% intervals do not overlap. Returns the number
+// of regressions, or -1 if the baseline cannot be read.
+inline int compareWithBaseline(const std::string& path, const std::vector<SweepPoint>& points, double tolerance) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Could not open baseline " << path << "\n";
+        return -1;
+    }
+
+    std::string keyHeader(SWEEP_KEY_HEADER);
+    const int keyColumns = (int)std::count(keyHeader.begin(), keyHeader.end(), ',') + 1;
+
+    std::string line;
+    std::getline(in, line);
+    std::vector<std::string> header;
+    {
+        std::stringstream ss(line);
+        std::string col;
+        while (std::getline(ss, col, ',')) {
+            header.push_back(trimmed(col));
+        }
+    }
+    auto column = [&](const std::string& name) {
+        auto it = std::find(header.begin(), header.end(), name);
+        return it == header.end() ? -1 : (int)(it - header.begin());
+    };
+    int meanCol = column("commits_per_sec_mean");
+    int ciCol = column("commits_per_sec_ci95");
+    if (meanCol < 0 || ciCol < 0) {
+        std::cerr << "Error: " << path << " is not a sweep CSV\n";
+        return -1;
+    }
+
+    std::map<std::string, SampleStats> baseline;
+    while (std::getline(in, line)) {
+        std::vector<std::string> cols;
+        std::stringstream ss(line);
+        std::string col;
+        while (std::getline(ss, col, ',')) {
+            cols.push_back(col);
+        }
+        if ((int)cols.size() <= std::max({ meanCol, ciCol, keyColumns - 1 })) {
+            continue;
+        }
+        std::string key;
+        for (int c = 0; c < keyColumns; ++c) {
+            key += (c ? "," : "") + cols[c];
+        }
+        SampleStats s;
+        s.mean = std::stod(cols[meanCol]);
+        s.ci95 = std::stod(cols[ciCol]);
+        baseline[canonicalKey(key)] = s;
+    }
+
+    int regressions = 0;
+    for (const auto& point : points) {
+        auto it = baseline.find(canonicalKey(sweepKey(point.params)));
+        if (it == baseline.end()) {
+            continue;
+        }
+        SampleStats cur = metricStats(point, SWEEP_METRICS[0]);
+        const SampleStats& base = it->second;
+        if (cur.mean < base.mean * (1.0 - tolerance) && cur.mean + cur.ci95 < base.mean - base.ci95) {
+            ++regressions;
+            std::cout << "REGRESSION " << sweepKey(point.params) << ": " << base.mean << " -> " << cur.mean
+                << " commits/s (" << std::fixed << std::setprecision(1)
+                << 100.0 * (cur.mean - base.mean) / base.mean << "%)" << std::defaultfloat
+                << std::setprecision(6) << "\n";
+        }
+    }
+    return regressions;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+// Workload traces: per-client streams of transactions with their keys,
+// values and think times, in a compact binary file. The driver records
+// the transactions its workers commit (--record) and replays a trace
+// against any interactive engine (--replay), stream s on thread s % n,
+// either as fast as possible or with the recorded think times (--paced).
+//
+// File layout, integers little-endian:
+//   "TXTRACE1" | u32 streams | u32 m | per stream: u64 transactions | u64 bytes | bytes
+// A stream is a sequence of transactions; a transaction is a begin entry,
+// its operations and a commit entry. Every entry is an op byte followed by
+// varints: the key, the value (zigzag) where the op has one, then the think
+// time in microseconds that follows the operation.
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+enum TraceOp : uint8_t {
+    TRACE_BEGIN = 1,        // Update transaction
+    TRACE_BEGIN_READ_ONLY,  // Transaction that only reads
+    TRACE_READ,             // key
+    TRACE_WRITE,            // key, value written
+    TRACE_RMW,              // key, delta: write the value just read plus delta
+    TRACE_ADD,              // key, delta: blind increment
+    TRACE_COMMIT,
+};
+
+constexpr char TRACE_MAGIC[8] = { 'T', 'X', 'T', 'R', 'A', 'C', 'E', '1' };
+
+inline bool traceOpHasKey(TraceOp op) {
+    return op >= TRACE_READ && op <= TRACE_ADD;
+}
+
+inline bool traceOpHasValue(TraceOp op) {
+    return op >= TRACE_WRITE && op <= TRACE_ADD;
+}
+
+struct TraceEntry {
+    TraceOp op;
+    int key = 0;
+    int value = 0;
+    int thinkMicros = 0;
+};
+
+struct TraceStream {
+    std::vector<uint8_t> bytes;
+    long long transactions = 0;
+};
+
+struct Trace {
+    int m = 0;                          // Keys are 0..m-1
+    std::vector<TraceStream> streams;
+};
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+inline bool getVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        uint8_t b = in[pos++];
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void appendTraceEntry(std::vector<uint8_t>& out, const TraceEntry& e) {
+    out.push_back(e.op);
+    if (traceOpHasKey(e.op)) {
+        putVarint(out, (uint32_t)e.key);
+    }
+    if (traceOpHasValue(e.op)) {
+        putVarint(out, ((uint32_t)e.value << 1) ^ (uint32_t)(e.value >> 31)); // zigzag
+    }
+    if (traceOpHasKey(e.op)) {
+        putVarint(out, (uint32_t)e.thinkMicros);
+    }
+}
+
+// Decodes one stream entry by entry; false at the end or on corruption
+class TraceCursor {
+private:
+    const std::vector<uint8_t>& bytes;
+    size_t pos = 0;
+
+public:
+    explicit TraceCursor(const TraceStream& stream) : bytes(stream.bytes) {}
+
+    bool next(TraceEntry& e) {
+        if (pos >= bytes.size() || bytes[pos] < TRACE_BEGIN || bytes[pos] > TRACE_COMMIT) {
+            return false;
+        }
+        e = TraceEntry{ (TraceOp)bytes[pos++] };
+        uint64_t v;
+        if (traceOpHasKey(e.op)) {
+            if (!getVarint(bytes, pos, v)) {
+                return false;
+            }
+            e.key = (int)v;
+        }
+        if (traceOpHasValue(e.op)) {
+            if (!getVarint(bytes, pos, v)) {
+                return false;
+            }
+            e.value = (int)((uint32_t)(v >> 1) ^ (0u - (uint32_t)(v & 1)));
+        }
+        if (traceOpHasKey(e.op)) {
+            if (!getVarint(bytes, pos, v)) {
+                return false;
+            }
+            e.thinkMicros = (int)v;
+        }
+        return true;
+    }
+
+    // The operations of the next transaction, begin and commit excluded
+    bool nextTransaction(bool& readOnly, std::vector<TraceEntry>& ops) {
+        TraceEntry e;
+        if (!next(e) || (e.op != TRACE_BEGIN && e.op != TRACE_BEGIN_READ_ONLY)) {
+            return false;
+        }
+        readOnly = e.op == TRACE_BEGIN_READ_ONLY;
+        ops.clear();
+        while (next(e)) {
+            if (e.op == TRACE_COMMIT) {
+                return true;
+            }
+            if (!traceOpHasKey(e.op)) {
+                return false;
+            }
+            ops.push_back(e);
+        }
+        return false;
+    }
+};
+
+// Collects one client's attempts and keeps those that commit. Every method
+// is a no-op without a stream, so workers call it unconditionally.
+class TraceRecorder {
+private:
+    TraceStream* stream;
+    size_t attemptStart = 0;
+
+public:
+    explicit TraceRecorder(TraceStream* stream) : stream(stream) {}
+
+    void begin(bool readOnly) {
+        if (stream) {
+            attemptStart = stream->bytes.size();
+            stream->bytes.push_back(readOnly ? TRACE_BEGIN_READ_ONLY : TRACE_BEGIN);
+        }
+    }
+
+    void op(TraceOp op, int key, int value = 0) {
+        if (stream) {
+            appendTraceEntry(stream->bytes, { op, key, value, 0 });
+        }
+    }
+
+    // Think time after the last operation; rewrites its trailing varint
+    void think(int micros) {
+        if (stream && micros > 0) {
+            stream->bytes.pop_back(); // Was a one-byte zero
+            putVarint(stream->bytes, (uint32_t)micros);
+        }
+    }
+
+    void commit(bool ok) {
+        if (!stream) {
+            return;
+        }
+        if (ok) {
+            stream->bytes.push_back(TRACE_COMMIT);
+            ++stream->transactions;
+        }
+        else {
+            stream->bytes.resize(attemptStart);
+        }
+    }
+};
+
+inline bool saveTrace(const Trace& trace, const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    auto put = [&](uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.put((char)(v >> (8 * i)));
+        }
+    };
+    out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    put(trace.streams.size(), 4);
+    put((uint32_t)trace.m, 4);
+    for (const auto& s : trace.streams) {
+        put((uint64_t)s.transactions, 8);
+        put(s.bytes.size(), 8);
+        out.write(reinterpret_cast<const char*>(s.bytes.data()), (std::streamsize)s.bytes.size());
+    }
+    return (bool)out;
+}
+
+inline bool loadTrace(const std::string& path, Trace& trace, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    auto get = [&](int bytes) {
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) {
+            v |= (uint64_t)(uint8_t)in.get() << (8 * i);
+        }
+        return v;
+    };
+    char magic[sizeof(TRACE_MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (!in || std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+        error = path + " is not a trace file";
+        return false;
+    }
+    uint64_t streams = get(4);
+    trace.m = (int)get(4);
+    if (!in || streams > (1u << 20)) {
+        error = path + " has a corrupt header";
+        return false;
+    }
+    trace.streams.assign(streams, {});
+    for (auto& s : trace.streams) {
+        s.transactions = (long long)get(8);
+        uint64_t bytes = get(8);
+        if (!in || bytes > (1ull << 40)) {
+            error = path + " is truncated";
+            return false;
+        }
+        s.bytes.resize(bytes);
+        in.read(reinterpret_cast<char*>(s.bytes.data()), (std::streamsize)bytes);
+        if (!in) {
+            error = path + " is truncated";
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// Compile-time detection of optional engine capabilities, shared by the
+// benchmark driver, the microbenchmarks and the server.
+
+#include <type_traits>
+#include <utility>
+
+// Engines that detect doomed transactions early expose isAborted(txID)
+template <class Manager, class = void>
+struct HasIsAborted : std::false_type {};
+
+template <class Manager>
+struct HasIsAborted<Manager, std::void_t<decltype(std::declval<Manager&>().isAborted(0))>> : std::true_type {};
+
+// Serializable engines count the aborts their certifier adds on top of SI
+template <class Manager, class = void>
+struct HasSerializationAborts : std::false_type {};
+
+template <class Manager>
+struct HasSerializationAborts<Manager, std::void_t<decltype(std::declval<Manager&>().serializationAborts())>> : std::true_type {};
+
+// Deadlock-avoiding lock engines count the aborts their policy forces
+template <class Manager, class = void>
+struct HasDeadlockAborts : std::false_type {};
+
+template <class Manager>
+struct HasDeadlockAborts<Manager, std::void_t<decltype(std::declval<Manager&>().deadlockAborts())>> : std::true_type {};
+
+// Multiversion engines that can report chain lengths and GC backlog
+template <class Manager, class = void>
+struct HasVersionStats : std::false_type {};
+
+template <class Manager>
+struct HasVersionStats<Manager, std::void_t<decltype(std::declval<Manager&>().versionStats())>> : std::true_type {};
+
+// Engines with commutative increments expose add(txID, index, delta)
+template <class Manager, class = void>
+struct HasAdd : std::false_type {};
+
+template <class Manager>
+struct HasAdd<Manager, std::void_t<decltype(std::declval<Manager&>().add(0, 0, 0))>> : std::true_type {};
+
+// Pooled engines can report "no free context" instead of blocking
+template <class Manager, class = void>
+struct HasTryBegin : std::false_type {};
+
+template <class Manager>
+struct HasTryBegin<Manager, std::void_t<decltype(std::declval<Manager&>().tryBeginTrans())>> : std::true_type {};
+
+// Engines with a fixed pool of transaction contexts report its size and
+// can be built with room for a given number of open transactions
+template <class Manager, class = void>
+struct HasContextPool : std::false_type {};
+
+template <class Manager>
+struct HasContextPool<Manager, std::void_t<decltype(std::declval<Manager&>().contextPoolSize())>> : std::true_type {};
+
+// One-shot engines take a whole transaction at once: declared keys plus a
+// procedure, returning a Ticket to wait on
+template <class Manager, class = void>
+struct IsOneShot : std::false_type {};
+
+template <class Manager>
+struct IsOneShot<Manager, std::void_t<typename Manager::Ticket>> : std::true_type {};
+
+// Engines that can roll a transaction back without committing it
+template <class Manager, class = void>
+struct HasAbort : std::false_type {};
+
+template <class Manager>
+struct HasAbort<Manager, std::void_t<decltype(std::declval<Manager&>().abort(0))>> : std::true_type {};
+
+// Engines that can feed a replication stream (see commitlog.h)
+template <class Manager, class = void>
+struct HasCommitLog : std::false_type {};
+
+template <class Manager>
+struct HasCommitLog<Manager, std::void_t<decltype(std::declval<Manager&>().attachCommitLog(nullptr))>> : std::true_type {};
+
+// Engines that account their memory and take a budget (see memory.h)
+template <class Manager, class = void>
+struct HasMemoryStats : std::false_type {};
+
+template <class Manager>
+struct HasMemoryStats<Manager, std::void_t<decltype(std::declval<Manager&>().memoryStats())>> : std::true_type {};
+
+// Engines that plan differently for read-only transactions take the hint at begin
+template <class Manager, class = void>
+struct HasReadOnlyBegin : std::false_type {};
+
+template <class Manager>
+struct HasReadOnlyBegin<Manager, std::void_t<decltype(std::declval<Manager&>().beginTrans(true))>> : std::true_type {};
+
+// Lock-based engines block the calling thread on a conflict, so a thread
+// must not multiplex several clients (coroutines, event loops) over them
+template <class Manager, class = void>
+struct BlocksOnConflict : std::false_type {};
+
+template <class Manager>
+struct BlocksOnConflict<Manager, std::enable_if_t<Manager::blocksOnConflict>> : std::true_type {};
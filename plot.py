@@ -1,6 +1,39 @@
 import matplotlib.pyplot as plt
 import pandas as pd
 import os
+import sys
+
+# --- Sweep results ---
+# python3 plot.py sweep.csv [more.csv ...] plots the CSVs written by
+# --sweep (or sweep.sh): throughput against threads with 95% intervals,
+# one line per engine and combination of the other swept parameters.
+def plot_sweep(paths):
+    data = pd.concat([pd.read_csv(path) for path in paths], ignore_index=True)
+    config = ['m', 'read_ratio', 'skew', 'key_ranges', 'clients_per_thread', 'num_trans', 'num_iters', 'lambda', 'const_val']
+    varying = [c for c in config if data[c].nunique() > 1]
+
+    plt.figure(figsize=(12, 8))
+    for subplot, metric, title in [(1, 'commits_per_sec', 'Commit Throughput'), (2, 'aborts_per_sec', 'Abort Rate')]:
+        plt.subplot(2, 1, subplot)
+        for key, group in data.groupby(['engine'] + varying):
+            key = key if isinstance(key, tuple) else (key,)
+            label = key[0] + ''.join(' %s=%s' % (c, v) for c, v in zip(varying, key[1:]))
+            group = group.sort_values('threads')
+            plt.errorbar(group['threads'], group[metric + '_mean'], yerr=group[metric + '_ci95'],
+                         marker='o', capsize=3, label=label)
+        plt.xlabel('Number of Threads')
+        plt.ylabel(metric.replace('_', ' ').title())
+        plt.title(title + ' (mean and 95% CI)')
+        plt.grid(True)
+        plt.legend(fontsize='small')
+
+    plt.tight_layout()
+    plt.savefig("sweep_comparison.png")
+    print("Sweep plot has been saved to sweep_comparison.png")
+
+if len(sys.argv) > 1:
+    plot_sweep(sys.argv[1:])
+    sys.exit(0)
 
 # Create directories for output
 os.makedirs("plots", exist_ok=True)
@@ -10,6 +43,20 @@ os.makedirs("plots", exist_ok=True)
 thread_data1 = pd.read_csv("SI/experiment_vary_threads/summary.csv")
 thread_data2 = pd.read_csv("SI-SSN/experiment_vary_threads/summary.csv")
 
+# Optional engines, plotted only once their experiments have been run
+optional_engines = [("OCC", "Silo OCC", '^-'), ("SSI", "SSI", 'd-'), ("Calvin", "Calvin", 'x-'),
+                    ("SharedMemory", "Shared-memory SI", 'v-'), ("MV2PL", "MV2PL", 'P-')]
+
+def load_optional(experiment):
+    loaded = []
+    for directory, label, style in optional_engines:
+        path = os.path.join(directory, experiment, "summary.csv")
+        if os.path.exists(path):
+            loaded.append((pd.read_csv(path), label, style))
+    return loaded
+
+thread_extra = load_optional("experiment_vary_threads")
+
 # Create the comparison plot
 plt.figure(figsize=(12, 8))
 
@@ -17,6 +64,8 @@ plt.figure(figsize=(12, 8))
 plt.subplot(2, 1, 1)
 plt.plot(thread_data1['threads'], thread_data1['commits_per_sec'], 'o-', label='SI - Commits/sec')
 plt.plot(thread_data2['threads'], thread_data2['commits_per_sec'], 's-', label='SI+SSN - Commits/sec')
+for data, label, style in thread_extra:
+    plt.plot(data['threads'], data['commits_per_sec'], style, label=label + ' - Commits/sec')
 plt.xlabel('Number of Threads')
 plt.ylabel('Commits per Second')
 plt.title('Commit Throughput Comparison')
@@ -27,6 +76,8 @@ plt.legend()
 plt.subplot(2, 1, 2)
 plt.plot(thread_data1['threads'], thread_data1['aborts_per_sec'], 'o-', label='SI - Aborts/sec')
 plt.plot(thread_data2['threads'], thread_data2['aborts_per_sec'], 's-', label='SI+SSN - Aborts/sec')
+for data, label, style in thread_extra:
+    plt.plot(data['threads'], data['aborts_per_sec'], style, label=label + ' - Aborts/sec')
 plt.xlabel('Number of Threads')
 plt.ylabel('Aborts per Second')
 plt.title('Abort Rate Comparison')
@@ -40,6 +91,7 @@ plt.savefig("thread_comparison.png")
 # Load the two experiment summaries
 ratio_data1 = pd.read_csv("SI/experiment_vary_readratio/summary.csv")
 ratio_data2 = pd.read_csv("SI-SSN/experiment_vary_readratio/summary.csv")
+ratio_extra = load_optional("experiment_vary_readratio")
 
 # Create the comparison plot
 plt.figure(figsize=(12, 8))
@@ -48,6 +100,8 @@ plt.figure(figsize=(12, 8))
 plt.subplot(2, 1, 1)
 plt.plot(ratio_data1['read_ratio'], ratio_data1['commits_per_sec'], 'o-', label='SI - Commits/sec')
 plt.plot(ratio_data2['read_ratio'], ratio_data2['commits_per_sec'], 's-', label='SI+SSN - Commits/sec')
+for data, label, style in ratio_extra:
+    plt.plot(data['read_ratio'], data['commits_per_sec'], style, label=label + ' - Commits/sec')
 plt.xlabel('Read Ratio')
 plt.ylabel('Commits per Second')
 plt.title('Commit Throughput Comparison')
@@ -58,6 +112,8 @@ plt.legend()
 plt.subplot(2, 1, 2)
 plt.plot(ratio_data1['read_ratio'], ratio_data1['aborts_per_sec'], 'o-', label='SI - Aborts/sec')
 plt.plot(ratio_data2['read_ratio'], ratio_data2['aborts_per_sec'], 's-', label='SI+SSN - Aborts/sec')
+for data, label, style in ratio_extra:
+    plt.plot(data['read_ratio'], data['aborts_per_sec'], style, label=label + ' - Aborts/sec')
 plt.xlabel('Read Ratio')
 plt.ylabel('Aborts per Second')
 plt.title('Abort Rate Comparison')
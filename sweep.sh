@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Run one sweep specification against every engine it names and merge the
+# results into sweep.csv and sweep.json (plot with: python3 plot.py sweep.csv).
+# Each engine binary runs all of its own points in one process. Engines are
+# built as C++20 when the compiler supports it, so clients_per_thread axes
+# (coroutine clients) can run.
+#
+# Usage: bash sweep.sh SPEC [BASELINE_CSV]
+#   SPEC          sweep specification (format in common/sweep.h); its
+#                 "engine =" line picks the engine directories to run
+#   BASELINE_CSV  earlier merged sweep.csv; throughput regressions are
+#                 reported and make the script exit with status 3
+
+spec=$(realpath "$1")
+baseline=${2:+$(realpath "$2")}
+root=$(dirname "$(realpath "$0")")
+
+engines=$(grep -E '^[[:space:]]*engine[[:space:]]*=' "$spec" | sed 's/#.*//; s/.*=//; s/,/ /g')
+if [ -z "$engines" ]; then
+    echo "No engine line in $spec, running SI only"
+    engines="SI"
+fi
+
+std=c++17
+if echo 'int main() {}' | g++ -std=c++20 -x c++ -fsyntax-only - 2>/dev/null; then
+    std=c++20
+fi
+
+status=0
+jsons=()
+rm -f "$root/sweep.csv" "$root/sweep.json"
+for engine in $engines; do
+    echo "Sweeping $engine"
+    cd "$root/$engine" || exit 1
+    g++ -std=$std -O2 -pthread -o a.out SI-run.cc -lrt || exit 1
+    ./a.out --sweep="$spec" --sweep-out=sweep ${baseline:+--baseline="$baseline"} $DRIVER_ARGS
+    rc=$?
+    if [ $rc -eq 3 ]; then
+        status=3
+    elif [ $rc -ne 0 ]; then
+        exit $rc
+    fi
+    if [ -f "$root/sweep.csv" ]; then
+        tail -n +2 sweep.csv >> "$root/sweep.csv"
+    else
+        cp sweep.csv "$root/sweep.csv"
+    fi
+    jsons+=("$root/$engine/sweep.json")
+done
+
+# Concatenate the points of every engine's JSON array
+{
+    echo "["
+    first=1
+    for json in "${jsons[@]}"; do
+        points=$(sed '1d;$d' "$json")
+        [ -z "$points" ] && continue
+        [ $first -eq 0 ] && echo ","
+        printf '%s\n' "$points"
+        first=0
+    done
+    echo "]"
+} > "$root/sweep.json"
+
+echo "Merged results are in: $root/sweep.csv and $root/sweep.json"
+exit $status